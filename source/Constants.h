@@ -19,6 +19,7 @@
 #pragma once
 #include <MediaCommon.h>
 
+#include <cstddef>
 #include <cstdint>
 
 constexpr double kDefaultVolume{1.0};
@@ -33,3 +34,5 @@ constexpr uint32_t kDefaultFadeVolume{0};
 constexpr const char *kDefaultAudioFade = "100,0,L";
 constexpr uint32_t kDefaultBufferingLimit{750};
 constexpr bool kDefaultUseBuffering{false};
+constexpr double kDefaultTrickPlayKeyframeRate{2.0};
+constexpr size_t kMaxStagedSamples{8};
@@ -18,45 +18,65 @@
 
 #pragma once
 
+#include <algorithm>
 #include <condition_variable>
 #include <gst/gst.h>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "ControlBackendInterface.h"
 #include "IControl.h"
 
 namespace firebolt::rialto::client
 {
-class ControlBackend final : public ControlBackendInterface
+class ControlBackend;
+
+// Single registration of the process with Rialto control, shared by all sinks. It stays alive while any
+// ControlBackend uses it and fans application state changes out to all of them.
+class SharedControl
 {
     class ControlClient : public IControlClient
     {
     public:
-        explicit ControlClient(ControlBackend &backend, std::weak_ptr<IControlClient> client)
-            : mBackend{backend}, mClient{std::move(client)}
-        {
-        }
+        explicit ControlClient(SharedControl &sharedControl) : mSharedControl{sharedControl} {}
         ~ControlClient() override = default;
         void notifyApplicationState(ApplicationState state) override
         {
             GST_INFO("ApplicationStateChanged received by rialto sink");
-            mBackend.onApplicationStateChanged(state);
-
-            if (auto client = mClient.lock())
-            {
-                client->notifyApplicationState(state);
-            }
+            mSharedControl.onApplicationStateChanged(state);
         }
 
     private:
-        ControlBackend &mBackend;
-        std::weak_ptr<IControlClient> mClient;
+        SharedControl &mSharedControl;
     };
 
 public:
-    explicit ControlBackend(std::weak_ptr<IControlClient> controlClient = {})
-        : m_rialtoClientState{ApplicationState::UNKNOWN},
-          m_controlClient{std::make_shared<ControlClient>(*this, std::move(controlClient))},
+    static std::shared_ptr<SharedControl> acquire()
+    {
+        std::unique_lock<std::mutex> lock{m_instanceMutex};
+        std::shared_ptr<SharedControl> sharedControl{m_instance.lock()};
+        if (!sharedControl)
+        {
+            sharedControl = std::make_shared<SharedControl>();
+            // Don't share a failed registration, next sink should retry
+            if (sharedControl->m_isRegistered)
+            {
+                m_instance = sharedControl;
+            }
+        }
+        return sharedControl;
+    }
+
+    static bool isAcquired()
+    {
+        std::unique_lock<std::mutex> lock{m_instanceMutex};
+        return !m_instance.expired();
+    }
+
+    SharedControl()
+        : m_rialtoClientState{ApplicationState::UNKNOWN}, m_controlClient{std::make_shared<ControlClient>(*this)},
           m_control{IControlFactory::createFactory()->createControl()}
     {
         if (!m_control)
@@ -69,11 +89,67 @@ public:
             GST_ERROR("Unable to register client");
             return;
         }
+        m_isRegistered = true;
+    }
+
+    ~SharedControl() { m_control.reset(); }
+
+    inline void addListener(ControlBackend *listener);
+
+    void removeListener(ControlBackend *listener)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_listeners.erase(std::remove(m_listeners.begin(), m_listeners.end(), listener), m_listeners.end());
+        // The listener may be destroyed once removed, so wait for its ongoing notification, unless it is removed from
+        // within that notification
+        if (m_notifyingThread != std::this_thread::get_id())
+        {
+            m_notificationCv.wait(lock, [&]() { return m_notifiedListener != listener; });
+        }
+    }
+
+private:
+    inline void onApplicationStateChanged(ApplicationState state);
+
+    static inline std::mutex m_instanceMutex;
+    static inline std::weak_ptr<SharedControl> m_instance;
+
+    ApplicationState m_rialtoClientState;
+    bool m_isRegistered{false};
+    std::shared_ptr<ControlClient> m_controlClient;
+    std::shared_ptr<IControl> m_control;
+    // Held for the whole notification, only to keep notifications in order
+    std::mutex m_notificationMutex;
+    // Never held while listeners are notified
+    std::mutex m_mutex;
+    std::condition_variable m_notificationCv;
+    std::vector<ControlBackend *> m_listeners;
+    ControlBackend *m_notifiedListener{nullptr};
+    std::thread::id m_notifyingThread;
+};
+
+class ControlBackend final : public ControlBackendInterface
+{
+    friend class SharedControl;
+
+public:
+    explicit ControlBackend(std::weak_ptr<IControlClient> controlClient = {})
+        : m_rialtoClientState{ApplicationState::UNKNOWN}, m_controlClient{std::move(controlClient)},
+          m_sharedControl{SharedControl::acquire()}
+    {
+        m_sharedControl->addListener(this);
     }
 
-    ~ControlBackend() final { m_control.reset(); }
+    ~ControlBackend() final { removeControlBackend(); }
 
-    void removeControlBackend() override { m_control.reset(); }
+    void removeControlBackend() override
+    {
+        if (m_sharedControl)
+        {
+            m_sharedControl->removeListener(this);
+            m_sharedControl.reset();
+        }
+    }
 
     bool waitForRunning() override
     {
@@ -88,22 +164,62 @@ public:
     }
 
 private:
+    void setApplicationState(ApplicationState state)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_rialtoClientState = state;
+        m_stateCv.notify_one();
+    }
+
     void onApplicationStateChanged(ApplicationState state)
     {
         GST_INFO("Rialto Client application state changed to: %s",
                  state == ApplicationState::RUNNING ? "Active" : "Inactive/Unknown");
+        setApplicationState(state);
+
+        if (auto client = m_controlClient.lock())
         {
-            std::unique_lock<std::mutex> lock{m_mutex};
-            m_rialtoClientState = state;
-            m_stateCv.notify_one();
+            client->notifyApplicationState(state);
         }
     }
 
 private:
     ApplicationState m_rialtoClientState;
-    std::shared_ptr<ControlClient> m_controlClient;
-    std::shared_ptr<IControl> m_control;
+    std::weak_ptr<IControlClient> m_controlClient;
+    std::shared_ptr<SharedControl> m_sharedControl;
     std::mutex m_mutex;
     std::condition_variable m_stateCv;
 };
+
+void SharedControl::addListener(ControlBackend *listener)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_listeners.push_back(listener);
+    // Set under the lock, so that a state notified in the meantime is not overwritten with the older one
+    listener->setApplicationState(m_rialtoClientState);
+}
+
+void SharedControl::onApplicationStateChanged(ApplicationState state)
+{
+    std::unique_lock<std::mutex> notificationLock{m_notificationMutex};
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_rialtoClientState = state;
+    const std::vector<ControlBackend *> kListeners{m_listeners};
+    m_notifyingThread = std::this_thread::get_id();
+    for (ControlBackend *listener : kListeners)
+    {
+        // Skip listeners removed by the previous notifications
+        if (std::find(m_listeners.begin(), m_listeners.end(), listener) == m_listeners.end())
+        {
+            continue;
+        }
+        m_notifiedListener = listener;
+        lock.unlock();
+        listener->onApplicationStateChanged(state);
+        lock.lock();
+        m_notifiedListener = nullptr;
+        m_notificationCv.notify_all();
+    }
+    m_notifyingThread = std::thread::id{};
+}
 } // namespace firebolt::rialto::client
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "DataRequestStats.h"
+
+void DataRequestStats::onNeedData(uint32_t needDataRequestId, size_t frameCount, Clock::time_point receivedTime)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    ++m_snapshot.needDataCount;
+    m_snapshot.framesRequested += frameCount;
+    m_ongoingRequests[needDataRequestId] = receivedTime;
+}
+
+void DataRequestStats::onPullStarted(uint32_t needDataRequestId, Clock::time_point now)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    auto requestIt{m_ongoingRequests.find(needDataRequestId)};
+    if (requestIt != m_ongoingRequests.end())
+    {
+        m_snapshot.requestToPull.add(now - requestIt->second);
+    }
+}
+
+void DataRequestStats::onSegmentParsed(Clock::duration duration)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_snapshot.parse.add(duration);
+}
+
+void DataRequestStats::onSegmentAdded(Clock::duration duration, firebolt::rialto::AddSegmentStatus status)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_snapshot.addSegment.add(duration);
+    if (status == firebolt::rialto::AddSegmentStatus::OK)
+    {
+        ++m_snapshot.framesDelivered;
+    }
+    else if (status == firebolt::rialto::AddSegmentStatus::NO_SPACE)
+    {
+        ++m_snapshot.noSpaceCount;
+    }
+}
+
+void DataRequestStats::onHaveData(uint32_t needDataRequestId, firebolt::rialto::MediaSourceStatus status,
+                                  Clock::time_point now)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (status == firebolt::rialto::MediaSourceStatus::NO_AVAILABLE_SAMPLES)
+    {
+        ++m_snapshot.noAvailableSamplesCount;
+    }
+    auto requestIt{m_ongoingRequests.find(needDataRequestId)};
+    if (requestIt != m_ongoingRequests.end())
+    {
+        m_snapshot.turnaround.add(now - requestIt->second);
+        m_ongoingRequests.erase(requestIt);
+    }
+}
+
+DataRequestStats::Snapshot DataRequestStats::getSnapshot() const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return m_snapshot;
+}
+
+void DataRequestStats::addToStructure(GstStructure *structure, const Snapshot &snapshot)
+{
+    gst_structure_set(structure, "need-data-requests", G_TYPE_UINT64, snapshot.needDataCount, "frames-requested",
+                      G_TYPE_UINT64, snapshot.framesRequested, "frames-delivered", G_TYPE_UINT64,
+                      snapshot.framesDelivered, "no-space", G_TYPE_UINT64, snapshot.noSpaceCount,
+                      "no-available-samples", G_TYPE_UINT64, snapshot.noAvailableSamplesCount, nullptr);
+    snapshot.requestToPull.addToStructure(structure, "request-to-pull");
+    snapshot.parse.addToStructure(structure, "parse");
+    snapshot.addSegment.addToStructure(structure, "add-segment");
+    snapshot.turnaround.addToStructure(structure, "turnaround");
+}
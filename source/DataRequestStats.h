@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef DATA_REQUEST_STATS_H_
+#define DATA_REQUEST_STATS_H_
+
+#include "LatencyHistogram.h"
+#include "MediaCommon.h"
+
+#include <chrono>
+#include <cstdint>
+#include <gst/gst.h>
+#include <mutex>
+#include <unordered_map>
+
+// Timings of the need data requests of a single source, from the request arriving from the server, through pulling,
+// parsing and adding the samples, to have data being sent back. Updated from the Rialto client, backend and puller
+// threads.
+class DataRequestStats
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    using Histogram = LatencyHistogram;
+
+    struct Snapshot
+    {
+        // Time from need data arriving from the server to the puller starting to serve it
+        Histogram requestToPull;
+        // Parsing of a single sample, when it was not parsed ahead of the request
+        Histogram parse;
+        // Adding of a single segment to the Rialto client
+        Histogram addSegment;
+        // Time from need data arriving from the server to have data being sent
+        Histogram turnaround;
+        uint64_t needDataCount{0};
+        uint64_t framesRequested{0};
+        uint64_t framesDelivered{0};
+        uint64_t noSpaceCount{0};
+        uint64_t noAvailableSamplesCount{0};
+    };
+
+    void onNeedData(uint32_t needDataRequestId, size_t frameCount, Clock::time_point receivedTime);
+    void onPullStarted(uint32_t needDataRequestId, Clock::time_point now = Clock::now());
+    void onSegmentParsed(Clock::duration duration);
+    void onSegmentAdded(Clock::duration duration, firebolt::rialto::AddSegmentStatus status);
+    void onHaveData(uint32_t needDataRequestId, firebolt::rialto::MediaSourceStatus status,
+                    Clock::time_point now = Clock::now());
+    Snapshot getSnapshot() const;
+
+    // Adds the counters and histograms to a stats structure or bus message
+    static void addToStructure(GstStructure *structure, const Snapshot &snapshot);
+
+private:
+    mutable std::mutex m_mutex;
+    Snapshot m_snapshot;
+    // Arrival time of the requests which have not been answered yet
+    std::unordered_map<uint32_t, Clock::time_point> m_ongoingRequests;
+};
+
+#endif // DATA_REQUEST_STATS_H_
@@ -28,6 +28,7 @@ void FlushAndDataSynchronizer::addSource(int32_t sourceId)
 {
     std::unique_lock lock(m_mutex);
     m_sourceStates[sourceId] = {FlushState::IDLE, DataState::NO_DATA};
+    updateCountersUnlocked();
     GST_INFO("Added source %d to FlushAndDataSynchronizer", sourceId);
 }
 
@@ -35,6 +36,7 @@ void FlushAndDataSynchronizer::removeSource(int32_t sourceId)
 {
     std::unique_lock lock(m_mutex);
     m_sourceStates.erase(sourceId);
+    updateCountersUnlocked();
     m_cv.notify_all();
     GST_INFO("Removed source %d from FlushAndDataSynchronizer", sourceId);
 }
@@ -44,6 +46,7 @@ void FlushAndDataSynchronizer::notifyFlushStarted(int32_t sourceId)
     std::unique_lock lock(m_mutex);
     m_sourceStates[sourceId].flushState = FlushState::FLUSHING;
     m_sourceStates[sourceId].dataState = DataState::NO_DATA;
+    updateCountersUnlocked();
     GST_INFO("FlushAndDataSynchronizer: Flush started for source %d", sourceId);
 }
 
@@ -51,25 +54,42 @@ void FlushAndDataSynchronizer::notifyFlushCompleted(int32_t sourceId)
 {
     std::unique_lock lock(m_mutex);
     m_sourceStates[sourceId].flushState = FlushState::FLUSHED;
+    updateCountersUnlocked();
     m_cv.notify_all();
     GST_INFO("FlushAndDataSynchronizer: Flush completed for source %d", sourceId);
 }
 
 void FlushAndDataSynchronizer::notifyDataReceived(int32_t sourceId)
 {
+    if (m_unsettledSources.load(std::memory_order_acquire) == 0)
+    {
+        return;
+    }
     std::unique_lock lock(m_mutex);
-    if (m_sourceStates[sourceId].dataState == DataState::NO_DATA)
+    auto sourceIt = m_sourceStates.find(sourceId);
+    if (sourceIt != m_sourceStates.end() && sourceIt->second.dataState == DataState::NO_DATA)
     {
-        m_sourceStates[sourceId].dataState = DataState::DATA_RECEIVED;
+        sourceIt->second.dataState = DataState::DATA_RECEIVED;
+        updateCountersUnlocked();
         GST_INFO("FlushAndDataSynchronizer: Data received for source %d", sourceId);
     }
 }
 
 void FlushAndDataSynchronizer::notifyDataPushed(int32_t sourceId)
 {
+    if (m_unsettledSources.load(std::memory_order_acquire) == 0)
+    {
+        return;
+    }
     std::unique_lock lock(m_mutex);
-    m_sourceStates[sourceId].dataState = DataState::DATA_PUSHED;
-    m_sourceStates[sourceId].flushState = FlushState::IDLE;
+    SourceState &state{m_sourceStates[sourceId]};
+    if (state.dataState == DataState::DATA_PUSHED && state.flushState == FlushState::IDLE)
+    {
+        return;
+    }
+    state.dataState = DataState::DATA_PUSHED;
+    state.flushState = FlushState::IDLE;
+    updateCountersUnlocked();
     m_cv.notify_all();
     GST_INFO("FlushAndDataSynchronizer: Data pushed for source %d", sourceId);
 }
@@ -95,7 +115,21 @@ void FlushAndDataSynchronizer::waitIfRequired(int32_t sourceId)
 
 bool FlushAndDataSynchronizer::isAnySourceFlushing() const
 {
-    std::unique_lock lock(m_mutex);
-    return std::any_of(m_sourceStates.begin(), m_sourceStates.end(),
-                       [](const auto &state) { return state.second.flushState == FlushState::FLUSHING; });
+    return m_flushingSources.load(std::memory_order_acquire) > 0;
+}
+
+void FlushAndDataSynchronizer::updateCountersUnlocked()
+{
+    const auto kUnsettledSources =
+        std::count_if(m_sourceStates.begin(), m_sourceStates.end(),
+                      [](const auto &state)
+                      {
+                          return state.second.flushState != FlushState::IDLE ||
+                                 state.second.dataState != DataState::DATA_PUSHED;
+                      });
+    const auto kFlushingSources =
+        std::count_if(m_sourceStates.begin(), m_sourceStates.end(),
+                      [](const auto &state) { return state.second.flushState == FlushState::FLUSHING; });
+    m_unsettledSources.store(static_cast<size_t>(kUnsettledSources), std::memory_order_release);
+    m_flushingSources.store(static_cast<size_t>(kFlushingSources), std::memory_order_release);
 }
\ No newline at end of file
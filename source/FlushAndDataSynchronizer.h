@@ -20,6 +20,7 @@
 #define FLUSH_AND_DATA_SYNCHRONIZER_H_
 
 #include "IFlushAndDataSynchronizer.h"
+#include <atomic>
 #include <condition_variable>
 #include <map>
 #include <mutex>
@@ -67,9 +68,15 @@ public:
     bool isAnySourceFlushing() const override;
 
 private:
+    void updateCountersUnlocked();
+
     mutable std::mutex m_mutex;
     std::condition_variable m_cv;
     std::map<int32_t, SourceState> m_sourceStates;
+    // Data notifications are sent for every buffer, but change the state only after flush. Counters are updated under
+    // m_mutex, so that notifications can skip locking while all sources are idle with their data pushed.
+    std::atomic<size_t> m_unsettledSources{0};
+    std::atomic<size_t> m_flushingSources{0};
 };
 
 #endif // FLUSH_AND_DATA_SYNCHRONIZER_H_
\ No newline at end of file
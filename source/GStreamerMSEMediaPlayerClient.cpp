@@ -22,9 +22,12 @@
 #include "RialtoGStreamerMSEBaseSink.h"
 #include "RialtoGStreamerMSEBaseSinkPrivate.h"
 #include "RialtoGStreamerMSEVideoSink.h"
+#include "RialtoGStreamerTracer.h"
+#include "TraceWriter.h"
 
 #include <algorithm>
 #include <chrono>
+#include <limits>
 #include <thread>
 
 namespace
@@ -34,6 +37,33 @@ namespace
 // 1 second is probably erring on the side of caution, but should not have side effect.
 const int64_t segmentStartMaximumDiff = 1000000000;
 const int32_t UNKNOWN_STREAMS_NUMBER = -1;
+// Duration value used until the first duration notification is received from the server
+const int64_t DURATION_NOT_NOTIFIED = std::numeric_limits<int64_t>::min();
+const std::string kMseUrl{"mse://1"};
+
+bool isFreshPropertyReadEnabled()
+{
+    const char *freshPropertiesStr = getenv("RIALTO_SINKS_FRESH_PROPERTIES");
+    return freshPropertiesStr && std::string(freshPropertiesStr) == "1";
+}
+
+std::chrono::milliseconds getDataRequestStatsInterval()
+{
+    const char *intervalStr = getenv("RIALTO_SINKS_DATA_STATS_INTERVAL_MS");
+    if (!intervalStr)
+    {
+        return std::chrono::milliseconds{0};
+    }
+    try
+    {
+        return std::chrono::milliseconds{std::max(std::stoi(intervalStr), 0)};
+    }
+    catch (const std::exception &e)
+    {
+        GST_WARNING("Invalid RIALTO_SINKS_DATA_STATS_INTERVAL_MS: %s", intervalStr);
+        return std::chrono::milliseconds{0};
+    }
+}
 
 const char *toString(const firebolt::rialto::PlaybackError &error)
 {
@@ -69,12 +99,15 @@ GStreamerMSEMediaPlayerClient::GStreamerMSEMediaPlayerClient(
     const std::shared_ptr<IMessageQueueFactory> &messageQueueFactory,
     const std::shared_ptr<firebolt::rialto::client::MediaPlayerClientBackendInterface> &MediaPlayerClientBackend,
     const uint32_t maxVideoWidth, const uint32_t maxVideoHeight, bool isLive)
-    : m_backendQueue{messageQueueFactory->createMessageQueue()}, m_messageQueueFactory{messageQueueFactory},
-      m_clientBackend(MediaPlayerClientBackend), m_position(0), m_duration(0), m_audioStreams{UNKNOWN_STREAMS_NUMBER},
-      m_videoStreams{UNKNOWN_STREAMS_NUMBER}, m_subtitleStreams{UNKNOWN_STREAMS_NUMBER},
-      m_videoRectangle{0, 0, 1920, 1080}, m_streamingStopped(false),
+    : m_backendQueue{messageQueueFactory->createMessageQueue("backend")}, m_messageQueueFactory{messageQueueFactory},
+      m_clientBackend(MediaPlayerClientBackend), m_position(0), m_duration(DURATION_NOT_NOTIFIED),
+      m_audioStreams{UNKNOWN_STREAMS_NUMBER}, m_videoStreams{UNKNOWN_STREAMS_NUMBER},
+      m_subtitleStreams{UNKNOWN_STREAMS_NUMBER}, m_videoRectangle{0, 0, 1920, 1080}, m_streamingStopped(false),
       m_maxWidth(maxVideoWidth == 0 ? DEFAULT_MAX_VIDEO_WIDTH : maxVideoWidth),
-      m_maxHeight(maxVideoHeight == 0 ? DEFAULT_MAX_VIDEO_HEIGHT : maxVideoHeight), m_isLive{isLive}
+      m_maxHeight(maxVideoHeight == 0 ? DEFAULT_MAX_VIDEO_HEIGHT : maxVideoHeight), m_isLive{isLive},
+      m_isFreshPropertyReadEnabled{isFreshPropertyReadEnabled()},
+      m_dataRequestStatsInterval{getDataRequestStatsInterval()},
+      m_sessionRecorder{SessionRecorder::createFromEnvironment()}
 {
     m_backendQueue->start();
 }
@@ -102,9 +135,72 @@ void GStreamerMSEMediaPlayerClient::stopStreaming()
 // Deletes client backend -> this deletes mediapipeline object
 void GStreamerMSEMediaPlayerClient::destroyClientBackend()
 {
+    std::unique_lock lock{m_clientBackendMutex};
     m_clientBackend.reset();
 }
 
+std::shared_ptr<firebolt::rialto::client::MediaPlayerClientBackendInterface>
+GStreamerMSEMediaPlayerClient::getClientBackend()
+{
+    std::unique_lock lock{m_clientBackendMutex};
+    return m_clientBackend;
+}
+
+template <typename T>
+bool GStreamerMSEMediaPlayerClient::getProperty(const std::function<std::optional<T> &(PropertyCache &)> &cacheEntry,
+                                                T &value, const std::function<bool(T &)> &backendGetter,
+                                                bool isCacheBypassed, const std::string &refreshKey)
+{
+    if (!m_isFreshPropertyReadEnabled && !isCacheBypassed)
+    {
+        bool shouldScheduleRefresh{false};
+        {
+            std::unique_lock lock{m_propertyCacheMutex};
+            const std::optional<T> &kCachedValue{cacheEntry(m_propertyCache)};
+            if (kCachedValue.has_value())
+            {
+                value = kCachedValue.value();
+                shouldScheduleRefresh = !refreshKey.empty() && m_scheduledPropertyRefreshes.insert(refreshKey).second;
+                if (!shouldScheduleRefresh)
+                {
+                    return true;
+                }
+            }
+        }
+        if (shouldScheduleRefresh)
+        {
+            // Cache entries may be removed in the meantime, so the entry is looked up again when the value arrives
+            const bool kScheduled{m_backendQueue->scheduleInEventLoop(
+                [this, cacheEntry, backendGetter, refreshKey]()
+                {
+                    T refreshedValue{};
+                    const bool kStatus{m_clientBackend && backendGetter(refreshedValue)};
+                    std::unique_lock lock{m_propertyCacheMutex};
+                    if (kStatus)
+                    {
+                        cacheEntry(m_propertyCache) = refreshedValue;
+                    }
+                    m_scheduledPropertyRefreshes.erase(refreshKey);
+                })};
+            if (!kScheduled)
+            {
+                std::unique_lock lock{m_propertyCacheMutex};
+                m_scheduledPropertyRefreshes.erase(refreshKey);
+            }
+            return true;
+        }
+    }
+
+    bool status{false};
+    m_backendQueue->callInEventLoop([&]() { status = backendGetter(value); });
+    if (status)
+    {
+        std::unique_lock lock{m_propertyCacheMutex};
+        cacheEntry(m_propertyCache) = value;
+    }
+    return status;
+}
+
 void GStreamerMSEMediaPlayerClient::notifyDuration(int64_t duration)
 {
     m_backendQueue->postMessage(std::make_shared<SetDurationMessage>(duration, m_duration));
@@ -121,7 +217,17 @@ void GStreamerMSEMediaPlayerClient::notifyNetworkState(firebolt::rialto::Network
 
 void GStreamerMSEMediaPlayerClient::notifyPlaybackState(firebolt::rialto::PlaybackState state)
 {
-    m_backendQueue->postMessage(std::make_shared<PlaybackStateMessage>(state, this));
+    if (m_sessionRecorder)
+    {
+        m_sessionRecorder->recordPlaybackState(state);
+    }
+    RialtoTracing::serverStateChanged(state);
+    if (TraceWriter *traceWriter = TraceWriter::instance())
+    {
+        traceWriter->addInstant("state", "server playback state", "state", static_cast<int64_t>(state));
+    }
+    // Priority, like the play/pause decisions, so that both stay in order without waiting for queued data messages
+    m_backendQueue->postMessageWithPriority(std::make_shared<PlaybackStateMessage>(state, this));
 }
 
 void GStreamerMSEMediaPlayerClient::notifyVideoData(bool hasData) {}
@@ -132,7 +238,12 @@ void GStreamerMSEMediaPlayerClient::notifyNeedMediaData(
     int32_t sourceId, size_t frameCount, uint32_t needDataRequestId,
     const std::shared_ptr<firebolt::rialto::MediaPlayerShmInfo> & /*shmInfo*/)
 {
-    m_backendQueue->postMessage(std::make_shared<NeedDataMessage>(sourceId, frameCount, needDataRequestId, this));
+    if (m_sessionRecorder)
+    {
+        m_sessionRecorder->recordNeedData(sourceId, frameCount, needDataRequestId);
+    }
+    m_backendQueue->postMessage(std::make_shared<NeedDataMessage>(sourceId, frameCount, needDataRequestId, this,
+                                                                  DataRequestStats::Clock::now()));
 
     return;
 }
@@ -146,6 +257,10 @@ void GStreamerMSEMediaPlayerClient::notifyQos(int32_t sourceId, const firebolt::
 
 void GStreamerMSEMediaPlayerClient::notifyBufferUnderflow(int32_t sourceId)
 {
+    if (m_sessionRecorder)
+    {
+        m_sessionRecorder->recordBufferUnderflow(sourceId);
+    }
     m_backendQueue->postMessage(std::make_shared<BufferUnderflowMessage>(sourceId, this));
 }
 
@@ -161,6 +276,10 @@ void GStreamerMSEMediaPlayerClient::notifyPlaybackError(int32_t sourceId, firebo
 
 void GStreamerMSEMediaPlayerClient::notifySourceFlushed(int32_t sourceId)
 {
+    if (m_sessionRecorder)
+    {
+        m_sessionRecorder->recordSourceFlushed(sourceId);
+    }
     m_backendQueue->postMessage(std::make_shared<SourceFlushedMessage>(sourceId, this));
 }
 
@@ -171,18 +290,28 @@ void GStreamerMSEMediaPlayerClient::notifyPlaybackInfo(const firebolt::rialto::P
         GST_WARNING("Not updating playback info, because flush is ongoing");
         return;
     }
-    std::unique_lock lock{m_playbackInfoMutex};
-    m_playbackInfo = playbackInfo;
+    {
+        std::unique_lock lock{m_playbackInfoMutex};
+        m_playbackInfo = playbackInfo;
+    }
+    m_positionTracker.update(playbackInfo.currentPosition);
 }
 
 int64_t GStreamerMSEMediaPlayerClient::getPosition(int32_t sourceId)
 {
-    std::unique_lock lock{m_playbackInfoMutex};
-    return m_playbackInfo.currentPosition;
+    return m_positionTracker.getPosition();
 }
 
 bool GStreamerMSEMediaPlayerClient::getDuration(int64_t &duration)
 {
+    const int64_t kCachedDuration{m_duration.load(std::memory_order_acquire)};
+    if (kCachedDuration != DURATION_NOT_NOTIFIED)
+    {
+        duration = kCachedDuration;
+        return true;
+    }
+
+    // Fallback for the period before the first duration notification
     if (!m_clientBackend)
     {
         return false;
@@ -202,32 +331,48 @@ bool GStreamerMSEMediaPlayerClient::setImmediateOutput(int32_t sourceId, bool im
 
     bool status{false};
     m_backendQueue->callInEventLoop([&]() { status = m_clientBackend->setImmediateOutput(sourceId, immediateOutput); });
+    if (status)
+    {
+        std::unique_lock lock{m_propertyCacheMutex};
+        m_propertyCache.immediateOutput[sourceId] = immediateOutput;
+    }
     return status;
 }
 
-bool GStreamerMSEMediaPlayerClient::getImmediateOutput(int32_t sourceId, bool &immediateOutput)
+bool GStreamerMSEMediaPlayerClient::getImmediateOutput(int32_t sourceId, bool &immediateOutput, bool isCacheBypassed)
 {
     if (!m_clientBackend)
     {
         return false;
     }
 
-    bool status{false};
-    m_backendQueue->callInEventLoop([&]() { status = m_clientBackend->getImmediateOutput(sourceId, immediateOutput); });
-    return status;
+    return getProperty<bool>([sourceId](PropertyCache &cache) -> std::optional<bool> &
+                             { return cache.immediateOutput[sourceId]; },
+                             immediateOutput,
+                             [this, sourceId](bool &value)
+                             { return m_clientBackend->getImmediateOutput(sourceId, value); },
+                             isCacheBypassed);
 }
 
-bool GStreamerMSEMediaPlayerClient::getStats(int32_t sourceId, uint64_t &renderedFrames, uint64_t &droppedFrames)
+bool GStreamerMSEMediaPlayerClient::getStats(int32_t sourceId, uint64_t &renderedFrames, uint64_t &droppedFrames,
+                                             bool isCacheBypassed)
 {
     if (!m_clientBackend)
     {
         return false;
     }
 
-    bool status{false};
-    m_backendQueue->callInEventLoop([&]()
-                                    { status = m_clientBackend->getStats(sourceId, renderedFrames, droppedFrames); });
-    return status;
+    // Stats change all the time, so cached value is returned and refreshed in background
+    auto statsCacheEntry = [sourceId](PropertyCache &cache) -> std::optional<std::pair<uint64_t, uint64_t>> &
+    { return cache.stats[sourceId]; };
+    auto getStatsFromServer = [this, sourceId](std::pair<uint64_t, uint64_t> &value)
+    { return m_clientBackend->getStats(sourceId, value.first, value.second); };
+    std::pair<uint64_t, uint64_t> stats{renderedFrames, droppedFrames};
+    const bool kStatus{getProperty<std::pair<uint64_t, uint64_t>>(statsCacheEntry, stats, getStatsFromServer,
+                                                                 isCacheBypassed, "stats" + std::to_string(sourceId))};
+    renderedFrames = stats.first;
+    droppedFrames = stats.second;
+    return kStatus;
 }
 
 bool GStreamerMSEMediaPlayerClient::createBackend()
@@ -246,9 +391,7 @@ bool GStreamerMSEMediaPlayerClient::createBackend()
 
             if (m_clientBackend->isMediaPlayerBackendCreated())
             {
-                std::string utf8url = "mse://1";
-                firebolt::rialto::MediaType mediaType = firebolt::rialto::MediaType::MSE;
-                if (!m_clientBackend->load(mediaType, "", utf8url, m_isLive))
+                if (!m_clientBackend->load(firebolt::rialto::MediaType::MSE, "", kMseUrl, m_isLive))
                 {
                     GST_ERROR("Could not load RialtoClient");
                     return;
@@ -264,10 +407,23 @@ bool GStreamerMSEMediaPlayerClient::createBackend()
     return result;
 }
 
+// Whether the MediaPipeline is created and has not failed, so that an idle client can still be used for playback
+bool GStreamerMSEMediaPlayerClient::isHealthy()
+{
+    bool result{false};
+    m_backendQueue->callInEventLoop(
+        [&]()
+        {
+            result = m_clientBackend && m_clientBackend->isMediaPlayerBackendCreated() &&
+                     m_serverPlaybackState != firebolt::rialto::PlaybackState::FAILURE;
+        });
+    return result;
+}
+
 StateChangeResult GStreamerMSEMediaPlayerClient::play(int32_t sourceId)
 {
     StateChangeResult result = StateChangeResult::NOT_ATTACHED;
-    m_backendQueue->callInEventLoop(
+    m_backendQueue->callInEventLoopWithPriority(
         [&]()
         {
             auto sourceIt = m_attachedSources.find(sourceId);
@@ -295,24 +451,15 @@ StateChangeResult GStreamerMSEMediaPlayerClient::play(int32_t sourceId)
 
             sourceIt->second.m_state = ClientState::AWAITING_PLAYING;
 
+            bool shouldPlay{false};
             if (m_clientState == ClientState::PAUSED)
             {
                 // If one source is AWAITING_PLAYING, the other source can still be PLAYING.
                 // This happends when we are switching out audio.
                 if (checkIfAllAttachedSourcesInStates({ClientState::AWAITING_PLAYING, ClientState::PLAYING}))
                 {
-                    GST_INFO("Sending play command");
-                    bool async{true};
-                    m_clientBackend->play(async);
+                    shouldPlay = true;
                     m_clientState = ClientState::AWAITING_PLAYING;
-                    if (!async)
-                    {
-                        // Synchronous playing state change. Finish procedure for other sources and return SUCCESS_SYNC
-                        result = StateChangeResult::SUCCESS_SYNC;
-                        m_backendQueue->postMessage(
-                            std::make_shared<PlaybackStateMessage>(firebolt::rialto::PlaybackState::PLAYING, this));
-                        return;
-                    }
                 }
                 else
                 {
@@ -327,6 +474,10 @@ StateChangeResult GStreamerMSEMediaPlayerClient::play(int32_t sourceId)
 
             result = StateChangeResult::SUCCESS_ASYNC;
             sourceIt->second.m_delegate->postAsyncStart();
+            if (shouldPlay)
+            {
+                sendPlayCommand();
+            }
         });
 
     return result;
@@ -335,7 +486,7 @@ StateChangeResult GStreamerMSEMediaPlayerClient::play(int32_t sourceId)
 StateChangeResult GStreamerMSEMediaPlayerClient::pause(int32_t sourceId)
 {
     StateChangeResult result = StateChangeResult::NOT_ATTACHED;
-    m_backendQueue->callInEventLoop(
+    m_backendQueue->callInEventLoopWithPriority(
         [&]()
         {
             auto sourceIt = m_attachedSources.find(sourceId);
@@ -388,13 +539,15 @@ StateChangeResult GStreamerMSEMediaPlayerClient::pause(int32_t sourceId)
 
                 if (shouldPause)
                 {
-                    GST_INFO("Sending pause command in %u state", static_cast<uint32_t>(m_clientState));
-                    m_clientBackend->pause();
                     m_clientState = ClientState::AWAITING_PAUSED;
                 }
 
                 result = StateChangeResult::SUCCESS_ASYNC;
                 sourceIt->second.m_delegate->postAsyncStart();
+                if (shouldPause)
+                {
+                    sendPauseCommand();
+                }
             }
         });
 
@@ -403,17 +556,171 @@ StateChangeResult GStreamerMSEMediaPlayerClient::pause(int32_t sourceId)
 
 void GStreamerMSEMediaPlayerClient::stop()
 {
-    m_backendQueue->callInEventLoop([&]() { m_clientBackend->stop(); });
+    m_backendQueue->scheduleInEventLoopWithPriority(
+        [this]()
+        {
+            if (m_sessionRecorder)
+            {
+                m_sessionRecorder->recordStop();
+            }
+            std::shared_ptr<firebolt::rialto::client::MediaPlayerClientBackendInterface> clientBackend{
+                getClientBackend()};
+            if (!clientBackend)
+            {
+                GST_WARNING("Client backend is destroyed, cannot stop");
+                return;
+            }
+            if (!clientBackend->stop())
+            {
+                GST_ERROR("Stop command failed");
+            }
+        });
+}
+
+// Play/pause decisions and server state notifications are handled with priority, so they keep their order and the
+// state change thread doesn't wait for queued data messages. The server IPC is queued with priority too and is never
+// waited for by the state change thread. The result is reconciled by the playback state notification, or by the
+// FAILURE state if the command was rejected.
+void GStreamerMSEMediaPlayerClient::sendPlayCommand()
+{
+    m_backendQueue->scheduleInEventLoopWithPriority(
+        [this]()
+        {
+            GST_INFO("Sending play command");
+            if (m_sessionRecorder)
+            {
+                m_sessionRecorder->recordPlay();
+            }
+            bool async{true};
+            if (!m_clientBackend->play(async))
+            {
+                GST_ERROR("Play command failed");
+                handlePlaybackStateChange(firebolt::rialto::PlaybackState::FAILURE);
+                return;
+            }
+            if (!async)
+            {
+                // Synchronous playing state change - server will not notify it, so finish procedure for all sources
+                m_backendQueue->postMessageWithPriority(
+                    std::make_shared<PlaybackStateMessage>(firebolt::rialto::PlaybackState::PLAYING, this));
+            }
+        });
+}
+
+void GStreamerMSEMediaPlayerClient::sendPauseCommand()
+{
+    m_backendQueue->scheduleInEventLoopWithPriority(
+        [this]()
+        {
+            GST_INFO("Sending pause command");
+            if (m_sessionRecorder)
+            {
+                m_sessionRecorder->recordPause();
+            }
+            if (!m_clientBackend->pause())
+            {
+                GST_ERROR("Pause command failed");
+                handlePlaybackStateChange(firebolt::rialto::PlaybackState::FAILURE);
+            }
+        });
+}
+
+// Brings the stopped client back to its initial state, so that its MediaPipeline can be reused for a new playback
+bool GStreamerMSEMediaPlayerClient::reset()
+{
+    bool result{false};
+    m_backendQueue->callInEventLoop(
+        [&]()
+        {
+            for (auto &source : m_attachedSources)
+            {
+                source.second.m_bufferPuller->stop();
+                if (m_sessionRecorder)
+                {
+                    m_sessionRecorder->recordRemoveSource(source.first);
+                }
+                if (!m_clientBackend->removeSource(source.first))
+                {
+                    GST_WARNING("Remove source %d failed", source.first);
+                }
+                m_flushAndDataSynchronizer.removeSource(source.first);
+            }
+            m_attachedSources.clear();
+            m_wasAllSourcesAttachedSent = false;
+            m_audioStreams = UNKNOWN_STREAMS_NUMBER;
+            m_videoStreams = UNKNOWN_STREAMS_NUMBER;
+            m_subtitleStreams = UNKNOWN_STREAMS_NUMBER;
+            m_clientState = ClientState::IDLE;
+            m_serverPlaybackState = firebolt::rialto::PlaybackState::IDLE;
+            wasPlayingBeforeEos = false;
+            m_position = 0;
+            m_duration = DURATION_NOT_NOTIFIED;
+            if (m_playbackRate != 1.0 && m_sessionRecorder)
+            {
+                m_sessionRecorder->recordSetPlaybackRate(1.0);
+            }
+            if (m_playbackRate != 1.0 && m_clientBackend->setPlaybackRate(1.0))
+            {
+                m_playbackRate = 1.0;
+            }
+            {
+                std::unique_lock lock{m_playbackInfoMutex};
+                m_playbackInfo = firebolt::rialto::PlaybackInfo{-1, 1.0};
+            }
+            m_positionTracker.reset(-1);
+            m_positionTracker.setRate(m_playbackRate);
+            {
+                std::unique_lock lock{m_propertyCacheMutex};
+                m_propertyCache.mute.clear();
+                m_propertyCache.immediateOutput.clear();
+                m_propertyCache.stats.clear();
+            }
+
+            // Server accepts a new set of sources and all sources attached notification only after a new load
+            result = m_clientBackend->load(firebolt::rialto::MediaType::MSE, "", kMseUrl, m_isLive);
+            if (!result)
+            {
+                GST_ERROR("Could not load RialtoClient");
+            }
+        });
+    return result;
 }
 
 void GStreamerMSEMediaPlayerClient::setPlaybackRate(double rate)
 {
-    m_backendQueue->callInEventLoop([&]() { m_clientBackend->setPlaybackRate(rate); });
+    m_backendQueue->callInEventLoop(
+        [&]()
+        {
+            if (m_sessionRecorder)
+            {
+                m_sessionRecorder->recordSetPlaybackRate(rate);
+            }
+            if (m_clientBackend->setPlaybackRate(rate))
+            {
+                m_positionTracker.setRate(rate);
+                m_playbackRate = rate;
+            }
+        });
+}
+
+void GStreamerMSEMediaPlayerClient::stageSamples(int32_t sourceId)
+{
+    m_backendQueue->scheduleInEventLoop(
+        [this, sourceId]()
+        {
+            auto sourceIt = m_attachedSources.find(sourceId);
+            if (sourceIt != m_attachedSources.end())
+            {
+                sourceIt->second.m_bufferPuller->requestStaging(sourceId);
+            }
+        });
 }
 
 void GStreamerMSEMediaPlayerClient::flush(int32_t sourceId, bool resetTime)
 {
     m_flushAndDataSynchronizer.notifyFlushStarted(sourceId);
+    // Position updates are ignored during flush, so stop extrapolating until the flush is completed
+    m_positionTracker.startSegment();
     m_backendQueue->callInEventLoop(
         [&]()
         {
@@ -425,6 +732,10 @@ void GStreamerMSEMediaPlayerClient::flush(int32_t sourceId, bool resetTime)
                 GST_ERROR("Cannot flush - there's no attached source with id %d", sourceId);
                 return;
             }
+            if (m_sessionRecorder)
+            {
+                m_sessionRecorder->recordFlush(sourceId, resetTime);
+            }
             if (!m_clientBackend->flush(sourceId, resetTime, async))
             {
                 GST_ERROR("Flush operation failed for source with id %d", sourceId);
@@ -462,6 +773,10 @@ void GStreamerMSEMediaPlayerClient::setSourcePosition(int32_t sourceId, int64_t
                 GST_ERROR("Cannot Set Source Position - there's no attached source with id %d", sourceId);
                 return;
             }
+            if (m_sessionRecorder)
+            {
+                m_sessionRecorder->recordSetSourcePosition(sourceId, position, resetTime, appliedRate, stopPosition);
+            }
             if (!m_clientBackend->setSourcePosition(sourceId, position, resetTime, appliedRate, stopPosition))
             {
                 GST_ERROR("Set Source Position operation failed for source with id %d", sourceId);
@@ -516,13 +831,27 @@ bool GStreamerMSEMediaPlayerClient::attachSource(std::unique_ptr<firebolt::rialt
         return false;
     }
 
-    bool result = false;
-    m_backendQueue->callInEventLoop(
+    // Server side setup of the source is done on the caller's thread, so that attachments of different sources
+    // overlap and the backend queue is not blocked by the IPC. Only the bookkeeping is done in the event loop.
+    // Rialto client's attachSource is MT safe, like addSegment. The backend is copied, because the caller is
+    // a streaming thread, which may still run when the client backend is destroyed.
+    std::shared_ptr<firebolt::rialto::client::MediaPlayerClientBackendInterface> clientBackend{getClientBackend()};
+    if (!clientBackend)
+    {
+        GST_WARNING_OBJECT(rialtoSink, "Client backend is destroyed, cannot attach the source");
+        return false;
+    }
+    ++m_attachmentsInProgress;
+    const bool kResult{clientBackend->attachSource(source)};
+    if (kResult && m_sessionRecorder)
+    {
+        m_sessionRecorder->recordAttachSource(*source);
+    }
+    const bool kIsAttachmentRegistered{m_backendQueue->callInEventLoop(
         [&]()
         {
-            result = m_clientBackend->attachSource(source);
-
-            if (result)
+            --m_attachmentsInProgress;
+            if (kResult)
             {
                 std::shared_ptr<BufferParser> bufferParser;
                 if (source->getType() == firebolt::rialto::MediaSourceType::AUDIO)
@@ -538,24 +867,37 @@ bool GStreamerMSEMediaPlayerClient::attachSource(std::unique_ptr<firebolt::rialt
                     bufferParser = std::make_shared<SubtitleBufferParser>();
                 }
 
-                std::shared_ptr<BufferPuller> bufferPuller = std::make_shared<BufferPuller>(m_messageQueueFactory,
-                                                                                            GST_ELEMENT_CAST(rialtoSink),
-                                                                                            bufferParser, delegate);
+                std::shared_ptr<DataRequestStats> dataRequestStats = std::make_shared<DataRequestStats>();
+                std::shared_ptr<BufferPuller> bufferPuller =
+                    std::make_shared<BufferPuller>(m_messageQueueFactory, GST_ELEMENT_CAST(rialtoSink), bufferParser,
+                                                   delegate, dataRequestStats);
 
                 if (m_attachedSources.find(source->getId()) == m_attachedSources.end())
                 {
-                    m_attachedSources.emplace(source->getId(),
-                                              AttachedSource(rialtoSink, bufferPuller, delegate, source->getType()));
+                    m_attachedSources.emplace(source->getId(), AttachedSource(rialtoSink, bufferPuller, delegate,
+                                                                              dataRequestStats, source->getType()));
                     delegate->setSourceId(source->getId());
                     m_flushAndDataSynchronizer.addSource(source->getId());
                     bufferPuller->start();
                 }
             }
 
+            handleDeferredNeedDataInternal();
             sendAllSourcesAttachedIfPossibleInternal();
-        });
+        })};
 
-    return result;
+    return kResult && kIsAttachmentRegistered;
+}
+
+void GStreamerMSEMediaPlayerClient::handleDeferredNeedDataInternal()
+{
+    std::vector<std::shared_ptr<NeedDataMessage>> deferredNeedData;
+    deferredNeedData.swap(m_deferredNeedData);
+    for (const auto &message : deferredNeedData)
+    {
+        // Deferred again if its source is still being attached, otherwise answered with an error like before
+        message->handle();
+    }
 }
 
 void GStreamerMSEMediaPlayerClient::sendAllSourcesAttachedIfPossible()
@@ -570,6 +912,10 @@ void GStreamerMSEMediaPlayerClient::sendAllSourcesAttachedIfPossibleInternal()
         // RialtoServer doesn't support dynamic source attachment.
         // It means that when we notify that all sources were attached, we cannot add any more sources in the current session
         GST_INFO("All sources attached");
+        if (m_sessionRecorder)
+        {
+            m_sessionRecorder->recordAllSourcesAttached();
+        }
         m_clientBackend->allSourcesAttached();
         m_wasAllSourcesAttachedSent = true;
         m_clientState = ClientState::READY;
@@ -579,8 +925,8 @@ void GStreamerMSEMediaPlayerClient::sendAllSourcesAttachedIfPossibleInternal()
         if (checkIfAllAttachedSourcesInStates({ClientState::AWAITING_PAUSED}))
         {
             GST_INFO("Sending pause command, because all attached sources are ready to pause");
-            m_clientBackend->pause();
             m_clientState = ClientState::AWAITING_PAUSED;
+            sendPauseCommand();
         }
     }
 }
@@ -590,6 +936,10 @@ void GStreamerMSEMediaPlayerClient::removeSource(int32_t sourceId)
     m_backendQueue->callInEventLoop(
         [&]()
         {
+            if (m_sessionRecorder)
+            {
+                m_sessionRecorder->recordRemoveSource(sourceId);
+            }
             if (!m_clientBackend->removeSource(sourceId))
             {
                 GST_WARNING("Remove source %d failed", sourceId);
@@ -628,6 +978,7 @@ void GStreamerMSEMediaPlayerClient::handlePlaybackStateChange(firebolt::rialto::
                     GST_WARNING("Outdated Playback State change to PLAYING received. Discarding...");
                     break;
                 }
+                m_positionTracker.setPlaying(state == firebolt::rialto::PlaybackState::PLAYING);
 
                 for (auto &source : m_attachedSources)
                 {
@@ -652,6 +1003,7 @@ void GStreamerMSEMediaPlayerClient::handlePlaybackStateChange(firebolt::rialto::
                 {
                     wasPlayingBeforeEos = true;
                 }
+                m_positionTracker.setPlaying(false);
                 for (const auto &source : m_attachedSources)
                 {
                     source.second.m_delegate->handleEos();
@@ -678,6 +1030,7 @@ void GStreamerMSEMediaPlayerClient::handlePlaybackStateChange(firebolt::rialto::
                     std::unique_lock lock{m_playbackInfoMutex};
                     m_playbackInfo.currentPosition = 0;
                 }
+                m_positionTracker.reset(0);
 
                 break;
             }
@@ -707,6 +1060,12 @@ void GStreamerMSEMediaPlayerClient::handleSourceFlushed(int32_t sourceId)
             sourceIt->second.m_isFlushing = false;
             sourceIt->second.m_delegate->handleFlushCompleted();
             m_flushAndDataSynchronizer.notifyFlushCompleted(sourceId);
+            // Server doesn't have to notify PLAYING again after a flush, so resume extrapolation here
+            if (m_serverPlaybackState == firebolt::rialto::PlaybackState::PLAYING &&
+                !m_flushAndDataSynchronizer.isAnySourceFlushing())
+            {
+                m_positionTracker.setPlaying(true);
+            }
         });
 }
 
@@ -778,17 +1137,30 @@ void GStreamerMSEMediaPlayerClient::setVolume(double targetVolume, uint32_t volu
     m_backendQueue->callInEventLoop(
         [&]()
         {
-            m_clientBackend->setVolume(targetVolume, volumeDuration, easeType);
-            std::unique_lock lock{m_playbackInfoMutex};
-            m_playbackInfo.volume = targetVolume;
+            const bool kStatus{m_clientBackend->setVolume(targetVolume, volumeDuration, easeType)};
+            {
+                std::unique_lock lock{m_playbackInfoMutex};
+                m_playbackInfo.volume = targetVolume;
+            }
+            std::unique_lock lock{m_propertyCacheMutex};
+            if (kStatus && volumeDuration == 0)
+            {
+                m_propertyCache.volume = targetVolume;
+            }
+            else
+            {
+                // Volume is fading, next read has to go to the server
+                m_propertyCache.volume.reset();
+            }
         });
 }
 
-bool GStreamerMSEMediaPlayerClient::getVolume(double &volume)
+bool GStreamerMSEMediaPlayerClient::getVolume(double &volume, bool isCacheBypassed)
 {
-    bool success{false};
-    m_backendQueue->callInEventLoop([&]() { success = m_clientBackend->getVolume(volume); });
-    return success;
+    // Volume changes during fade, so cached value is returned and refreshed in background
+    return getProperty<double>([](PropertyCache &cache) -> std::optional<double> & { return cache.volume; }, volume,
+                               [this](double &value) { return m_clientBackend->getVolume(value); }, isCacheBypassed,
+                               "volume");
 }
 
 bool GStreamerMSEMediaPlayerClient::getCachedVolume(double &volume)
@@ -800,13 +1172,21 @@ bool GStreamerMSEMediaPlayerClient::getCachedVolume(double &volume)
 
 void GStreamerMSEMediaPlayerClient::setMute(bool mute, int32_t sourceId)
 {
-    m_backendQueue->callInEventLoop([&]() { m_clientBackend->setMute(mute, sourceId); });
+    bool status{false};
+    m_backendQueue->callInEventLoop([&]() { status = m_clientBackend->setMute(mute, sourceId); });
+    if (status)
+    {
+        std::unique_lock lock{m_propertyCacheMutex};
+        m_propertyCache.mute[sourceId] = mute;
+    }
 }
 
-bool GStreamerMSEMediaPlayerClient::getMute(int sourceId)
+bool GStreamerMSEMediaPlayerClient::getMute(int sourceId, bool isCacheBypassed)
 {
     bool mute{false};
-    m_backendQueue->callInEventLoop([&]() { m_clientBackend->getMute(mute, sourceId); });
+    getProperty<bool>([sourceId](PropertyCache &cache) -> std::optional<bool> & { return cache.mute[sourceId]; }, mute,
+                      [this, sourceId](bool &value) { return m_clientBackend->getMute(value, sourceId); },
+                      isCacheBypassed);
 
     return mute;
 }
@@ -844,19 +1224,23 @@ bool GStreamerMSEMediaPlayerClient::setSync(bool sync)
 
     bool status{false};
     m_backendQueue->callInEventLoop([&]() { status = m_clientBackend->setSync(sync); });
+    if (status)
+    {
+        std::unique_lock lock{m_propertyCacheMutex};
+        m_propertyCache.sync = sync;
+    }
     return status;
 }
 
-bool GStreamerMSEMediaPlayerClient::getSync(bool &sync)
+bool GStreamerMSEMediaPlayerClient::getSync(bool &sync, bool isCacheBypassed)
 {
     if (!m_clientBackend)
     {
         return false;
     }
 
-    bool status{false};
-    m_backendQueue->callInEventLoop([&]() { status = m_clientBackend->getSync(sync); });
-    return status;
+    return getProperty<bool>([](PropertyCache &cache) -> std::optional<bool> & { return cache.sync; }, sync,
+                             [this](bool &value) { return m_clientBackend->getSync(value); }, isCacheBypassed);
 }
 
 bool GStreamerMSEMediaPlayerClient::setSyncOff(bool syncOff)
@@ -880,19 +1264,25 @@ bool GStreamerMSEMediaPlayerClient::setStreamSyncMode(int32_t sourceId, int32_t
 
     bool status{false};
     m_backendQueue->callInEventLoop([&]() { status = m_clientBackend->setStreamSyncMode(sourceId, streamSyncMode); });
+    if (status)
+    {
+        std::unique_lock lock{m_propertyCacheMutex};
+        m_propertyCache.streamSyncMode = streamSyncMode;
+    }
     return status;
 }
 
-bool GStreamerMSEMediaPlayerClient::getStreamSyncMode(int32_t &streamSyncMode)
+bool GStreamerMSEMediaPlayerClient::getStreamSyncMode(int32_t &streamSyncMode, bool isCacheBypassed)
 {
     if (!m_clientBackend)
     {
         return false;
     }
 
-    bool status{false};
-    m_backendQueue->callInEventLoop([&]() { status = m_clientBackend->getStreamSyncMode(streamSyncMode); });
-    return status;
+    return getProperty<int32_t>([](PropertyCache &cache) -> std::optional<int32_t> & { return cache.streamSyncMode; },
+                                streamSyncMode,
+                                [this](int32_t &value) { return m_clientBackend->getStreamSyncMode(value); },
+                                isCacheBypassed);
 }
 
 ClientState GStreamerMSEMediaPlayerClient::getClientState()
@@ -926,10 +1316,16 @@ void GStreamerMSEMediaPlayerClient::setBufferingLimit(uint32_t limitBufferingMs)
     {
         return;
     }
-    m_backendQueue->callInEventLoop([&]() { m_clientBackend->setBufferingLimit(limitBufferingMs); });
+    bool status{false};
+    m_backendQueue->callInEventLoop([&]() { status = m_clientBackend->setBufferingLimit(limitBufferingMs); });
+    if (status)
+    {
+        std::unique_lock lock{m_propertyCacheMutex};
+        m_propertyCache.bufferingLimit = limitBufferingMs;
+    }
 }
 
-uint32_t GStreamerMSEMediaPlayerClient::getBufferingLimit()
+uint32_t GStreamerMSEMediaPlayerClient::getBufferingLimit(bool isCacheBypassed)
 {
     if (!m_clientBackend)
     {
@@ -937,7 +1333,10 @@ uint32_t GStreamerMSEMediaPlayerClient::getBufferingLimit()
     }
 
     uint32_t result{kDefaultBufferingLimit};
-    m_backendQueue->callInEventLoop([&]() { m_clientBackend->getBufferingLimit(result); });
+    getProperty<uint32_t>([](PropertyCache &cache) -> std::optional<uint32_t> & { return cache.bufferingLimit; },
+                          result,
+                          [this](uint32_t &value) { return m_clientBackend->getBufferingLimit(value); },
+                          isCacheBypassed);
     return result;
 }
 
@@ -947,10 +1346,16 @@ void GStreamerMSEMediaPlayerClient::setUseBuffering(bool useBuffering)
     {
         return;
     }
-    m_backendQueue->callInEventLoop([&]() { m_clientBackend->setUseBuffering(useBuffering); });
+    bool status{false};
+    m_backendQueue->callInEventLoop([&]() { status = m_clientBackend->setUseBuffering(useBuffering); });
+    if (status)
+    {
+        std::unique_lock lock{m_propertyCacheMutex};
+        m_propertyCache.useBuffering = useBuffering;
+    }
 }
 
-bool GStreamerMSEMediaPlayerClient::getUseBuffering()
+bool GStreamerMSEMediaPlayerClient::getUseBuffering(bool isCacheBypassed)
 {
     if (!m_clientBackend)
     {
@@ -958,7 +1363,8 @@ bool GStreamerMSEMediaPlayerClient::getUseBuffering()
     }
 
     bool result{kDefaultUseBuffering};
-    m_backendQueue->callInEventLoop([&]() { m_clientBackend->getUseBuffering(result); });
+    getProperty<bool>([](PropertyCache &cache) -> std::optional<bool> & { return cache.useBuffering; }, result,
+                      [this](bool &value) { return m_clientBackend->getUseBuffering(value); }, isCacheBypassed);
     return result;
 }
 
@@ -1006,13 +1412,22 @@ bool GStreamerMSEMediaPlayerClient::areAllStreamsAttached()
            attachedSubtitleSources == m_subtitleStreams;
 }
 
-bool GStreamerMSEMediaPlayerClient::requestPullBuffer(int streamId, size_t frameCount, unsigned int needDataRequestId)
+bool GStreamerMSEMediaPlayerClient::requestPullBuffer(int streamId, size_t frameCount, unsigned int needDataRequestId,
+                                                      DataRequestStats::Clock::time_point receivedTime)
 {
     bool result = false;
     m_backendQueue->callInEventLoop(
         [&]()
         {
             auto sourceIt = m_attachedSources.find(streamId);
+            if (sourceIt == m_attachedSources.end() && m_attachmentsInProgress > 0)
+            {
+                GST_INFO("Source %d may not be registered yet, deferring need data %u", streamId, needDataRequestId);
+                m_deferredNeedData.push_back(
+                    std::make_shared<NeedDataMessage>(streamId, frameCount, needDataRequestId, this, receivedTime));
+                result = true;
+                return;
+            }
             if (sourceIt == m_attachedSources.end())
             {
                 GST_ERROR("There's no attached source with id %d", streamId);
@@ -1020,12 +1435,46 @@ bool GStreamerMSEMediaPlayerClient::requestPullBuffer(int streamId, size_t frame
                 result = false;
                 return;
             }
+            sourceIt->second.m_dataRequestStats->onNeedData(needDataRequestId, frameCount, receivedTime);
             result = sourceIt->second.m_bufferPuller->requestPullBuffer(streamId, frameCount, needDataRequestId, this);
         });
 
     return result;
 }
 
+std::optional<DataRequestStats::Snapshot> GStreamerMSEMediaPlayerClient::getDataRequestStats(int32_t sourceId)
+{
+    std::optional<DataRequestStats::Snapshot> snapshot;
+    m_backendQueue->callInEventLoop(
+        [&]()
+        {
+            auto sourceIt = m_attachedSources.find(sourceId);
+            if (sourceIt != m_attachedSources.end())
+            {
+                snapshot = sourceIt->second.m_dataRequestStats->getSnapshot();
+            }
+        });
+    return snapshot;
+}
+
+void GStreamerMSEMediaPlayerClient::postDataRequestStats(AttachedSource &source, bool isForced)
+{
+    if (m_dataRequestStatsInterval.count() == 0)
+    {
+        return;
+    }
+    const auto kNow{DataRequestStats::Clock::now()};
+    if (!isForced && kNow - source.m_lastDataRequestStatsPostTime < m_dataRequestStatsInterval)
+    {
+        return;
+    }
+    source.m_lastDataRequestStatsPostTime = kNow;
+    GstStructure *structure{gst_structure_new_empty("rialto-data-request-stats")};
+    DataRequestStats::addToStructure(structure, source.m_dataRequestStats->getSnapshot());
+    gst_element_post_message(GST_ELEMENT_CAST(source.m_rialtoSink),
+                             gst_message_new_element(GST_OBJECT_CAST(source.m_rialtoSink), structure));
+}
+
 bool GStreamerMSEMediaPlayerClient::handleQos(int sourceId, firebolt::rialto::QosInfo qosInfo)
 {
     bool result = false;
@@ -1059,6 +1508,8 @@ bool GStreamerMSEMediaPlayerClient::handleBufferUnderflow(int sourceId)
             }
 
             rialto_mse_base_handle_rialto_server_sent_buffer_underflow(sourceIt->second.m_rialtoSink);
+            // Stats leading up to the underflow are what's needed to diagnose it
+            postDataRequestStats(sourceIt->second, true);
 
             result = true;
         });
@@ -1142,14 +1593,27 @@ firebolt::rialto::AddSegmentStatus GStreamerMSEMediaPlayerClient::addSegment(
     unsigned int needDataRequestId, const std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> &mediaSegment)
 {
     // rialto client's addSegment call is MT safe, so it's ok to call it from the Puller's thread
-    return m_clientBackend->addSegment(needDataRequestId, mediaSegment);
+    const GstClockTime kStartTime{RialtoTracing::isEnabled() ? gst_util_get_timestamp() : 0};
+    const firebolt::rialto::AddSegmentStatus kStatus{m_clientBackend->addSegment(needDataRequestId, mediaSegment)};
+    if (RialtoTracing::isEnabled())
+    {
+        RialtoTracing::segmentAdded(mediaSegment->getId(), needDataRequestId, kStatus,
+                                    gst_util_get_timestamp() - kStartTime);
+    }
+    if (m_sessionRecorder)
+    {
+        m_sessionRecorder->recordSegment(needDataRequestId, *mediaSegment, kStatus);
+    }
+    return kStatus;
 }
 
 BufferPuller::BufferPuller(const std::shared_ptr<IMessageQueueFactory> &messageQueueFactory, GstElement *rialtoSink,
                            const std::shared_ptr<BufferParser> &bufferParser,
-                           const std::shared_ptr<IPullModePlaybackDelegate> &delegate)
-    : m_queue{messageQueueFactory->createMessageQueue()}, m_rialtoSink(rialtoSink), m_bufferParser(bufferParser),
-      m_delegate{delegate}
+                           const std::shared_ptr<IPullModePlaybackDelegate> &delegate,
+                           const std::shared_ptr<DataRequestStats> &dataRequestStats)
+    : m_queue{messageQueueFactory->createMessageQueue(std::string{"puller-"} +
+                                                      (rialtoSink ? GST_ELEMENT_NAME(rialtoSink) : "unknown"))},
+      m_rialtoSink(rialtoSink), m_bufferParser(bufferParser), m_delegate{delegate}, m_dataRequestStats{dataRequestStats}
 {
 }
 
@@ -1167,7 +1631,26 @@ bool BufferPuller::requestPullBuffer(int sourceId, size_t frameCount, unsigned i
                                      GStreamerMSEMediaPlayerClient *player)
 {
     return m_queue->postMessage(std::make_shared<PullBufferMessage>(sourceId, frameCount, needDataRequestId, m_rialtoSink,
-                                                                    m_bufferParser, *m_queue, player, m_delegate));
+                                                                    m_bufferParser, *m_queue, player, m_delegate,
+                                                                    m_dataRequestStats, m_stagedSegments));
+}
+
+bool BufferPuller::requestStaging(int sourceId)
+{
+    return m_queue->postMessage(
+        std::make_shared<StageSamplesMessage>(sourceId, m_rialtoSink, m_bufferParser, m_delegate, m_stagedSegments));
+}
+
+StagedSegment::StagedSegment(uint64_t sampleIndex, GstBuffer *buffer, const GstMapInfo &map,
+                             std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> &&segment)
+    : m_sampleIndex{sampleIndex}, m_buffer{buffer}, m_map(map), m_segment{std::move(segment)}
+{
+}
+
+StagedSegment::~StagedSegment()
+{
+    gst_buffer_unmap(m_buffer, &m_map);
+    gst_buffer_unref(m_buffer);
 }
 
 HaveDataMessage::HaveDataMessage(firebolt::rialto::MediaSourceStatus status, int sourceId,
@@ -1178,28 +1661,59 @@ HaveDataMessage::HaveDataMessage(firebolt::rialto::MediaSourceStatus status, int
 
 void HaveDataMessage::handle()
 {
-    if (m_player->m_attachedSources.find(m_sourceId) == m_player->m_attachedSources.end())
+    auto sourceIt = m_player->m_attachedSources.find(m_sourceId);
+    if (sourceIt == m_player->m_attachedSources.end())
     {
         GST_WARNING("Source id %d is invalid", m_sourceId);
         return;
     }
 
+    if (m_player->m_sessionRecorder)
+    {
+        m_player->m_sessionRecorder->recordHaveData(m_sourceId, m_needDataRequestId, m_status);
+    }
     m_player->m_clientBackend->haveData(m_status, m_needDataRequestId);
+    RialtoTracing::haveData(m_sourceId, m_needDataRequestId, m_status);
+    sourceIt->second.m_dataRequestStats->onHaveData(m_needDataRequestId, m_status);
+    m_player->postDataRequestStats(sourceIt->second, false);
 }
 
 PullBufferMessage::PullBufferMessage(int sourceId, size_t frameCount, unsigned int needDataRequestId,
                                      GstElement *rialtoSink, const std::shared_ptr<BufferParser> &bufferParser,
                                      IMessageQueue &pullerQueue, GStreamerMSEMediaPlayerClient *player,
-                                     const std::shared_ptr<IPullModePlaybackDelegate> &delegate)
+                                     const std::shared_ptr<IPullModePlaybackDelegate> &delegate,
+                                     const std::shared_ptr<DataRequestStats> &dataRequestStats,
+                                     StagedSegments &stagedSegments)
     : m_sourceId(sourceId), m_frameCount(frameCount), m_needDataRequestId(needDataRequestId), m_rialtoSink(rialtoSink),
-      m_bufferParser(bufferParser), m_pullerQueue(pullerQueue), m_player(player), m_delegate{delegate}
+      m_bufferParser(bufferParser), m_pullerQueue(pullerQueue), m_player(player), m_delegate{delegate},
+      m_dataRequestStats{dataRequestStats}, m_stagedSegments(stagedSegments)
 {
 }
 
+std::unique_ptr<StagedSegment> PullBufferMessage::takeStagedSegment(uint64_t sampleIndex)
+{
+    if (m_stagedSegments.empty())
+    {
+        return nullptr;
+    }
+    if (m_stagedSegments.front()->getSampleIndex() != sampleIndex)
+    {
+        // Samples have been flushed since they were staged
+        GST_DEBUG_OBJECT(m_rialtoSink, "Dropping %zu outdated staged segments", m_stagedSegments.size());
+        m_stagedSegments.clear();
+        return nullptr;
+    }
+    std::unique_ptr<StagedSegment> stagedSegment{std::move(m_stagedSegments.front())};
+    m_stagedSegments.pop_front();
+    return stagedSegment;
+}
+
 void PullBufferMessage::handle()
 {
+    TraceSpan span{"puller", "pull batch", "frames", static_cast<int64_t>(m_frameCount)};
     bool isEos = false;
     unsigned int addedSegments = 0;
+    m_dataRequestStats->onPullStarted(m_needDataRequestId);
 
     for (unsigned int frame = 0; frame < m_frameCount; ++frame)
     {
@@ -1208,7 +1722,8 @@ void PullBufferMessage::handle()
             GST_INFO_OBJECT(m_rialtoSink, "Not ready to send data - segment or eos not received yet");
             break;
         }
-        GstRefSample sample = m_delegate->getFrontSample();
+        uint64_t sampleIndex{0};
+        GstRefSample sample = m_delegate->getFrontSample(sampleIndex);
         if (!sample)
         {
             if (m_delegate->isEos())
@@ -1223,36 +1738,48 @@ void PullBufferMessage::handle()
             break;
         }
 
-        // we pass GstMapInfo's pointers on data buffers to RialtoClient
-        // so we need to hold it until RialtoClient copies them to shm
+        // Samples received while server was flushing might have been parsed already
         GstBuffer *buffer = sample.getBuffer();
-        GstMapInfo map;
-        if (!gst_buffer_map(buffer, &map, GST_MAP_READ))
+        std::unique_ptr<StagedSegment> stagedSegment{takeStagedSegment(sampleIndex)};
+        if (!stagedSegment)
         {
-            GST_ERROR_OBJECT(m_rialtoSink, "Could not map buffer");
-            m_delegate->popSample();
-            continue;
-        }
+            // we pass GstMapInfo's pointers on data buffers to RialtoClient
+            // so we need to hold it until RialtoClient copies them to shm
+            GstMapInfo map;
+            if (!gst_buffer_map(buffer, &map, GST_MAP_READ))
+            {
+                GST_ERROR_OBJECT(m_rialtoSink, "Could not map buffer");
+                m_delegate->popSample();
+                continue;
+            }
 
-        std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> mseData =
-            m_bufferParser->parseBuffer(sample, buffer, map, m_sourceId);
-        if (!mseData)
-        {
-            GST_ERROR_OBJECT(m_rialtoSink, "No data returned from the parser");
-            gst_buffer_unmap(buffer, &map);
-            m_delegate->popSample();
-            continue;
+            const auto kParseStartTime{DataRequestStats::Clock::now()};
+            std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> mseData =
+                m_bufferParser->parseBuffer(sample, buffer, map, m_sourceId);
+            m_dataRequestStats->onSegmentParsed(DataRequestStats::Clock::now() - kParseStartTime);
+            if (!mseData)
+            {
+                GST_ERROR_OBJECT(m_rialtoSink, "No data returned from the parser");
+                gst_buffer_unmap(buffer, &map);
+                m_delegate->popSample();
+                continue;
+            }
+            stagedSegment =
+                std::make_unique<StagedSegment>(sampleIndex, gst_buffer_ref(buffer), map, std::move(mseData));
         }
 
-        firebolt::rialto::AddSegmentStatus addSegmentStatus = m_player->addSegment(m_needDataRequestId, mseData);
+        const auto kAddSegmentStartTime{DataRequestStats::Clock::now()};
+        firebolt::rialto::AddSegmentStatus addSegmentStatus =
+            m_player->addSegment(m_needDataRequestId, stagedSegment->getSegment());
+        m_dataRequestStats->onSegmentAdded(DataRequestStats::Clock::now() - kAddSegmentStartTime, addSegmentStatus);
         if (addSegmentStatus == firebolt::rialto::AddSegmentStatus::NO_SPACE)
         {
-            gst_buffer_unmap(buffer, &map);
+            // Keep the parsed segment for the next need data request
+            m_stagedSegments.push_front(std::move(stagedSegment));
             GST_INFO_OBJECT(m_rialtoSink, "There's no space to add sample");
             break;
         }
 
-        gst_buffer_unmap(buffer, &map);
         m_delegate->popSample();
         addedSegments++;
     }
@@ -1276,15 +1803,67 @@ void PullBufferMessage::handle()
         std::make_shared<HaveDataMessage>(status, m_sourceId, m_needDataRequestId, m_player));
 }
 
+StageSamplesMessage::StageSamplesMessage(int sourceId, GstElement *rialtoSink,
+                                         const std::shared_ptr<BufferParser> &bufferParser,
+                                         const std::shared_ptr<IPullModePlaybackDelegate> &delegate,
+                                         StagedSegments &stagedSegments)
+    : m_sourceId(sourceId), m_rialtoSink(rialtoSink), m_bufferParser(bufferParser), m_delegate{delegate},
+      m_stagedSegments(stagedSegments)
+{
+}
+
+void StageSamplesMessage::handle()
+{
+    if (!m_stagedSegments.empty())
+    {
+        uint64_t frontSampleIndex{0};
+        GstRefSample frontSample = m_delegate->getSample(0, frontSampleIndex);
+        if (!frontSample || frontSampleIndex != m_stagedSegments.front()->getSampleIndex())
+        {
+            m_stagedSegments.clear();
+        }
+    }
+
+    for (size_t position = m_stagedSegments.size(); position < kMaxStagedSamples; ++position)
+    {
+        uint64_t sampleIndex{0};
+        GstRefSample sample = m_delegate->getSample(position, sampleIndex);
+        if (!sample)
+        {
+            break;
+        }
+        GstBuffer *buffer = sample.getBuffer();
+        GstMapInfo map;
+        if (!gst_buffer_map(buffer, &map, GST_MAP_READ))
+        {
+            GST_WARNING_OBJECT(m_rialtoSink, "Could not map buffer for staging");
+            break;
+        }
+        std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> mseData =
+            m_bufferParser->parseBuffer(sample, buffer, map, m_sourceId);
+        if (!mseData)
+        {
+            // Error will be reported when the sample is pulled
+            gst_buffer_unmap(buffer, &map);
+            break;
+        }
+        m_stagedSegments.push_back(
+            std::make_unique<StagedSegment>(sampleIndex, gst_buffer_ref(buffer), map, std::move(mseData)));
+    }
+    GST_LOG_OBJECT(m_rialtoSink, "%zu segments staged for source %d", m_stagedSegments.size(), m_sourceId);
+}
+
 NeedDataMessage::NeedDataMessage(int sourceId, size_t frameCount, unsigned int needDataRequestId,
-                                 GStreamerMSEMediaPlayerClient *player)
-    : m_sourceId(sourceId), m_frameCount(frameCount), m_needDataRequestId(needDataRequestId), m_player(player)
+                                 GStreamerMSEMediaPlayerClient *player,
+                                 DataRequestStats::Clock::time_point receivedTime)
+    : m_sourceId(sourceId), m_frameCount(frameCount), m_needDataRequestId(needDataRequestId), m_player(player),
+      m_receivedTime(receivedTime)
 {
 }
 
 void NeedDataMessage::handle()
 {
-    if (!m_player->requestPullBuffer(m_sourceId, m_frameCount, m_needDataRequestId))
+    if (!m_player->requestPullBuffer(m_sourceId, m_frameCount, m_needDataRequestId, m_receivedTime))
     {
         GST_ERROR("Failed to pull buffer for sourceId=%d and NeedDataRequestId %u", m_sourceId, m_needDataRequestId);
         m_player->m_backendQueue->postMessage(
@@ -1369,14 +1948,14 @@ void SetPositionMessage::handle()
     }
 }
 
-SetDurationMessage::SetDurationMessage(int64_t newDuration, int64_t &targetDuration)
+SetDurationMessage::SetDurationMessage(int64_t newDuration, std::atomic<int64_t> &targetDuration)
     : m_newDuration(newDuration), m_targetDuration(targetDuration)
 {
 }
 
 void SetDurationMessage::handle()
 {
-    m_targetDuration = m_newDuration;
+    m_targetDuration.store(m_newDuration, std::memory_order_release);
 }
 
 SourceFlushedMessage::SourceFlushedMessage(int32_t sourceId, GStreamerMSEMediaPlayerClient *player)
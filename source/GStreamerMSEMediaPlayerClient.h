@@ -19,10 +19,14 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
@@ -35,13 +39,16 @@
 
 #include "BufferParser.h"
 #include "Constants.h"
+#include "DataRequestStats.h"
 #include "FlushAndDataSynchronizer.h"
 #include "IMediaPipeline.h"
 #include "IMessageQueue.h"
 #include "IPullModePlaybackDelegate.h"
 #include "MediaCommon.h"
 #include "MediaPlayerClientBackendInterface.h"
+#include "PlaybackPositionTracker.h"
 #include "RialtoGStreamerMSEBaseSink.h"
+#include "SessionRecorder.h"
 
 #define DEFAULT_MAX_VIDEO_WIDTH 3840
 #define DEFAULT_MAX_VIDEO_HEIGHT 2160
@@ -58,23 +65,51 @@ enum class ClientState
     PLAYING
 };
 
+// Sample parsed ahead of a need data request. Holds the buffer mapped, because the segment points to its data.
+class StagedSegment
+{
+public:
+    StagedSegment(uint64_t sampleIndex, GstBuffer *buffer, const GstMapInfo &map,
+                  std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> &&segment);
+    ~StagedSegment();
+    StagedSegment(const StagedSegment &) = delete;
+    StagedSegment &operator=(const StagedSegment &) = delete;
+
+    uint64_t getSampleIndex() const { return m_sampleIndex; }
+    const std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> &getSegment() const { return m_segment; }
+
+private:
+    uint64_t m_sampleIndex;
+    GstBuffer *m_buffer;
+    GstMapInfo m_map;
+    std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> m_segment;
+};
+
+// Accessed only from the buffer puller thread
+using StagedSegments = std::deque<std::unique_ptr<StagedSegment>>;
+
 class BufferPuller
 {
 public:
     BufferPuller(const std::shared_ptr<IMessageQueueFactory> &messageQueueFactory, GstElement *rialtoSink,
                  const std::shared_ptr<BufferParser> &bufferParser,
-                 const std::shared_ptr<IPullModePlaybackDelegate> &delegate);
+                 const std::shared_ptr<IPullModePlaybackDelegate> &delegate,
+                 const std::shared_ptr<DataRequestStats> &dataRequestStats);
 
     void start();
     void stop();
     bool requestPullBuffer(int sourceId, size_t frameCount, unsigned int needDataRequestId,
                            GStreamerMSEMediaPlayerClient *player);
+    bool requestStaging(int sourceId);
 
 private:
+    // Declared before the queue, so that it outlives messages referencing it
+    StagedSegments m_stagedSegments;
     std::unique_ptr<IMessageQueue> m_queue;
     GstElement *m_rialtoSink;
     std::shared_ptr<BufferParser> m_bufferParser;
     std::shared_ptr<IPullModePlaybackDelegate> m_delegate;
+    std::shared_ptr<DataRequestStats> m_dataRequestStats;
 };
 
 class AttachedSource
@@ -83,9 +118,11 @@ class AttachedSource
 
 public:
     AttachedSource(RialtoMSEBaseSink *rialtoSink, std::shared_ptr<BufferPuller> puller,
-                   const std::shared_ptr<IPullModePlaybackDelegate> &delegate, firebolt::rialto::MediaSourceType type,
+                   const std::shared_ptr<IPullModePlaybackDelegate> &delegate,
+                   const std::shared_ptr<DataRequestStats> &dataRequestStats, firebolt::rialto::MediaSourceType type,
                    ClientState state = ClientState::READY)
-        : m_rialtoSink(rialtoSink), m_bufferPuller(puller), m_delegate{delegate}, m_type(type), m_state(state)
+        : m_rialtoSink(rialtoSink), m_bufferPuller(puller), m_delegate{delegate}, m_dataRequestStats{dataRequestStats},
+          m_type(type), m_state(state)
     {
     }
 
@@ -97,6 +134,8 @@ private:
     std::shared_ptr<BufferPuller> m_bufferPuller;
     std::shared_ptr<IPullModePlaybackDelegate> m_delegate;
     std::unordered_set<uint32_t> m_ongoingNeedDataRequests;
+    std::shared_ptr<DataRequestStats> m_dataRequestStats;
+    DataRequestStats::Clock::time_point m_lastDataRequestStatsPostTime;
     firebolt::rialto::MediaSourceType m_type = firebolt::rialto::MediaSourceType::UNKNOWN;
     int64_t m_position = 0;
     bool m_isFlushing = false;
@@ -122,10 +161,13 @@ class PullBufferMessage : public Message
 public:
     PullBufferMessage(int sourceId, size_t frameCount, unsigned int needDataRequestId, GstElement *rialtoSink,
                       const std::shared_ptr<BufferParser> &bufferParser, IMessageQueue &pullerQueue,
-                      GStreamerMSEMediaPlayerClient *player, const std::shared_ptr<IPullModePlaybackDelegate> &delegate);
+                      GStreamerMSEMediaPlayerClient *player, const std::shared_ptr<IPullModePlaybackDelegate> &delegate,
+                      const std::shared_ptr<DataRequestStats> &dataRequestStats, StagedSegments &stagedSegments);
     void handle() override;
 
 private:
+    std::unique_ptr<StagedSegment> takeStagedSegment(uint64_t sampleIndex);
+
     int m_sourceId;
     size_t m_frameCount;
     unsigned int m_needDataRequestId;
@@ -134,13 +176,31 @@ private:
     IMessageQueue &m_pullerQueue;
     GStreamerMSEMediaPlayerClient *m_player;
     std::shared_ptr<IPullModePlaybackDelegate> m_delegate;
+    std::shared_ptr<DataRequestStats> m_dataRequestStats;
+    StagedSegments &m_stagedSegments;
+};
+
+class StageSamplesMessage : public Message
+{
+public:
+    StageSamplesMessage(int sourceId, GstElement *rialtoSink, const std::shared_ptr<BufferParser> &bufferParser,
+                        const std::shared_ptr<IPullModePlaybackDelegate> &delegate, StagedSegments &stagedSegments);
+    void handle() override;
+
+private:
+    int m_sourceId;
+    GstElement *m_rialtoSink;
+    std::shared_ptr<BufferParser> m_bufferParser;
+    std::shared_ptr<IPullModePlaybackDelegate> m_delegate;
+    StagedSegments &m_stagedSegments;
 };
 
 class NeedDataMessage : public Message
 {
 public:
     NeedDataMessage(int sourceId, size_t frameCount, unsigned int needDataRequestId,
-                    GStreamerMSEMediaPlayerClient *player);
+                    GStreamerMSEMediaPlayerClient *player,
+                    DataRequestStats::Clock::time_point receivedTime = DataRequestStats::Clock::now());
     void handle() override;
 
 private:
@@ -148,6 +208,7 @@ private:
     size_t m_frameCount;
     unsigned int m_needDataRequestId;
     GStreamerMSEMediaPlayerClient *m_player;
+    DataRequestStats::Clock::time_point m_receivedTime;
 };
 
 class PlaybackStateMessage : public Message
@@ -221,12 +282,12 @@ private:
 class SetDurationMessage : public Message
 {
 public:
-    SetDurationMessage(int64_t newDuration, int64_t &targetDuration);
+    SetDurationMessage(int64_t newDuration, std::atomic<int64_t> &targetDuration);
     void handle() override;
 
 private:
     int64_t m_newDuration;
-    int64_t &m_targetDuration;
+    std::atomic<int64_t> &m_targetDuration;
 };
 
 class SourceFlushedMessage : public Message
@@ -282,19 +343,24 @@ public:
     int64_t getPosition(int32_t sourceId);
     bool getDuration(int64_t &duration);
     bool setImmediateOutput(int32_t sourceId, bool immediateOutput);
-    bool getImmediateOutput(int32_t sourceId, bool &immediateOutput);
-    bool getStats(int32_t sourceId, uint64_t &renderedFrames, uint64_t &droppedFrames);
+    // Getters of cached properties read the server instead of the cache when isCacheBypassed is set
+    bool getImmediateOutput(int32_t sourceId, bool &immediateOutput, bool isCacheBypassed = false);
+    bool getStats(int32_t sourceId, uint64_t &renderedFrames, uint64_t &droppedFrames, bool isCacheBypassed = false);
+    std::optional<DataRequestStats::Snapshot> getDataRequestStats(int32_t sourceId);
 
     firebolt::rialto::AddSegmentStatus
     addSegment(unsigned int needDataRequestId,
                const std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> &mediaSegment);
 
     bool createBackend();
+    bool isHealthy();
     StateChangeResult play(int32_t sourceId);
     StateChangeResult pause(int32_t sourceId);
     void stop();
+    bool reset();
     void setPlaybackRate(double rate);
     void flush(int32_t sourceId, bool resetTime);
+    void stageSamples(int32_t sourceId);
     void setSourcePosition(int32_t sourceId, int64_t position, bool resetTime, double appliedRate = 1.0,
                            uint64_t stopPosition = GST_CLOCK_TIME_NONE);
     void setSubtitleOffset(int32_t sourceId, int64_t position);
@@ -310,7 +376,9 @@ public:
     void setVideoRectangle(const std::string &rectangleString);
     std::string getVideoRectangle();
 
-    bool requestPullBuffer(int streamId, size_t frameCount, unsigned int needDataRequestId);
+    bool requestPullBuffer(int streamId, size_t frameCount, unsigned int needDataRequestId,
+                           DataRequestStats::Clock::time_point receivedTime);
+    void postDataRequestStats(AttachedSource &source, bool isForced);
     bool handleQos(int sourceId, firebolt::rialto::QosInfo qosInfo);
     bool handleBufferUnderflow(int sourceId);
     bool handleFirstFrameReceived(int sourceId);
@@ -319,44 +387,58 @@ public:
     void destroyClientBackend();
     bool renderFrame(int32_t sourceId);
     void setVolume(double targetVolume, uint32_t volumeDuration, firebolt::rialto::EaseType easeType);
-    bool getVolume(double &volume);
+    bool getVolume(double &volume, bool isCacheBypassed = false);
     bool getCachedVolume(double &volume);
     void setMute(bool mute, int32_t sourceId);
-    bool getMute(int sourceId);
+    bool getMute(int sourceId, bool isCacheBypassed = false);
     void setTextTrackIdentifier(const std::string &textTrackIdentifier);
     std::string getTextTrackIdentifier();
     bool setLowLatency(bool lowLatency);
     bool setSync(bool sync);
-    bool getSync(bool &sync);
+    bool getSync(bool &sync, bool isCacheBypassed = false);
     bool setSyncOff(bool syncOff);
     bool setStreamSyncMode(int32_t sourceId, int32_t streamSyncMode);
-    bool getStreamSyncMode(int32_t &streamSyncMode);
+    bool getStreamSyncMode(int32_t &streamSyncMode, bool isCacheBypassed = false);
     ClientState getClientState();
     void handleStreamCollection(int32_t audioStreams, int32_t videoStreams, int32_t subtitleStreams);
     void setBufferingLimit(uint32_t limitBufferingMs);
-    uint32_t getBufferingLimit();
+    uint32_t getBufferingLimit(bool isCacheBypassed = false);
     void setUseBuffering(bool useBuffering);
-    bool getUseBuffering();
+    bool getUseBuffering(bool isCacheBypassed = false);
     bool switchSource(const std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> &source);
     IFlushAndDataSynchronizer &getFlushAndDataSynchronizer();
 
 private:
     bool areAllStreamsAttached();
     void sendAllSourcesAttachedIfPossibleInternal();
+    void handleDeferredNeedDataInternal();
     bool checkIfAllAttachedSourcesInStates(const std::vector<ClientState> &states);
+    std::shared_ptr<firebolt::rialto::client::MediaPlayerClientBackendInterface> getClientBackend();
+    void sendPlayCommand();
+    void sendPauseCommand();
 
     std::unique_ptr<IMessageQueue> m_backendQueue;
     std::shared_ptr<IMessageQueueFactory> m_messageQueueFactory;
     std::shared_ptr<firebolt::rialto::client::MediaPlayerClientBackendInterface> m_clientBackend;
+    // Other users of m_clientBackend run in the backend or puller queues, which are stopped before it is destroyed.
+    // attachSource runs on a streaming thread and stop may be scheduled around teardown, so they use getClientBackend.
+    std::mutex m_clientBackendMutex;
     int64_t m_position;
-    int64_t m_duration;
+    // Duration is published by server notifications, so that duration queries don't need IPC
+    std::atomic<int64_t> m_duration;
     std::mutex m_playbackInfoMutex;
     std::unordered_map<int32_t, AttachedSource> m_attachedSources;
+    // Sources attached on the server, but not registered in m_attachedSources yet. Server may already request data
+    // for them, such need data is deferred until the registration.
+    std::atomic<uint32_t> m_attachmentsInProgress{0};
+    std::vector<std::shared_ptr<NeedDataMessage>> m_deferredNeedData;
     bool m_wasAllSourcesAttachedSent = false;
     int32_t m_audioStreams;
     int32_t m_videoStreams;
     int32_t m_subtitleStreams;
     firebolt::rialto::PlaybackInfo m_playbackInfo{-1, 1.0};
+    PlaybackPositionTracker m_positionTracker;
+    std::atomic<double> m_playbackRate{1.0};
     FlushAndDataSynchronizer m_flushAndDataSynchronizer;
     bool wasPlayingBeforeEos{false};
 
@@ -373,4 +455,36 @@ private:
     const uint32_t m_maxWidth;
     const uint32_t m_maxHeight;
     const bool m_isLive;
+
+    // Property values last read from or written to the server, so that getters don't block on the backend queue.
+    // Only volume (invalidated by fades) and stats are refreshed in background. The other values are updated only
+    // by this client, so they are stale if the server changes them on its own. Per-source values are dropped on reset.
+    struct PropertyCache
+    {
+        std::optional<double> volume;
+        std::optional<bool> sync;
+        std::optional<int32_t> streamSyncMode;
+        std::optional<uint32_t> bufferingLimit;
+        std::optional<bool> useBuffering;
+        std::unordered_map<int32_t, std::optional<bool>> mute;
+        std::unordered_map<int32_t, std::optional<bool>> immediateOutput;
+        std::unordered_map<int32_t, std::optional<std::pair<uint64_t, uint64_t>>> stats;
+    };
+    // Cache entry is accessed through cacheEntry under m_propertyCacheMutex. Values with non-empty refreshKey are
+    // returned from the cache and refreshed in background. The value is always read from the server, and the cache
+    // updated with it, when isCacheBypassed is set.
+    template <typename T>
+    bool getProperty(const std::function<std::optional<T> &(PropertyCache &)> &cacheEntry, T &value,
+                     const std::function<bool(T &)> &backendGetter, bool isCacheBypassed,
+                     const std::string &refreshKey = {});
+
+    std::mutex m_propertyCacheMutex;
+    PropertyCache m_propertyCache;
+    std::unordered_set<std::string> m_scheduledPropertyRefreshes;
+    // When enabled by RIALTO_SINKS_FRESH_PROPERTIES, getters of all clients always read the value from the server
+    const bool m_isFreshPropertyReadEnabled;
+    // Interval of data request stats bus messages, zero when they are not posted
+    const std::chrono::milliseconds m_dataRequestStatsInterval;
+    // Set when the session is recorded for offline replay
+    const std::unique_ptr<SessionRecorder> m_sessionRecorder;
 };
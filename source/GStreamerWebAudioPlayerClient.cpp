@@ -18,6 +18,8 @@
 
 #include "GStreamerWebAudioPlayerClient.h"
 #include "GstreamerCatLog.h"
+#include "RialtoGStreamerTracer.h"
+#include "TraceWriter.h"
 
 #include <string.h>
 
@@ -353,11 +355,17 @@ void GStreamerWebAudioPlayerClient::pushSamples()
                 }
                 else
                 {
+                    const GstClockTime kStartTime{RialtoTracing::isEnabled() ? gst_util_get_timestamp() : 0};
                     if (!m_clientBackend->writeBuffer(framesToWrite, bufferMap.data))
                     {
                         GST_ERROR("Could not map audio buffer, discarding buffer!");
                         writeFailure = true;
                     }
+                    if (RialtoTracing::isEnabled())
+                    {
+                        RialtoTracing::webAudioWritten(framesToWrite, gst_util_get_timestamp() - kStartTime,
+                                                       !writeFailure);
+                    }
                     gst_buffer_unmap(buffer, &bufferMap);
                 }
             }
@@ -428,6 +436,10 @@ bool GStreamerWebAudioPlayerClient::isNewConfig(const std::string &audioMimeType
 
 void GStreamerWebAudioPlayerClient::notifyState(firebolt::rialto::WebAudioPlayerState state)
 {
+    if (TraceWriter *traceWriter = TraceWriter::instance())
+    {
+        traceWriter->addInstant("state", "web audio player state", "state", static_cast<int64_t>(state));
+    }
     switch (state)
     {
     case firebolt::rialto::WebAudioPlayerState::END_OF_STREAM:
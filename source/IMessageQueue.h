@@ -20,6 +20,8 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <typeinfo>
 
 class Message
 {
@@ -27,6 +29,8 @@ public:
     virtual ~Message() {}
     virtual void handle() = 0;
     virtual void skip() {};
+    // Type under which the handler time is accounted in the queue stats
+    virtual const std::type_info &getHandlerType() const { return typeid(*this); }
 };
 
 class IMessageQueue
@@ -41,6 +45,10 @@ public:
     virtual void processMessages() = 0;
     virtual bool scheduleInEventLoop(const std::function<void()> &func) = 0;
     virtual bool callInEventLoop(const std::function<void()> &func) = 0;
+    // Priority variants are handled before any regular message waiting in the queue, in the order they were posted
+    virtual bool postMessageWithPriority(const std::shared_ptr<Message> &msg) = 0;
+    virtual bool scheduleInEventLoopWithPriority(const std::function<void()> &func) = 0;
+    virtual bool callInEventLoopWithPriority(const std::function<void()> &func) = 0;
 };
 
 class IMessageQueueFactory
@@ -49,4 +57,9 @@ public:
     virtual ~IMessageQueueFactory() = default;
     static std::shared_ptr<IMessageQueueFactory> createFactory();
     virtual std::unique_ptr<IMessageQueue> createMessageQueue() const = 0;
+    // The name identifies the queue in the queue stats
+    virtual std::unique_ptr<IMessageQueue> createMessageQueue(const std::string &name) const
+    {
+        return createMessageQueue();
+    }
 };
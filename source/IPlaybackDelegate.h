@@ -36,6 +36,7 @@ public:
         Stats,
         EnableLastSample,
         LastSample,
+        FreshProperties,
 
         // PullModeAudioPlaybackDelegate Properties
         Volume,
@@ -60,6 +61,7 @@ public:
         SyncmodeStreaming,
         ShowVideoWindow,
         VideoPts,
+        TrickPlayKeyframeRate,
 
         // PullModeSubtitlePlaybackDelegate Properties
         TextTrackIdentifier,
@@ -33,7 +33,10 @@ public:
 
     virtual void setSourceId(int32_t sourceId) = 0;
     virtual void handleFlushCompleted() = 0;
-    virtual GstRefSample getFrontSample() const = 0;
+    // Sample index counts all samples queued by the sink, so it identifies a sample also across flushes
+    virtual GstRefSample getFrontSample(uint64_t &sampleIndex) const = 0;
+    // Returns the queued sample at the given position, also when the server is flushing
+    virtual GstRefSample getSample(size_t position, uint64_t &sampleIndex) const = 0;
     virtual void popSample() = 0;
     virtual bool isEos() const = 0;
     virtual void lostState() = 0;
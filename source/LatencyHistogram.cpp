@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+
+namespace
+{
+void addUint64Array(GstStructure *structure, const char *name, const uint64_t *values, size_t size)
+{
+    GValue array = G_VALUE_INIT;
+    g_value_init(&array, GST_TYPE_ARRAY);
+    for (size_t i = 0; i < size; ++i)
+    {
+        GValue value = G_VALUE_INIT;
+        g_value_init(&value, G_TYPE_UINT64);
+        g_value_set_uint64(&value, values[i]);
+        gst_value_array_append_and_take_value(&array, &value);
+    }
+    gst_structure_take_value(structure, name, &array);
+}
+} // namespace
+
+void LatencyHistogram::add(std::chrono::steady_clock::duration duration)
+{
+    const uint64_t kDurationUs(
+        std::max<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count(), 0));
+    const auto kBucketIt{std::lower_bound(kBucketBoundsUs.begin(), kBucketBoundsUs.end(), kDurationUs)};
+    ++m_buckets[kBucketIt - kBucketBoundsUs.begin()];
+    ++m_count;
+    m_sumUs += kDurationUs;
+    m_maxUs = std::max(m_maxUs, kDurationUs);
+}
+
+void LatencyHistogram::addToStructure(GstStructure *structure, const char *name) const
+{
+    GstStructure *histogramStructure{gst_structure_new(name, "count", G_TYPE_UINT64, m_count, "sum-us", G_TYPE_UINT64,
+                                                       m_sumUs, "max-us", G_TYPE_UINT64, m_maxUs, nullptr)};
+    addUint64Array(histogramStructure, "bucket-bounds-us", kBucketBoundsUs.data(), kBucketBoundsUs.size());
+    addUint64Array(histogramStructure, "buckets", m_buckets.data(), m_buckets.size());
+
+    GValue value = G_VALUE_INIT;
+    g_value_init(&value, GST_TYPE_STRUCTURE);
+    g_value_take_boxed(&value, histogramStructure);
+    gst_structure_take_value(structure, name, &value);
+}
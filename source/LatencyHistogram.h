@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef LATENCY_HISTOGRAM_H_
+#define LATENCY_HISTOGRAM_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <gst/gst.h>
+
+// Durations counted in fixed buckets, from a hundred microseconds to a quarter of a second
+class LatencyHistogram
+{
+public:
+    static constexpr std::array<uint64_t, 11> kBucketBoundsUs{100,   250,   500,   1000,   2500,  5000,
+                                                              10000, 25000, 50000, 100000, 250000};
+    // Last bucket counts durations above the last bound
+    using Buckets = std::array<uint64_t, kBucketBoundsUs.size() + 1>;
+
+    void add(std::chrono::steady_clock::duration duration);
+    uint64_t getCount() const { return m_count; }
+    uint64_t getSumUs() const { return m_sumUs; }
+    uint64_t getMaxUs() const { return m_maxUs; }
+    uint64_t getMeanUs() const { return m_count ? m_sumUs / m_count : 0; }
+    const Buckets &getBuckets() const { return m_buckets; }
+
+    // Adds the histogram to a structure as a nested structure with the given name
+    void addToStructure(GstStructure *structure, const char *name) const;
+
+private:
+    uint64_t m_count{0};
+    uint64_t m_sumUs{0};
+    uint64_t m_maxUs{0};
+    Buckets m_buckets{};
+};
+
+#endif // LATENCY_HISTOGRAM_H_
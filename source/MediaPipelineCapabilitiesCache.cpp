@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "MediaPipelineCapabilitiesCache.h"
+#include "GstreamerCatLog.h"
+
+#include <cstdlib>
+
+#define GST_CAT_DEFAULT rialtoGStreamerCat
+
+namespace
+{
+constexpr int kCacheVersion{1};
+constexpr const char *kCacheGroup{"cache"};
+constexpr const char *kVersionKey{"version"};
+constexpr const char *kServerKey{"key"};
+constexpr const char *kMimeTypesKey{"mime-types"};
+constexpr const char *kQueriedPropertiesKey{"queried-properties"};
+constexpr const char *kSupportedPropertiesKey{"supported-properties"};
+
+const char *toGroupName(firebolt::rialto::MediaSourceType sourceType)
+{
+    switch (sourceType)
+    {
+    case firebolt::rialto::MediaSourceType::AUDIO:
+        return "AUDIO";
+    case firebolt::rialto::MediaSourceType::VIDEO:
+        return "VIDEO";
+    case firebolt::rialto::MediaSourceType::SUBTITLE:
+        return "SUBTITLE";
+    case firebolt::rialto::MediaSourceType::UNKNOWN:
+        return "UNKNOWN";
+    }
+    return "UNKNOWN";
+}
+
+MediaPipelineCapabilitiesCache *getCache()
+{
+    // Never destroyed, so that exit doesn't wait for a revalidation stuck in IPC
+    static MediaPipelineCapabilitiesCache *cache{
+        []() -> MediaPipelineCapabilitiesCache *
+        {
+            const char *pathStr = getenv("RIALTO_SINKS_CAPABILITIES_CACHE");
+            if (!pathStr || *pathStr == '\0')
+            {
+                return nullptr;
+            }
+            // Capabilities depend on the server the process talks to and on the build of the sinks querying them.
+            // Server upgrades are detected by revalidation, which invalidates the whole cache on any mismatch.
+            const char *socketPathStr = getenv("RIALTO_SOCKET_PATH");
+            const std::string kKey{std::string{socketPathStr ? socketPathStr : ""} + ";" + VERSION + ";" + SRCREV};
+            return new MediaPipelineCapabilitiesCache{IMessageQueueFactory::createFactory(), pathStr, kKey};
+        }()};
+    return cache;
+}
+
+std::unique_ptr<firebolt::rialto::IMediaPipelineCapabilities> createServerCapabilities()
+{
+    return firebolt::rialto::IMediaPipelineCapabilitiesFactory::createFactory()->createMediaPipelineCapabilities();
+}
+
+class CachedMediaPipelineCapabilities : public firebolt::rialto::IMediaPipelineCapabilities
+{
+public:
+    explicit CachedMediaPipelineCapabilities(MediaPipelineCapabilitiesCache &cache) : m_cache{cache} {}
+
+    std::vector<std::string> getSupportedMimeTypes(firebolt::rialto::MediaSourceType sourceType) override
+    {
+        return m_cache.getSupportedMimeTypes(sourceType);
+    }
+
+    bool isMimeTypeSupported(const std::string &mimeType) override
+    {
+        return getServerCapabilities() && m_serverCapabilities->isMimeTypeSupported(mimeType);
+    }
+
+    std::vector<std::string> getSupportedProperties(firebolt::rialto::MediaSourceType mediaType,
+                                                    const std::vector<std::string> &propertyNames) override
+    {
+        return m_cache.getSupportedProperties(mediaType, propertyNames);
+    }
+
+    bool isVideoMaster(bool &isVideoMaster) override
+    {
+        return getServerCapabilities() && m_serverCapabilities->isVideoMaster(isVideoMaster);
+    }
+
+private:
+    bool getServerCapabilities()
+    {
+        if (!m_serverCapabilities)
+        {
+            m_serverCapabilities = createServerCapabilities();
+        }
+        return m_serverCapabilities != nullptr;
+    }
+
+    MediaPipelineCapabilitiesCache &m_cache;
+    std::unique_ptr<firebolt::rialto::IMediaPipelineCapabilities> m_serverCapabilities;
+};
+} // namespace
+
+std::unique_ptr<firebolt::rialto::IMediaPipelineCapabilities>
+MediaPipelineCapabilitiesCache::createMediaPipelineCapabilities()
+{
+    MediaPipelineCapabilitiesCache *cache{getCache()};
+    if (!cache)
+    {
+        return createServerCapabilities();
+    }
+    return std::make_unique<CachedMediaPipelineCapabilities>(*cache);
+}
+
+MediaPipelineCapabilitiesCache::MediaPipelineCapabilitiesCache(
+    const std::shared_ptr<IMessageQueueFactory> &messageQueueFactory, const std::string &path, const std::string &key)
+    : m_messageQueueFactory{messageQueueFactory}, m_path{path}, m_key{key}, m_keyFile{g_key_file_new()}
+{
+    load();
+}
+
+MediaPipelineCapabilitiesCache::~MediaPipelineCapabilitiesCache()
+{
+    if (m_revalidationQueue)
+    {
+        m_revalidationQueue->stop();
+    }
+    g_key_file_free(m_keyFile);
+}
+
+std::vector<std::string>
+MediaPipelineCapabilitiesCache::getSupportedMimeTypes(firebolt::rialto::MediaSourceType sourceType)
+{
+    std::vector<std::string> mimeTypes;
+    if (getCachedList(toGroupName(sourceType), kMimeTypesKey, mimeTypes))
+    {
+        revalidate(sourceType, {}, true);
+        return mimeTypes;
+    }
+    return queryServerAndStore(sourceType, {}, true);
+}
+
+std::vector<std::string>
+MediaPipelineCapabilitiesCache::getSupportedProperties(firebolt::rialto::MediaSourceType mediaType,
+                                                       const std::vector<std::string> &propertyNames)
+{
+    std::vector<std::string> queriedProperties;
+    std::vector<std::string> supportedProperties;
+    if (getCachedList(toGroupName(mediaType), kQueriedPropertiesKey, queriedProperties) &&
+        queriedProperties == propertyNames &&
+        getCachedList(toGroupName(mediaType), kSupportedPropertiesKey, supportedProperties))
+    {
+        revalidate(mediaType, propertyNames, false);
+        return supportedProperties;
+    }
+    return queryServerAndStore(mediaType, propertyNames, false);
+}
+
+bool MediaPipelineCapabilitiesCache::getCachedList(const char *group, const char *key, std::vector<std::string> &values)
+{
+    std::unique_lock lock{m_mutex};
+    gsize length{0};
+    gchar **list{g_key_file_get_string_list(m_keyFile, group, key, &length, nullptr)};
+    if (!list)
+    {
+        return false;
+    }
+    values.assign(list, list + length);
+    g_strfreev(list);
+    return true;
+}
+
+void MediaPipelineCapabilitiesCache::setCachedList(const char *group, const char *key,
+                                                   const std::vector<std::string> &values)
+{
+    std::vector<const gchar *> list;
+    for (const auto &value : values)
+    {
+        list.push_back(value.c_str());
+    }
+    g_key_file_set_string_list(m_keyFile, group, key, list.data(), list.size());
+}
+
+std::vector<std::string>
+MediaPipelineCapabilitiesCache::queryServerAndStore(firebolt::rialto::MediaSourceType sourceType,
+                                                    const std::vector<std::string> &propertyNames, bool isMimeTypeQuery)
+{
+    std::unique_ptr<firebolt::rialto::IMediaPipelineCapabilities> capabilities{createServerCapabilities()};
+    if (!capabilities)
+    {
+        GST_ERROR("Failed to create media pipeline capabilities");
+        return {};
+    }
+    const char *group{toGroupName(sourceType)};
+    const char *valuesKey{isMimeTypeQuery ? kMimeTypesKey : kSupportedPropertiesKey};
+    const std::vector<std::string> kValues{isMimeTypeQuery
+                                               ? capabilities->getSupportedMimeTypes(sourceType)
+                                               : capabilities->getSupportedProperties(sourceType, propertyNames)};
+    // Empty mime type list most likely means that the server is not reachable, don't cache it
+    if (isMimeTypeQuery && kValues.empty())
+    {
+        return kValues;
+    }
+    std::vector<std::string> cachedValues;
+    std::vector<std::string> cachedPropertyNames;
+    const bool kIsCached{getCachedList(group, valuesKey, cachedValues) &&
+                         (isMimeTypeQuery || (getCachedList(group, kQueriedPropertiesKey, cachedPropertyNames) &&
+                                              cachedPropertyNames == propertyNames))};
+    if (kIsCached && cachedValues == kValues)
+    {
+        return kValues;
+    }
+
+    std::unique_lock lock{m_mutex};
+    if (kIsCached)
+    {
+        // Server has changed, none of the other cached answers can be trusted either
+        GST_INFO("Cached %s capabilities are outdated, invalidating the capabilities cache", group);
+        g_key_file_free(m_keyFile);
+        m_keyFile = g_key_file_new();
+    }
+    GST_INFO("Storing %s capabilities in cache", group);
+    if (!isMimeTypeQuery)
+    {
+        setCachedList(group, kQueriedPropertiesKey, propertyNames);
+    }
+    setCachedList(group, valuesKey, kValues);
+    save();
+    return kValues;
+}
+
+void MediaPipelineCapabilitiesCache::revalidate(firebolt::rialto::MediaSourceType sourceType,
+                                                const std::vector<std::string> &propertyNames, bool isMimeTypeQuery)
+{
+    {
+        std::unique_lock lock{m_mutex};
+        if (!m_revalidationQueue)
+        {
+            m_revalidationQueue = m_messageQueueFactory->createMessageQueue("capabilities-revalidation");
+            m_revalidationQueue->start();
+        }
+    }
+    m_revalidationQueue->scheduleInEventLoop([this, sourceType, propertyNames, isMimeTypeQuery]()
+                                             { queryServerAndStore(sourceType, propertyNames, isMimeTypeQuery); });
+}
+
+void MediaPipelineCapabilitiesCache::load()
+{
+    GError *error{nullptr};
+    GMappedFile *file{g_mapped_file_new(m_path.c_str(), FALSE, &error)};
+    if (!file)
+    {
+        GST_INFO("No capabilities cache at %s: %s", m_path.c_str(), error->message);
+        g_error_free(error);
+        return;
+    }
+    bool isValid = g_key_file_load_from_data(m_keyFile, g_mapped_file_get_contents(file),
+                                             g_mapped_file_get_length(file), G_KEY_FILE_NONE, nullptr);
+    g_mapped_file_unref(file);
+    if (isValid)
+    {
+        gchar *key{g_key_file_get_string(m_keyFile, kCacheGroup, kServerKey, nullptr)};
+        isValid = g_key_file_get_integer(m_keyFile, kCacheGroup, kVersionKey, nullptr) == kCacheVersion && key &&
+                  m_key == key;
+        g_free(key);
+    }
+    if (!isValid)
+    {
+        GST_INFO("Discarding outdated capabilities cache at %s", m_path.c_str());
+        g_key_file_free(m_keyFile);
+        m_keyFile = g_key_file_new();
+    }
+}
+
+void MediaPipelineCapabilitiesCache::save()
+{
+    g_key_file_set_integer(m_keyFile, kCacheGroup, kVersionKey, kCacheVersion);
+    g_key_file_set_string(m_keyFile, kCacheGroup, kServerKey, m_key.c_str());
+    GError *error{nullptr};
+    // Contents are written to a temporary file and renamed, so readers never see a partially written cache
+    if (!g_key_file_save_to_file(m_keyFile, m_path.c_str(), &error))
+    {
+        GST_WARNING("Failed to write capabilities cache to %s: %s", m_path.c_str(), error->message);
+        g_error_free(error);
+    }
+}
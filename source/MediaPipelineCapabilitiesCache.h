@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef MEDIA_PIPELINE_CAPABILITIES_CACHE_H_
+#define MEDIA_PIPELINE_CAPABILITIES_CACHE_H_
+
+#include "IMediaPipelineCapabilities.h"
+#include "IMessageQueue.h"
+#include <glib.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Persistent cache of the server capabilities queried in plugin class init, so that processes registering the
+// plugin don't need IPC on their startup path. Enabled by setting RIALTO_SINKS_CAPABILITIES_CACHE to the cache file
+// path. Cached answers are served immediately and revalidated against the server in the background; a changed answer
+// invalidates the whole cache, so that the server is queried directly from then on.
+class MediaPipelineCapabilitiesCache
+{
+public:
+    static std::unique_ptr<firebolt::rialto::IMediaPipelineCapabilities> createMediaPipelineCapabilities();
+
+    MediaPipelineCapabilitiesCache(const std::shared_ptr<IMessageQueueFactory> &messageQueueFactory,
+                                   const std::string &path, const std::string &key);
+    ~MediaPipelineCapabilitiesCache();
+
+    std::vector<std::string> getSupportedMimeTypes(firebolt::rialto::MediaSourceType sourceType);
+    std::vector<std::string> getSupportedProperties(firebolt::rialto::MediaSourceType mediaType,
+                                                    const std::vector<std::string> &propertyNames);
+
+private:
+    bool getCachedList(const char *group, const char *key, std::vector<std::string> &values);
+    void setCachedList(const char *group, const char *key, const std::vector<std::string> &values);
+    std::vector<std::string> queryServerAndStore(firebolt::rialto::MediaSourceType sourceType,
+                                                 const std::vector<std::string> &propertyNames, bool isMimeTypeQuery);
+    void revalidate(firebolt::rialto::MediaSourceType sourceType, const std::vector<std::string> &propertyNames,
+                    bool isMimeTypeQuery);
+    void load();
+    void save();
+
+    const std::shared_ptr<IMessageQueueFactory> m_messageQueueFactory;
+    const std::string m_path;
+    const std::string m_key;
+    std::mutex m_mutex;
+    GKeyFile *m_keyFile;
+    std::unique_ptr<IMessageQueue> m_revalidationQueue;
+};
+
+#endif // MEDIA_PIPELINE_CAPABILITIES_CACHE_H_
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "MediaPlayerClientBackendInterface.h"
+#include "TraceWriter.h"
 #include <IMediaPipeline.h>
 #include <gst/gst.h>
 #include <memory>
@@ -37,6 +38,7 @@ public:
         videoRequirements.maxWidth = maxWidth;
         videoRequirements.maxHeight = maxHeight;
 
+        TraceSpan span{"ipc", "MediaPipelineFactory::createMediaPipeline"};
         m_mediaPlayerBackend =
             firebolt::rialto::IMediaPipelineFactory::createFactory()->createMediaPipeline(client, videoRequirements);
 
@@ -51,28 +53,56 @@ public:
 
     bool attachSource(std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> &source) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::attachSource"};
         return m_mediaPlayerBackend->attachSource(source);
     }
 
-    bool removeSource(int32_t id) override { return m_mediaPlayerBackend->removeSource(id); }
+    bool removeSource(int32_t id) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::removeSource"};
+        return m_mediaPlayerBackend->removeSource(id);
+    }
 
-    bool allSourcesAttached() override { return m_mediaPlayerBackend->allSourcesAttached(); }
+    bool allSourcesAttached() override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::allSourcesAttached"};
+        return m_mediaPlayerBackend->allSourcesAttached();
+    }
 
     bool load(firebolt::rialto::MediaType type, const std::string &mimeType, const std::string &url, bool isLive) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::load"};
         return m_mediaPlayerBackend->load(type, mimeType, url, isLive);
     }
 
-    bool play(bool &async) override { return m_mediaPlayerBackend->play(async); }
-    bool pause() override { return m_mediaPlayerBackend->pause(); }
-    bool stop() override { return m_mediaPlayerBackend->stop(); }
+    bool play(bool &async) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::play"};
+        return m_mediaPlayerBackend->play(async);
+    }
+    bool pause() override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::pause"};
+        return m_mediaPlayerBackend->pause();
+    }
+    bool stop() override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::stop"};
+        return m_mediaPlayerBackend->stop();
+    }
     bool haveData(firebolt::rialto::MediaSourceStatus status, unsigned int needDataRequestId) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::haveData"};
         return m_mediaPlayerBackend->haveData(status, needDataRequestId);
     }
-    bool setPlaybackRate(double rate) override { return m_mediaPlayerBackend->setPlaybackRate(rate); }
+    bool setPlaybackRate(double rate) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::setPlaybackRate"};
+        return m_mediaPlayerBackend->setPlaybackRate(rate);
+    }
     bool setVideoWindow(unsigned int x, unsigned int y, unsigned int width, unsigned int height) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::setVideoWindow"};
         return m_mediaPlayerBackend->setVideoWindow(x, y, width, height);
     }
 
@@ -80,106 +110,170 @@ public:
     addSegment(unsigned int needDataRequestId,
                const std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> &mediaSegment) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::addSegment"};
         return m_mediaPlayerBackend->addSegment(needDataRequestId, mediaSegment);
     }
 
-    bool getPosition(int64_t &position) override { return m_mediaPlayerBackend->getPosition(position); }
+    bool getPosition(int64_t &position) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::getPosition"};
+        return m_mediaPlayerBackend->getPosition(position);
+    }
 
-    bool getDuration(int64_t &duration) override { return m_mediaPlayerBackend->getDuration(duration); }
+    bool getDuration(int64_t &duration) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::getDuration"};
+        return m_mediaPlayerBackend->getDuration(duration);
+    }
 
     bool setImmediateOutput(int32_t sourceId, bool immediateOutput) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::setImmediateOutput"};
         return m_mediaPlayerBackend->setImmediateOutput(sourceId, immediateOutput);
     }
 
     bool getImmediateOutput(int32_t sourceId, bool &immediateOutput) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::getImmediateOutput"};
         return m_mediaPlayerBackend->getImmediateOutput(sourceId, immediateOutput);
     }
 
     bool getStats(int32_t sourceId, uint64_t &renderedFrames, uint64_t &droppedFrames) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::getStats"};
         return m_mediaPlayerBackend->getStats(sourceId, renderedFrames, droppedFrames);
     }
 
-    bool renderFrame() override { return m_mediaPlayerBackend->renderFrame(); }
+    bool renderFrame() override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::renderFrame"};
+        return m_mediaPlayerBackend->renderFrame();
+    }
 
     bool setVolume(double targetVolume, uint32_t volumeDuration, EaseType easeType) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::setVolume"};
         return m_mediaPlayerBackend->setVolume(targetVolume, volumeDuration, easeType);
     }
 
-    bool getVolume(double &currentVolume) override { return m_mediaPlayerBackend->getVolume(currentVolume); }
+    bool getVolume(double &currentVolume) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::getVolume"};
+        return m_mediaPlayerBackend->getVolume(currentVolume);
+    }
 
-    bool setMute(bool mute, int sourceId) override { return m_mediaPlayerBackend->setMute(sourceId, mute); }
+    bool setMute(bool mute, int sourceId) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::setMute"};
+        return m_mediaPlayerBackend->setMute(sourceId, mute);
+    }
 
-    bool getMute(bool &mute, int sourceId) override { return m_mediaPlayerBackend->getMute(sourceId, mute); }
+    bool getMute(bool &mute, int sourceId) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::getMute"};
+        return m_mediaPlayerBackend->getMute(sourceId, mute);
+    }
 
     bool setTextTrackIdentifier(const std::string &textTrackIdentifier) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::setTextTrackIdentifier"};
         return m_mediaPlayerBackend->setTextTrackIdentifier(textTrackIdentifier);
     }
 
     bool getTextTrackIdentifier(std::string &textTrackIdentifier) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::getTextTrackIdentifier"};
         return m_mediaPlayerBackend->getTextTrackIdentifier(textTrackIdentifier);
     }
 
-    bool setLowLatency(bool lowLatency) override { return m_mediaPlayerBackend->setLowLatency(lowLatency); }
+    bool setLowLatency(bool lowLatency) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::setLowLatency"};
+        return m_mediaPlayerBackend->setLowLatency(lowLatency);
+    }
 
-    bool setSync(bool sync) override { return m_mediaPlayerBackend->setSync(sync); }
+    bool setSync(bool sync) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::setSync"};
+        return m_mediaPlayerBackend->setSync(sync);
+    }
 
-    bool getSync(bool &sync) override { return m_mediaPlayerBackend->getSync(sync); }
+    bool getSync(bool &sync) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::getSync"};
+        return m_mediaPlayerBackend->getSync(sync);
+    }
 
-    bool setSyncOff(bool syncOff) override { return m_mediaPlayerBackend->setSyncOff(syncOff); }
+    bool setSyncOff(bool syncOff) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::setSyncOff"};
+        return m_mediaPlayerBackend->setSyncOff(syncOff);
+    }
 
     bool setStreamSyncMode(int32_t sourceId, int32_t streamSyncMode) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::setStreamSyncMode"};
         return m_mediaPlayerBackend->setStreamSyncMode(sourceId, streamSyncMode);
     }
 
     bool getStreamSyncMode(int32_t &streamSyncMode) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::getStreamSyncMode"};
         return m_mediaPlayerBackend->getStreamSyncMode(streamSyncMode);
     }
 
     bool flush(int32_t sourceId, bool resetTime, bool &async) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::flush"};
         return m_mediaPlayerBackend->flush(sourceId, resetTime, async);
     }
 
     bool setSourcePosition(int32_t sourceId, int64_t position, bool resetTime, double appliedRate = 1.0,
                            uint64_t stopPosition = GST_CLOCK_TIME_NONE) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::setSourcePosition"};
         return m_mediaPlayerBackend->setSourcePosition(sourceId, position, resetTime, appliedRate, stopPosition);
     }
 
     bool setSubtitleOffset(int32_t sourceId, int64_t position) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::setSubtitleOffset"};
         return m_mediaPlayerBackend->setSubtitleOffset(sourceId, position);
     }
 
     bool processAudioGap(int64_t position, uint32_t duration, int64_t discontinuityGap, bool audioAac) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::processAudioGap"};
         return m_mediaPlayerBackend->processAudioGap(position, duration, discontinuityGap, audioAac);
     }
 
     bool setBufferingLimit(uint32_t limitBufferingMs) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::setBufferingLimit"};
         return m_mediaPlayerBackend->setBufferingLimit(limitBufferingMs);
     }
 
     bool getBufferingLimit(uint32_t &limitBufferingMs) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::getBufferingLimit"};
         return m_mediaPlayerBackend->getBufferingLimit(limitBufferingMs);
     }
 
-    bool setUseBuffering(bool useBuffering) override { return m_mediaPlayerBackend->setUseBuffering(useBuffering); }
+    bool setUseBuffering(bool useBuffering) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::setUseBuffering"};
+        return m_mediaPlayerBackend->setUseBuffering(useBuffering);
+    }
 
-    bool getUseBuffering(bool &useBuffering) override { return m_mediaPlayerBackend->getUseBuffering(useBuffering); }
+    bool getUseBuffering(bool &useBuffering) override
+    {
+        TraceSpan span{"ipc", "MediaPipeline::getUseBuffering"};
+        return m_mediaPlayerBackend->getUseBuffering(useBuffering);
+    }
 
     bool switchSource(const std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> &source) override
     {
+        TraceSpan span{"ipc", "MediaPipeline::switchSource"};
         return m_mediaPlayerBackend->switchSource(source);
     }
 
@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "MediaPlayerClientPool.h"
+#include "GstreamerCatLog.h"
+#include "MediaPlayerClientBackend.h"
+
+#include <cerrno>
+#include <cstdlib>
+
+#define GST_CAT_DEFAULT rialtoGStreamerCat
+
+namespace
+{
+size_t getPoolSize()
+{
+    const char *poolSizeStr = getenv("RIALTO_SINKS_PREWARMED_SESSIONS");
+    if (!poolSizeStr)
+    {
+        return 0;
+    }
+    char *end;
+    errno = 0;
+    unsigned long val = strtoul(poolSizeStr, &end, 10);
+    if (*end != '\0' || errno == ERANGE)
+    {
+        GST_WARNING("Failed to parse 'RIALTO_SINKS_PREWARMED_SESSIONS' env variable - '%s'", poolSizeStr);
+        return 0;
+    }
+    return val;
+}
+} // namespace
+
+MediaPlayerClientPool &MediaPlayerClientPool::instance()
+{
+    // Never destroyed, so that pooled clients are not torn down by a static destructor while the process exits
+    static MediaPlayerClientPool *pool{new MediaPlayerClientPool{IMessageQueueFactory::createFactory(), getPoolSize()}};
+    return *pool;
+}
+
+std::shared_ptr<GStreamerMSEMediaPlayerClient> MediaPlayerClientPool::createClient(uint32_t maxVideoWidth,
+                                                                                   uint32_t maxVideoHeight, bool isLive)
+{
+    std::shared_ptr<firebolt::rialto::client::MediaPlayerClientBackendInterface> clientBackend =
+        std::make_shared<firebolt::rialto::client::MediaPlayerClientBackend>();
+    std::shared_ptr<GStreamerMSEMediaPlayerClient> client =
+        std::make_shared<GStreamerMSEMediaPlayerClient>(IMessageQueueFactory::createFactory(), clientBackend,
+                                                        maxVideoWidth, maxVideoHeight, isLive);
+    if (!client->createBackend())
+    {
+        return nullptr;
+    }
+    return client;
+}
+
+MediaPlayerClientPool::MediaPlayerClientPool(const std::shared_ptr<IMessageQueueFactory> &messageQueueFactory,
+                                             size_t size)
+    : m_messageQueueFactory{messageQueueFactory}, m_size{size}
+{
+    if (m_size > 0)
+    {
+        GST_INFO("Pre-warming up to %zu media player clients", m_size);
+        m_refillQueue = m_messageQueueFactory->createMessageQueue("client-pool-refill");
+        m_refillQueue->start();
+    }
+}
+
+MediaPlayerClientPool::~MediaPlayerClientPool()
+{
+    shutdown();
+}
+
+std::shared_ptr<GStreamerMSEMediaPlayerClient> MediaPlayerClientPool::claim(uint32_t maxVideoWidth,
+                                                                            uint32_t maxVideoHeight, bool isLive)
+{
+    std::shared_ptr<GStreamerMSEMediaPlayerClient> client;
+    std::deque<std::shared_ptr<GStreamerMSEMediaPlayerClient>> unhealthyClients;
+    while (!client)
+    {
+        {
+            std::unique_lock lock{m_mutex};
+            if (m_clients.empty() || !(m_config == Config{maxVideoWidth, maxVideoHeight, isLive}))
+            {
+                break;
+            }
+            client = m_clients.front();
+            m_clients.pop_front();
+            GST_INFO("Claimed pre-warmed media player client, %zu left in the pool", m_clients.size());
+        }
+        // Session of a pooled client may have failed on the server while it was waiting in the pool
+        if (!client->isHealthy())
+        {
+            GST_WARNING("Discarding unhealthy pre-warmed media player client");
+            unhealthyClients.push_back(std::move(client));
+        }
+    }
+    if (!unhealthyClients.empty() &&
+        scheduleInRefillQueue([unhealthyClients]() mutable { release(unhealthyClients); }))
+    {
+        unhealthyClients.clear();
+    }
+    release(unhealthyClients);
+    return client;
+}
+
+void MediaPlayerClientPool::refill(uint32_t maxVideoWidth, uint32_t maxVideoHeight, bool isLive)
+{
+    const Config kConfig{maxVideoWidth, maxVideoHeight, isLive};
+    std::deque<std::shared_ptr<GStreamerMSEMediaPlayerClient>> staleClients;
+    {
+        std::unique_lock lock{m_mutex};
+        if (m_size == 0)
+        {
+            return;
+        }
+        if (!(m_config == kConfig))
+        {
+            // Pooled sessions were created for different video requirements and can't be reused
+            staleClients.swap(m_clients);
+            m_config = kConfig;
+        }
+    }
+    if (scheduleInRefillQueue(
+            [this, kConfig, staleClients]() mutable
+            {
+                release(staleClients);
+                fill(kConfig);
+            }))
+    {
+        staleClients.clear();
+    }
+    release(staleClients);
+}
+
+void MediaPlayerClientPool::prime()
+{
+    Config config{0, 0, false};
+    {
+        std::unique_lock lock{m_mutex};
+        if (m_size == 0)
+        {
+            return;
+        }
+        config = m_config;
+    }
+    scheduleInRefillQueue([this, config]() { fill(config); });
+}
+
+void MediaPlayerClientPool::setSize(size_t size)
+{
+    if (size == 0)
+    {
+        shutdown();
+        return;
+    }
+    {
+        std::unique_lock lock{m_refillQueueMutex};
+        if (!m_refillQueue)
+        {
+            m_refillQueue = m_messageQueueFactory->createMessageQueue("client-pool-refill");
+            m_refillQueue->start();
+        }
+    }
+    std::deque<std::shared_ptr<GStreamerMSEMediaPlayerClient>> excessClients;
+    {
+        std::unique_lock lock{m_mutex};
+        GST_INFO("Pre-warming up to %zu media player clients", size);
+        m_size = size;
+        while (m_clients.size() > m_size)
+        {
+            excessClients.push_back(m_clients.back());
+            m_clients.pop_back();
+        }
+    }
+    release(excessClients);
+    prime();
+}
+
+size_t MediaPlayerClientPool::getSize()
+{
+    std::unique_lock lock{m_mutex};
+    return m_size;
+}
+
+void MediaPlayerClientPool::clear()
+{
+    std::deque<std::shared_ptr<GStreamerMSEMediaPlayerClient>> clients;
+    {
+        std::unique_lock lock{m_mutex};
+        clients.swap(m_clients);
+    }
+    release(clients);
+}
+
+void MediaPlayerClientPool::shutdown()
+{
+    {
+        std::unique_lock lock{m_mutex};
+        m_size = 0;
+    }
+    std::unique_ptr<IMessageQueue> refillQueue;
+    {
+        std::unique_lock lock{m_refillQueueMutex};
+        refillQueue = std::move(m_refillQueue);
+    }
+    if (refillQueue)
+    {
+        refillQueue->stop();
+    }
+    clear();
+}
+
+bool MediaPlayerClientPool::scheduleInRefillQueue(const std::function<void()> &task)
+{
+    std::unique_lock lock{m_refillQueueMutex};
+    if (!m_refillQueue)
+    {
+        return false;
+    }
+    return m_refillQueue->scheduleInEventLoop(task);
+}
+
+void MediaPlayerClientPool::fill(const Config &config)
+{
+    while (true)
+    {
+        {
+            std::unique_lock lock{m_mutex};
+            if (!(m_config == config) || m_clients.size() >= m_size)
+            {
+                return;
+            }
+        }
+        std::shared_ptr<GStreamerMSEMediaPlayerClient> client{
+            createClient(config.maxVideoWidth, config.maxVideoHeight, config.isLive)};
+        if (!client)
+        {
+            GST_WARNING("Failed to pre-warm media player client");
+            return;
+        }
+        std::deque<std::shared_ptr<GStreamerMSEMediaPlayerClient>> staleClients{client};
+        {
+            std::unique_lock lock{m_mutex};
+            if (m_config == config && m_clients.size() < m_size)
+            {
+                m_clients.push_back(client);
+                staleClients.clear();
+            }
+        }
+        release(staleClients);
+    }
+}
+
+void MediaPlayerClientPool::release(std::deque<std::shared_ptr<GStreamerMSEMediaPlayerClient>> &clients)
+{
+    for (auto &client : clients)
+    {
+        client->stopStreaming();
+        client->destroyClientBackend();
+    }
+    clients.clear();
+}
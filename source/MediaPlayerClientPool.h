@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef MEDIA_PLAYER_CLIENT_POOL_H_
+#define MEDIA_PLAYER_CLIENT_POOL_H_
+
+#include "GStreamerMSEMediaPlayerClient.h"
+#include "IMessageQueue.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+// Keeps a number of media player clients with a created and loaded MediaPipeline, so that a new playback can skip
+// the pipeline setup on its critical path. Pooled clients are created for the video requirements of the last
+// playback and refilled in the background whenever one is claimed.
+// Pooled clients hold server sessions, so the pool has to be torn down with shutdown() (or setSize(0)) rather than at
+// process exit.
+class MediaPlayerClientPool
+{
+public:
+    static MediaPlayerClientPool &instance();
+    static std::shared_ptr<GStreamerMSEMediaPlayerClient> createClient(uint32_t maxVideoWidth, uint32_t maxVideoHeight,
+                                                                       bool isLive);
+
+    MediaPlayerClientPool(const std::shared_ptr<IMessageQueueFactory> &messageQueueFactory, size_t size);
+    ~MediaPlayerClientPool();
+
+    std::shared_ptr<GStreamerMSEMediaPlayerClient> claim(uint32_t maxVideoWidth, uint32_t maxVideoHeight, bool isLive);
+    void refill(uint32_t maxVideoWidth, uint32_t maxVideoHeight, bool isLive);
+    // Fills the pool for the video requirements of the last playback, so that the first playback can use it too
+    void prime();
+    // Changes the number of pooled clients, 0 releases all of them
+    void setSize(size_t size);
+    size_t getSize();
+    // Releases pooled clients, e.g. when their sessions are no longer valid on the server
+    void clear();
+    // Releases pooled clients and stops refilling the pool
+    void shutdown();
+
+private:
+    struct Config
+    {
+        uint32_t maxVideoWidth;
+        uint32_t maxVideoHeight;
+        bool isLive;
+
+        bool operator==(const Config &other) const
+        {
+            return maxVideoWidth == other.maxVideoWidth && maxVideoHeight == other.maxVideoHeight &&
+                   isLive == other.isLive;
+        }
+    };
+
+    void fill(const Config &config);
+    bool scheduleInRefillQueue(const std::function<void()> &task);
+    static void release(std::deque<std::shared_ptr<GStreamerMSEMediaPlayerClient>> &clients);
+
+    std::shared_ptr<IMessageQueueFactory> m_messageQueueFactory;
+    // Guards the lifetime of the refill queue only, so that tasks run synchronously by it may take m_mutex
+    std::mutex m_refillQueueMutex;
+    std::unique_ptr<IMessageQueue> m_refillQueue;
+    std::mutex m_mutex;
+    size_t m_size;
+    Config m_config{0, 0, false};
+    std::deque<std::shared_ptr<GStreamerMSEMediaPlayerClient>> m_clients;
+};
+
+#endif // MEDIA_PLAYER_CLIENT_POOL_H_
@@ -18,12 +18,36 @@
 
 #include "MediaPlayerManager.h"
 #include "GstreamerCatLog.h"
-#include "IMessageQueue.h"
-#include "MediaPlayerClientBackend.h"
+#include "MediaPlayerClientPool.h"
+
+#include <cerrno>
+#include <cstdlib>
 
 std::mutex MediaPlayerManager::m_mediaPlayerClientsMutex;
 std::map<const GstObject *, MediaPlayerManager::MediaPlayerClientInfo> MediaPlayerManager::m_mediaPlayerClientsInfo;
+MediaPlayerManager::ParkedMediaPlayerClient MediaPlayerManager::m_parkedClient{nullptr, 0, 0, false, 0, nullptr};
 #define GST_CAT_DEFAULT rialtoGStreamerCat
+
+namespace
+{
+std::chrono::milliseconds getHandoverGracePeriod()
+{
+    const char *gracePeriodStr = getenv("RIALTO_SINKS_SESSION_HANDOVER_MS");
+    if (!gracePeriodStr)
+    {
+        return std::chrono::milliseconds{0};
+    }
+    char *end;
+    errno = 0;
+    unsigned long val = strtoul(gracePeriodStr, &end, 10);
+    if (*end != '\0' || errno == ERANGE)
+    {
+        GST_WARNING("Failed to parse 'RIALTO_SINKS_SESSION_HANDOVER_MS' env variable - '%s'", gracePeriodStr);
+        return std::chrono::milliseconds{0};
+    }
+    return std::chrono::milliseconds{val};
+}
+} // namespace
 MediaPlayerManager::MediaPlayerManager() : m_currentGstBinParent(nullptr) {}
 
 MediaPlayerManager::~MediaPlayerManager()
@@ -109,30 +133,46 @@ void MediaPlayerManager::releaseMediaPlayerClient()
 {
     if (m_client.lock())
     {
-        std::lock_guard<std::mutex> guard(m_mediaPlayerClientsMutex);
-
-        auto it = m_mediaPlayerClientsInfo.find(m_currentGstBinParent);
-        if (it != m_mediaPlayerClientsInfo.end())
+        // Stopping, resetting and destroying the client are server IPCs, so they are done after the mutex is released
+        MediaPlayerClientInfo releasedClientInfo{};
         {
-            it->second.refCount--;
-            if (it->second.refCount == 0)
+            std::lock_guard<std::mutex> guard(m_mediaPlayerClientsMutex);
+
+            auto it = m_mediaPlayerClientsInfo.find(m_currentGstBinParent);
+            if (it != m_mediaPlayerClientsInfo.end())
             {
-                it->second.client->stop();
-                it->second.client->stopStreaming();
-                it->second.client->destroyClientBackend();
-                m_mediaPlayerClientsInfo.erase(it);
+                it->second.refCount--;
+                if (it->second.refCount == 0)
+                {
+                    releasedClientInfo = it->second;
+                    m_mediaPlayerClientsInfo.erase(it);
+                }
+                else
+                {
+                    if (it->second.controller == this)
+                        it->second.controller = nullptr;
+                }
+                m_client.reset();
+                m_currentGstBinParent = nullptr;
             }
             else
             {
-                if (it->second.controller == this)
-                    it->second.controller = nullptr;
+                GST_ERROR("Could not find the attached media player client");
             }
-            m_client.reset();
-            m_currentGstBinParent = nullptr;
         }
-        else
+
+        if (releasedClientInfo.client)
         {
-            GST_ERROR("Could not find the attached media player client");
+            const std::chrono::milliseconds kGracePeriod{getHandoverGracePeriod()};
+            releasedClientInfo.client->stop();
+            if (kGracePeriod.count() > 0)
+            {
+                parkClient(releasedClientInfo, kGracePeriod);
+            }
+            else
+            {
+                destroyClient(releasedClientInfo.client);
+            }
         }
     }
 }
@@ -151,6 +191,7 @@ bool MediaPlayerManager::acquireControl(MediaPlayerClientInfo &mediaPlayerClient
 void MediaPlayerManager::createMediaPlayerClient(const GstObject *gstBinParent, const uint32_t maxVideoWidth,
                                                  const uint32_t maxVideoHeight, bool isLive)
 {
+    std::unique_ptr<ITimer> expiryTimer;
     std::lock_guard<std::mutex> guard(m_mediaPlayerClientsMutex);
 
     auto it = m_mediaPlayerClientsInfo.find(gstBinParent);
@@ -162,19 +203,29 @@ void MediaPlayerManager::createMediaPlayerClient(const GstObject *gstBinParent,
     }
     else
     {
-        std::shared_ptr<firebolt::rialto::client::MediaPlayerClientBackendInterface> clientBackend =
-            std::make_shared<firebolt::rialto::client::MediaPlayerClientBackend>();
-        std::shared_ptr<GStreamerMSEMediaPlayerClient> client =
-            std::make_shared<GStreamerMSEMediaPlayerClient>(IMessageQueueFactory::createFactory(), clientBackend,
-                                                            maxVideoWidth, maxVideoHeight, isLive);
+        MediaPlayerClientPool &pool{MediaPlayerClientPool::instance()};
+        std::shared_ptr<GStreamerMSEMediaPlayerClient> client{
+            adoptParkedClientUnlocked(maxVideoWidth, maxVideoHeight, isLive, expiryTimer)};
+        if (!client)
+        {
+            client = pool.claim(maxVideoWidth, maxVideoHeight, isLive);
+        }
+        if (!client)
+        {
+            client = MediaPlayerClientPool::createClient(maxVideoWidth, maxVideoHeight, isLive);
+        }
+        pool.refill(maxVideoWidth, maxVideoHeight, isLive);
 
-        if (client->createBackend())
+        if (client)
         {
             // Store the new client in global map
             MediaPlayerClientInfo newClientInfo;
             newClientInfo.client = client;
             newClientInfo.controller = this;
             newClientInfo.refCount = 1;
+            newClientInfo.maxVideoWidth = maxVideoWidth;
+            newClientInfo.maxVideoHeight = maxVideoHeight;
+            newClientInfo.isLive = isLive;
             m_mediaPlayerClientsInfo.insert(
                 std::pair<const GstObject *, MediaPlayerClientInfo>(gstBinParent, newClientInfo));
 
@@ -189,3 +240,95 @@ void MediaPlayerManager::createMediaPlayerClient(const GstObject *gstBinParent,
         }
     }
 }
+
+std::shared_ptr<GStreamerMSEMediaPlayerClient>
+MediaPlayerManager::adoptParkedClientUnlocked(const uint32_t maxVideoWidth, const uint32_t maxVideoHeight, bool isLive,
+                                              std::unique_ptr<ITimer> &expiryTimer)
+{
+    if (!m_parkedClient.client || m_parkedClient.maxVideoWidth != maxVideoWidth ||
+        m_parkedClient.maxVideoHeight != maxVideoHeight || m_parkedClient.isLive != isLive)
+    {
+        return nullptr;
+    }
+    GST_INFO("Adopting parked media player client");
+    expiryTimer = std::move(m_parkedClient.expiryTimer);
+    return std::move(m_parkedClient.client);
+}
+
+void MediaPlayerManager::parkClient(const MediaPlayerClientInfo &mediaPlayerClientInfo,
+                                    const std::chrono::milliseconds &gracePeriod)
+{
+    if (!mediaPlayerClientInfo.client->reset())
+    {
+        GST_WARNING("Could not reset media player client, it will not be handed over");
+        destroyClient(mediaPlayerClientInfo.client);
+        return;
+    }
+
+    // Previously parked client and its timer are destroyed after the mutex is released, as the timer callback takes it
+    std::shared_ptr<GStreamerMSEMediaPlayerClient> previousClient;
+    std::unique_ptr<ITimer> previousExpiryTimer;
+    {
+        std::lock_guard<std::mutex> guard(m_mediaPlayerClientsMutex);
+        GST_INFO("Parking media player client for %lld ms", static_cast<long long>(gracePeriod.count()));
+        const uint64_t kGeneration{++m_parkedClient.generation};
+        previousClient = std::move(m_parkedClient.client);
+        previousExpiryTimer = std::move(m_parkedClient.expiryTimer);
+        m_parkedClient.client = mediaPlayerClientInfo.client;
+        m_parkedClient.maxVideoWidth = mediaPlayerClientInfo.maxVideoWidth;
+        m_parkedClient.maxVideoHeight = mediaPlayerClientInfo.maxVideoHeight;
+        m_parkedClient.isLive = mediaPlayerClientInfo.isLive;
+        m_parkedClient.expiryTimer =
+            ITimerFactory::getFactory()->createTimer(gracePeriod,
+                                                     [kGeneration]() { expireParkedClient(kGeneration); });
+    }
+    if (previousExpiryTimer)
+    {
+        previousExpiryTimer->cancel();
+    }
+    if (previousClient)
+    {
+        destroyClient(previousClient);
+    }
+}
+
+void MediaPlayerManager::expireParkedClient(uint64_t generation)
+{
+    std::shared_ptr<GStreamerMSEMediaPlayerClient> client;
+    {
+        std::lock_guard<std::mutex> guard(m_mediaPlayerClientsMutex);
+        if (m_parkedClient.generation != generation || !m_parkedClient.client)
+        {
+            return;
+        }
+        client = std::move(m_parkedClient.client);
+    }
+    GST_INFO("Handover grace period expired, destroying parked media player client");
+    destroyClient(client);
+}
+
+void MediaPlayerManager::destroyParkedClient()
+{
+    std::shared_ptr<GStreamerMSEMediaPlayerClient> client;
+    std::unique_ptr<ITimer> expiryTimer;
+    {
+        std::lock_guard<std::mutex> guard(m_mediaPlayerClientsMutex);
+        client = std::move(m_parkedClient.client);
+        expiryTimer = std::move(m_parkedClient.expiryTimer);
+        ++m_parkedClient.generation;
+    }
+    if (expiryTimer)
+    {
+        expiryTimer->cancel();
+    }
+    if (client)
+    {
+        destroyClient(client);
+    }
+}
+
+void MediaPlayerManager::destroyClient(const std::shared_ptr<GStreamerMSEMediaPlayerClient> &client)
+{
+    client->stopStreaming();
+    client->destroyClientBackend();
+}
@@ -20,6 +20,7 @@
 #define MEDIAPLAYERMANAGER_H
 
 #include "GStreamerMSEMediaPlayerClient.h"
+#include "ITimer.h"
 #include <map>
 
 class MediaPlayerManager
@@ -33,6 +34,8 @@ public:
                                  const uint32_t maxVideoHeight = 0, bool isLive = false);
     void releaseMediaPlayerClient();
     bool hasControl();
+    // Destroys the client waiting for handover to the next bin, if there is one
+    static void destroyParkedClient();
 
 private:
     struct MediaPlayerClientInfo
@@ -40,17 +43,40 @@ private:
         std::shared_ptr<GStreamerMSEMediaPlayerClient> client;
         void *controller;
         uint32_t refCount;
+        uint32_t maxVideoWidth;
+        uint32_t maxVideoHeight;
+        bool isLive;
+    };
+
+    // Client released by its last bin, kept for a grace period so that the next bin with the same video
+    // requirements can take over its MediaPipeline instead of creating a new one.
+    struct ParkedMediaPlayerClient
+    {
+        std::shared_ptr<GStreamerMSEMediaPlayerClient> client;
+        uint32_t maxVideoWidth;
+        uint32_t maxVideoHeight;
+        bool isLive;
+        uint64_t generation;
+        std::unique_ptr<ITimer> expiryTimer;
     };
 
     void createMediaPlayerClient(const GstObject *gstBinParent, const uint32_t maxVideoWidth,
                                  const uint32_t maxVideoHeight, bool isLive);
     bool acquireControl(MediaPlayerClientInfo &mediaPlayerClientInfo);
+    std::shared_ptr<GStreamerMSEMediaPlayerClient> adoptParkedClientUnlocked(const uint32_t maxVideoWidth,
+                                                                             const uint32_t maxVideoHeight, bool isLive,
+                                                                             std::unique_ptr<ITimer> &expiryTimer);
+    static void parkClient(const MediaPlayerClientInfo &mediaPlayerClientInfo,
+                           const std::chrono::milliseconds &gracePeriod);
+    static void expireParkedClient(uint64_t generation);
+    static void destroyClient(const std::shared_ptr<GStreamerMSEMediaPlayerClient> &client);
 
     std::weak_ptr<GStreamerMSEMediaPlayerClient> m_client;
     const GstObject *m_currentGstBinParent;
 
     static std::mutex m_mediaPlayerClientsMutex;
     static std::map<const GstObject *, MediaPlayerClientInfo> m_mediaPlayerClientsInfo;
+    static ParkedMediaPlayerClient m_parkedClient;
 };
 
 #endif // MEDIAPLAYERMANAGER_H
\ No newline at end of file
@@ -59,9 +59,18 @@ std::unique_ptr<IMessageQueue> MessageQueueFactory::createMessageQueue() const
     return std::make_unique<rialto::MessageQueue>();
 }
 
+std::unique_ptr<IMessageQueue> MessageQueueFactory::createMessageQueue(const std::string &name) const
+{
+    return std::make_unique<rialto::MessageQueue>(name);
+}
+
 namespace rialto
 {
-MessageQueue::MessageQueue() : m_running(false), m_acceptingMessages{false} {}
+MessageQueue::MessageQueue(const std::string &name)
+    : m_running(false), m_acceptingMessages{false}, m_name{name}, m_stats{MessageQueueStats::create(name)},
+      m_traceWriter{TraceWriter::instance()}
+{
+}
 
 MessageQueue::~MessageQueue()
 {
@@ -94,16 +103,32 @@ void MessageQueue::clear()
 std::shared_ptr<Message> MessageQueue::waitForMessage()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
-    while (m_queue.empty())
+    while (m_queue.empty() && m_priorityQueue.empty())
     {
         m_condVar.wait(lock);
     }
-    std::shared_ptr<Message> message = m_queue.front();
-    m_queue.pop_front();
-    return message;
+    auto &queue = m_priorityQueue.empty() ? m_queue : m_priorityQueue;
+    QueuedMessage queuedMessage = std::move(queue.front());
+    queue.pop_front();
+    if (m_stats)
+    {
+        m_stats->onDequeued(m_queue.size() + m_priorityQueue.size(),
+                            std::chrono::steady_clock::now() - queuedMessage.postTime);
+    }
+    return queuedMessage.message;
 }
 
 bool MessageQueue::postMessage(const std::shared_ptr<Message> &msg)
+{
+    return postMessageInternal(msg, false);
+}
+
+bool MessageQueue::postMessageWithPriority(const std::shared_ptr<Message> &msg)
+{
+    return postMessageInternal(msg, true);
+}
+
+bool MessageQueue::postMessageInternal(const std::shared_ptr<Message> &msg, bool isHighPriority)
 {
     const std::lock_guard<std::mutex> lock(m_mutex);
     if (!m_running || !m_acceptingMessages)
@@ -111,7 +136,23 @@ bool MessageQueue::postMessage(const std::shared_ptr<Message> &msg)
         GST_ERROR("Message queue is not running or not accepting messages");
         return false;
     }
-    m_queue.push_back(msg);
+    QueuedMessage queuedMessage{msg, {}};
+    if (m_stats)
+    {
+        queuedMessage.postTime = std::chrono::steady_clock::now();
+    }
+    if (isHighPriority)
+    {
+        m_priorityQueue.push_back(std::move(queuedMessage));
+    }
+    else
+    {
+        m_queue.push_back(std::move(queuedMessage));
+    }
+    if (m_stats)
+    {
+        m_stats->onPosted(m_queue.size() + m_priorityQueue.size());
+    }
     m_condVar.notify_all();
 
     return true;
@@ -119,10 +160,31 @@ bool MessageQueue::postMessage(const std::shared_ptr<Message> &msg)
 
 void MessageQueue::processMessages()
 {
+    if (m_traceWriter)
+    {
+        m_traceWriter->setThreadName(m_name);
+    }
     do
     {
         std::shared_ptr<Message> message = waitForMessage();
-        message->handle();
+        if (m_stats || m_traceWriter)
+        {
+            const auto kStart{std::chrono::steady_clock::now()};
+            message->handle();
+            const auto kEnd{std::chrono::steady_clock::now()};
+            if (m_stats)
+            {
+                m_stats->onHandled(message->getHandlerType(), kEnd - kStart);
+            }
+            if (m_traceWriter)
+            {
+                m_traceWriter->addSpan("queue", message->getHandlerType(), kStart, kEnd);
+            }
+        }
+        else
+        {
+            message->handle();
+        }
     } while (m_running);
 }
 
@@ -142,15 +204,26 @@ bool MessageQueue::callInEventLoop(const std::function<void()> &func)
     return callInEventLoopInternal(func);
 }
 
-bool MessageQueue::callInEventLoopInternal(const std::function<void()> &func)
+bool MessageQueue::scheduleInEventLoopWithPriority(const std::function<void()> &func)
+{
+    return postMessageInternal(std::make_shared<ScheduleInEventLoopMessage>(func), true);
+}
+
+bool MessageQueue::callInEventLoopWithPriority(const std::function<void()> &func)
+{
+    return callInEventLoopInternal(func, true);
+}
+
+bool MessageQueue::callInEventLoopInternal(const std::function<void()> &func, bool isHighPriority)
 {
     if (std::this_thread::get_id() != m_workerThread.get_id())
     {
         auto message = std::make_shared<CallInEventLoopMessage>(func);
-        if (!postMessage(message))
+        if (!postMessageInternal(message, isHighPriority))
         {
             return false;
         }
+        TraceSpan span{"queue", "callInEventLoop wait"};
         message->wait();
     }
     else
@@ -180,7 +253,11 @@ void MessageQueue::doStop()
         {
             const std::lock_guard<std::mutex> lock(m_mutex);
             m_acceptingMessages = false;
-            m_queue.push_back(message);
+            m_queue.push_back(QueuedMessage{message, std::chrono::steady_clock::now()});
+            if (m_stats)
+            {
+                m_stats->onPosted(m_queue.size() + m_priorityQueue.size());
+            }
             m_condVar.notify_all();
         }
         message->wait();
@@ -195,10 +272,13 @@ void MessageQueue::doStop()
 void MessageQueue::doClear()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
-    while (!m_queue.empty())
+    for (auto *queue : {&m_priorityQueue, &m_queue})
     {
-        m_queue.front()->skip();
-        m_queue.pop_front();
+        while (!queue->empty())
+        {
+            queue->front().message->skip();
+            queue->pop_front();
+        }
     }
 }
 } // namespace rialto
@@ -19,13 +19,17 @@
 #pragma once
 
 #include "IMessageQueue.h"
+#include "MessageQueueStats.h"
+#include "TraceWriter.h"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
 #include <gst/gst.h>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 
 class CallInEventLoopMessage : public Message
@@ -35,6 +39,7 @@ public:
     void handle() override;
     void wait();
     void skip() override;
+    const std::type_info &getHandlerType() const override { return m_func.target_type(); }
 
 private:
     const std::function<void()> m_func;
@@ -48,6 +53,7 @@ class ScheduleInEventLoopMessage : public Message
 public:
     explicit ScheduleInEventLoopMessage(const std::function<void()> &func);
     void handle() override;
+    const std::type_info &getHandlerType() const override { return m_func.target_type(); }
 
 private:
     const std::function<void()> m_func;
@@ -57,13 +63,14 @@ class MessageQueueFactory : public IMessageQueueFactory
 {
 public:
     std::unique_ptr<IMessageQueue> createMessageQueue() const override;
+    std::unique_ptr<IMessageQueue> createMessageQueue(const std::string &name) const override;
 };
 namespace rialto
 {
 class MessageQueue : public IMessageQueue
 {
 public:
-    MessageQueue();
+    explicit MessageQueue(const std::string &name = "unnamed");
     ~MessageQueue();
 
     void start() override;
@@ -76,19 +83,34 @@ public:
     void processMessages() override;
     bool scheduleInEventLoop(const std::function<void()> &func) override;
     bool callInEventLoop(const std::function<void()> &func) override;
+    bool postMessageWithPriority(const std::shared_ptr<Message> &msg) override;
+    bool scheduleInEventLoopWithPriority(const std::function<void()> &func) override;
+    bool callInEventLoopWithPriority(const std::function<void()> &func) override;
 
 protected:
     void doStop();
     void doClear();
     // We need to have a non-virtual method, which can be called in class destructor
-    bool callInEventLoopInternal(const std::function<void()> &func);
+    bool callInEventLoopInternal(const std::function<void()> &func, bool isHighPriority = false);
+    bool postMessageInternal(const std::shared_ptr<Message> &msg, bool isHighPriority);
 
 protected:
+    struct QueuedMessage
+    {
+        std::shared_ptr<Message> message;
+        // Set only when queue stats are enabled
+        std::chrono::steady_clock::time_point postTime;
+    };
+
     std::condition_variable m_condVar;
     std::mutex m_mutex;
-    std::deque<std::shared_ptr<Message>> m_queue;
+    std::deque<QueuedMessage> m_queue;
+    std::deque<QueuedMessage> m_priorityQueue;
     std::thread m_workerThread;
     std::atomic_bool m_running;
     std::atomic_bool m_acceptingMessages;
+    const std::string m_name;
+    const std::shared_ptr<MessageQueueStats> m_stats;
+    TraceWriter *const m_traceWriter;
 };
 } // namespace rialto
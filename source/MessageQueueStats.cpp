@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "MessageQueueStats.h"
+#include "GstreamerCatLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <thread>
+#include <unistd.h>
+
+#define GST_CAT_DEFAULT rialtoGStreamerCat
+
+namespace
+{
+constexpr size_t kMaxDumpedHandlers{10};
+
+std::mutex gRegistryMutex;
+std::vector<std::weak_ptr<MessageQueueStats>> gRegistry;
+uint32_t gQueueCounter{0};
+int gDumpPipe[2]{-1, -1};
+
+bool isEnabled()
+{
+    const char *kValue{getenv("RIALTO_SINKS_QUEUE_STATS")};
+    return kValue && std::string{kValue} == "1";
+}
+
+std::string demangle(const char *name)
+{
+    int status{0};
+    char *demangled{abi::__cxa_demangle(name, nullptr, nullptr, &status)};
+    if (status != 0 || !demangled)
+    {
+        return name;
+    }
+    std::string result{demangled};
+    free(demangled);
+    return result;
+}
+
+void onDumpSignal(int)
+{
+    // Only async-signal-safe calls here, the dump itself is done by the dump thread
+    const int kSavedErrno{errno};
+    const char kByte{0};
+    const ssize_t kWritten{write(gDumpPipe[1], &kByte, 1)};
+    (void)kWritten;
+    errno = kSavedErrno;
+}
+
+void dumpOnSignals()
+{
+    char byte{0};
+    while (true)
+    {
+        const ssize_t kRead{read(gDumpPipe[0], &byte, 1)};
+        if (kRead < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (kRead != 1)
+        {
+            break;
+        }
+        for (const auto &line : MessageQueueStats::dumpAll())
+        {
+            GST_WARNING("%s", line.c_str());
+        }
+    }
+}
+
+void installDumpTrigger()
+{
+    struct sigaction currentAction{};
+    if (sigaction(SIGUSR2, nullptr, &currentAction) != 0 || currentAction.sa_handler != SIG_DFL)
+    {
+        GST_WARNING("SIGUSR2 is already handled, message queue stats will not be dumped on signal");
+        return;
+    }
+    if (pipe(gDumpPipe) != 0)
+    {
+        GST_ERROR("Failed to create message queue stats dump pipe: %s", strerror(errno));
+        return;
+    }
+    std::thread{dumpOnSignals}.detach();
+
+    struct sigaction action{};
+    action.sa_handler = onDumpSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGUSR2, &action, nullptr);
+    GST_INFO("Message queue stats enabled, send SIGUSR2 to dump them");
+}
+} // namespace
+
+std::shared_ptr<MessageQueueStats> MessageQueueStats::create(const std::string &queueName)
+{
+    if (!isEnabled())
+    {
+        return nullptr;
+    }
+    static std::once_flag installFlag;
+    std::call_once(installFlag, installDumpTrigger);
+
+    std::unique_lock<std::mutex> lock{gRegistryMutex};
+    auto stats{std::make_shared<MessageQueueStats>(queueName + "#" + std::to_string(++gQueueCounter))};
+    gRegistry.erase(std::remove_if(gRegistry.begin(), gRegistry.end(),
+                                   [](const std::weak_ptr<MessageQueueStats> &entry) { return entry.expired(); }),
+                    gRegistry.end());
+    gRegistry.push_back(stats);
+    return stats;
+}
+
+std::vector<MessageQueueStats::Snapshot> MessageQueueStats::getAllSnapshots()
+{
+    std::vector<std::shared_ptr<MessageQueueStats>> liveStats;
+    {
+        std::unique_lock<std::mutex> lock{gRegistryMutex};
+        for (const auto &entry : gRegistry)
+        {
+            if (auto stats = entry.lock())
+            {
+                liveStats.push_back(stats);
+            }
+        }
+    }
+    std::vector<Snapshot> snapshots;
+    for (const auto &stats : liveStats)
+    {
+        snapshots.push_back(stats->getSnapshot());
+    }
+    return snapshots;
+}
+
+std::vector<std::string> MessageQueueStats::dumpAll()
+{
+    std::vector<std::string> lines;
+    for (const auto &snapshot : getAllSnapshots())
+    {
+        const auto kQueueLines{dump(snapshot)};
+        lines.insert(lines.end(), kQueueLines.begin(), kQueueLines.end());
+    }
+    return lines;
+}
+
+std::vector<std::string> MessageQueueStats::dump(const Snapshot &snapshot)
+{
+    std::vector<std::string> lines;
+    lines.push_back("queue " + snapshot.queueName + ": depth " + std::to_string(snapshot.depth) + " (max " +
+                    std::to_string(snapshot.maxDepth) + "), posted " + std::to_string(snapshot.postedCount) +
+                    ", wait mean " + std::to_string(snapshot.wait.getMeanUs()) + " us max " +
+                    std::to_string(snapshot.wait.getMaxUs()) + " us");
+    for (size_t i = 0; i < snapshot.handlers.size() && i < kMaxDumpedHandlers; ++i)
+    {
+        const auto &kHandler{snapshot.handlers[i]};
+        lines.push_back("  " + kHandler.name + ": " + std::to_string(kHandler.duration.getCount()) + " calls, total " +
+                        std::to_string(kHandler.duration.getSumUs()) + " us, mean " +
+                        std::to_string(kHandler.duration.getMeanUs()) + " us, max " +
+                        std::to_string(kHandler.duration.getMaxUs()) + " us");
+    }
+    return lines;
+}
+
+std::string MessageQueueStats::getHandlerName(const std::type_info &handlerType)
+{
+    return demangle(handlerType.name());
+}
+
+MessageQueueStats::MessageQueueStats(const std::string &queueName) : m_queueName{queueName} {}
+
+void MessageQueueStats::onPosted(size_t depth)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    ++m_postedCount;
+    m_depth = depth;
+    m_maxDepth = std::max(m_maxDepth, depth);
+}
+
+void MessageQueueStats::onDequeued(size_t depth, Clock::duration waitTime)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_depth = depth;
+    m_wait.add(waitTime);
+}
+
+void MessageQueueStats::onHandled(const std::type_info &handlerType, Clock::duration duration)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_handlers[std::type_index{handlerType}].add(duration);
+}
+
+MessageQueueStats::Snapshot MessageQueueStats::getSnapshot() const
+{
+    Snapshot snapshot;
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        snapshot.queueName = m_queueName;
+        snapshot.depth = m_depth;
+        snapshot.maxDepth = m_maxDepth;
+        snapshot.postedCount = m_postedCount;
+        snapshot.wait = m_wait;
+        for (const auto &[type, duration] : m_handlers)
+        {
+            snapshot.handlers.push_back(HandlerStats{type.name(), duration});
+        }
+    }
+    // Demangling allocates, so it is done outside of the lock taken by the queue threads
+    for (auto &handler : snapshot.handlers)
+    {
+        handler.name = demangle(handler.name.c_str());
+    }
+    std::sort(snapshot.handlers.begin(), snapshot.handlers.end(),
+              [](const HandlerStats &lhs, const HandlerStats &rhs)
+              { return lhs.duration.getSumUs() > rhs.duration.getSumUs(); });
+    return snapshot;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef MESSAGE_QUEUE_STATS_H_
+#define MESSAGE_QUEUE_STATS_H_
+
+#include "LatencyHistogram.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+// Depth, wait time and handler time of a single message queue. Collected only when RIALTO_SINKS_QUEUE_STATS=1; all
+// live queues can then be queried with getAllSnapshots() or dumped to the log by sending SIGUSR2 to the process.
+class MessageQueueStats
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct HandlerStats
+    {
+        // Demangled message type or, for call and schedule in event loop, the type of the function called
+        std::string name;
+        LatencyHistogram duration;
+    };
+
+    struct Snapshot
+    {
+        std::string queueName;
+        size_t depth{0};
+        size_t maxDepth{0};
+        uint64_t postedCount{0};
+        // Time from posting to the worker thread picking the message up
+        LatencyHistogram wait;
+        // Sorted by the total time spent in the handler, longest first
+        std::vector<HandlerStats> handlers;
+    };
+
+    // Returns nullptr when queue stats are not enabled
+    static std::shared_ptr<MessageQueueStats> create(const std::string &queueName);
+    static std::vector<Snapshot> getAllSnapshots();
+    static std::vector<std::string> dumpAll();
+    static std::vector<std::string> dump(const Snapshot &snapshot);
+    static std::string getHandlerName(const std::type_info &handlerType);
+
+    explicit MessageQueueStats(const std::string &queueName);
+
+    void onPosted(size_t depth);
+    void onDequeued(size_t depth, Clock::duration waitTime);
+    void onHandled(const std::type_info &handlerType, Clock::duration duration);
+    Snapshot getSnapshot() const;
+
+private:
+    const std::string m_queueName;
+    mutable std::mutex m_mutex;
+    size_t m_depth{0};
+    size_t m_maxDepth{0};
+    uint64_t m_postedCount{0};
+    LatencyHistogram m_wait;
+    std::unordered_map<std::type_index, LatencyHistogram> m_handlers;
+};
+
+#endif // MESSAGE_QUEUE_STATS_H_
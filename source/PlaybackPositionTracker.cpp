@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "PlaybackPositionTracker.h"
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+// Server sends playback info a few times per second. If it stops doing so (underflow, stall), we should not run away
+// with the position, so extrapolation is limited to this interval after the last update.
+constexpr int64_t kMaxExtrapolationNs{1000000000};
+} // namespace
+
+int64_t PlaybackPositionTracker::monotonicTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void PlaybackPositionTracker::update(int64_t position, int64_t now)
+{
+    std::unique_lock lock{m_writeMutex};
+    Snapshot snapshot{read()};
+    snapshot.bound = snapshot.isSegmentStart ? -1 : currentPosition(snapshot, now);
+    snapshot.isSegmentStart = false;
+    snapshot.position = position;
+    snapshot.timestamp = now;
+    publish(snapshot);
+}
+
+void PlaybackPositionTracker::setPlaying(bool isPlaying, int64_t now)
+{
+    std::unique_lock lock{m_writeMutex};
+    Snapshot snapshot{read()};
+    if (snapshot.isPlaying == isPlaying)
+    {
+        return;
+    }
+    // Freeze at the extrapolated position when playback stops, so that position doesn't jump back on pause
+    snapshot.position = currentPosition(snapshot, now);
+    snapshot.timestamp = now;
+    snapshot.isPlaying = isPlaying;
+    publish(snapshot);
+}
+
+void PlaybackPositionTracker::setRate(double rate, int64_t now)
+{
+    std::unique_lock lock{m_writeMutex};
+    Snapshot snapshot{read()};
+    snapshot.position = currentPosition(snapshot, now);
+    snapshot.timestamp = now;
+    snapshot.rate = rate;
+    snapshot.bound = -1;
+    publish(snapshot);
+}
+
+void PlaybackPositionTracker::reset(int64_t position)
+{
+    std::unique_lock lock{m_writeMutex};
+    Snapshot snapshot{read()};
+    snapshot.position = position;
+    snapshot.timestamp = 0;
+    snapshot.isPlaying = false;
+    snapshot.bound = -1;
+    snapshot.isSegmentStart = true;
+    publish(snapshot);
+}
+
+void PlaybackPositionTracker::startSegment(int64_t now)
+{
+    std::unique_lock lock{m_writeMutex};
+    Snapshot snapshot{read()};
+    snapshot.position = currentPosition(snapshot, now);
+    snapshot.timestamp = now;
+    snapshot.isPlaying = false;
+    snapshot.bound = -1;
+    snapshot.isSegmentStart = true;
+    publish(snapshot);
+}
+
+int64_t PlaybackPositionTracker::getPosition(int64_t now) const
+{
+    return currentPosition(read(), now);
+}
+
+PlaybackPositionTracker::Snapshot PlaybackPositionTracker::read() const
+{
+    Snapshot snapshot{};
+    uint64_t sequenceBefore{0};
+    uint64_t sequenceAfter{0};
+    do
+    {
+        sequenceBefore = m_sequence.load(std::memory_order_acquire);
+        snapshot.position = m_position.load(std::memory_order_relaxed);
+        snapshot.rate = m_rate.load(std::memory_order_relaxed);
+        snapshot.timestamp = m_timestamp.load(std::memory_order_relaxed);
+        snapshot.isPlaying = m_isPlaying.load(std::memory_order_relaxed);
+        snapshot.bound = m_bound.load(std::memory_order_relaxed);
+        snapshot.isSegmentStart = m_isSegmentStart.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        sequenceAfter = m_sequence.load(std::memory_order_relaxed);
+    } while ((sequenceBefore & 1) || sequenceBefore != sequenceAfter);
+    return snapshot;
+}
+
+void PlaybackPositionTracker::publish(const Snapshot &snapshot)
+{
+    const uint64_t kSequence{m_sequence.load(std::memory_order_relaxed)};
+    m_sequence.store(kSequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_position.store(snapshot.position, std::memory_order_relaxed);
+    m_rate.store(snapshot.rate, std::memory_order_relaxed);
+    m_timestamp.store(snapshot.timestamp, std::memory_order_relaxed);
+    m_isPlaying.store(snapshot.isPlaying, std::memory_order_relaxed);
+    m_bound.store(snapshot.bound, std::memory_order_relaxed);
+    m_isSegmentStart.store(snapshot.isSegmentStart, std::memory_order_relaxed);
+    m_sequence.store(kSequence + 2, std::memory_order_release);
+}
+
+int64_t PlaybackPositionTracker::extrapolate(const Snapshot &snapshot, int64_t now)
+{
+    if (!snapshot.isPlaying || snapshot.position < 0)
+    {
+        return snapshot.position;
+    }
+    const int64_t kElapsed{std::clamp<int64_t>(now - snapshot.timestamp, 0, kMaxExtrapolationNs)};
+    return std::max<int64_t>(snapshot.position + static_cast<int64_t>(kElapsed * snapshot.rate), 0);
+}
+
+int64_t PlaybackPositionTracker::currentPosition(const Snapshot &snapshot, int64_t now)
+{
+    const int64_t kPosition{extrapolate(snapshot, now)};
+    if (snapshot.bound < 0)
+    {
+        return kPosition;
+    }
+    return snapshot.rate < 0 ? std::min(kPosition, snapshot.bound) : std::max(kPosition, snapshot.bound);
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef PLAYBACK_POSITION_TRACKER_H_
+#define PLAYBACK_POSITION_TRACKER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Publishes the last position reported by the server together with the moment it was received, so that position
+// queries can be served without locking and extrapolated between server updates while playing.
+// Within a segment the position never moves against the playback direction, even if a server update is behind the
+// extrapolated position.
+// Writers are serialised by a mutex, readers use a sequence counter and never block.
+class PlaybackPositionTracker
+{
+public:
+    static int64_t monotonicTime();
+
+    void update(int64_t position, int64_t now = monotonicTime());
+    void setPlaying(bool isPlaying, int64_t now = monotonicTime());
+    // Lets the position move in the new direction, the bound of the previous direction no longer applies
+    void setRate(double rate, int64_t now = monotonicTime());
+    void reset(int64_t position);
+    // Stops extrapolating until playback is resumed and lets the next position be anywhere relative to the current one
+    void startSegment(int64_t now = monotonicTime());
+    int64_t getPosition(int64_t now = monotonicTime()) const;
+
+private:
+    struct Snapshot
+    {
+        int64_t position;
+        double rate;
+        int64_t timestamp;
+        bool isPlaying;
+        // Furthest position in the playback direction which could have been returned in the current segment: the lowest
+        // allowed position when playing forwards, the highest one when playing backwards. -1 when there is none.
+        int64_t bound;
+        // Set until the first server update of the segment, which may be behind the frozen position
+        bool isSegmentStart;
+    };
+
+    Snapshot read() const;
+    void publish(const Snapshot &snapshot);
+    static int64_t extrapolate(const Snapshot &snapshot, int64_t now);
+    static int64_t currentPosition(const Snapshot &snapshot, int64_t now);
+
+    std::mutex m_writeMutex;
+    std::atomic<uint64_t> m_sequence{0};
+    std::atomic<int64_t> m_position{-1};
+    std::atomic<double> m_rate{1.0};
+    std::atomic<int64_t> m_timestamp{0};
+    std::atomic<bool> m_isPlaying{false};
+    std::atomic<int64_t> m_bound{-1};
+    std::atomic<bool> m_isSegmentStart{true};
+};
+
+#endif // PLAYBACK_POSITION_TRACKER_H_
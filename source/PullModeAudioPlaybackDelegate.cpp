@@ -207,6 +207,11 @@ gboolean PullModeAudioPlaybackDelegate::handleEvent(GstPad *pad, GstObject *pare
         }
         break;
     }
+    case GST_EVENT_SEGMENT:
+    {
+        m_isTrickPlayPrerollNeeded = true;
+        break;
+    }
     default:
         break;
     }
@@ -224,7 +229,7 @@ void PullModeAudioPlaybackDelegate::getProperty(const Property &type, GValue *va
         double volume{1.0};
         if (client)
         {
-            if (client->getCachedVolume(volume))
+            if (m_isFreshPropertyReadEnabled ? client->getVolume(volume, true) : client->getCachedVolume(volume))
                 m_targetVolume = volume;
             else
                 volume = m_targetVolume; // Use last known volume
@@ -243,7 +248,7 @@ void PullModeAudioPlaybackDelegate::getProperty(const Property &type, GValue *va
             g_value_set_boolean(value, m_mute);
             return;
         }
-        g_value_set_boolean(value, client->getMute(m_sourceId));
+        g_value_set_boolean(value, client->getMute(m_sourceId, m_isFreshPropertyReadEnabled));
         break;
     }
     case IPlaybackDelegate::Property::Sync:
@@ -255,7 +260,7 @@ void PullModeAudioPlaybackDelegate::getProperty(const Property &type, GValue *va
         }
 
         bool sync{kDefaultSync};
-        if (!client->getSync(sync))
+        if (!client->getSync(sync, m_isFreshPropertyReadEnabled))
         {
             GST_ERROR_OBJECT(m_sink, "Could not get sync");
         }
@@ -271,7 +276,7 @@ void PullModeAudioPlaybackDelegate::getProperty(const Property &type, GValue *va
         }
 
         int32_t streamSyncMode{kDefaultStreamSyncMode};
-        if (!client->getStreamSyncMode(streamSyncMode))
+        if (!client->getStreamSyncMode(streamSyncMode, m_isFreshPropertyReadEnabled))
         {
             GST_ERROR_OBJECT(m_sink, "Could not get stream-sync-mode");
         }
@@ -281,7 +286,7 @@ void PullModeAudioPlaybackDelegate::getProperty(const Property &type, GValue *va
     case IPlaybackDelegate::Property::FadeVolume:
     {
         double volume{};
-        if (!client || !client->getVolume(volume))
+        if (!client || !client->getVolume(volume, m_isFreshPropertyReadEnabled))
         {
             g_value_set_uint(value, kDefaultFadeVolume);
             return;
@@ -296,7 +301,7 @@ void PullModeAudioPlaybackDelegate::getProperty(const Property &type, GValue *va
             g_value_set_uint(value, m_bufferingLimit);
             return;
         }
-        g_value_set_uint(value, client->getBufferingLimit());
+        g_value_set_uint(value, client->getBufferingLimit(m_isFreshPropertyReadEnabled));
         break;
     }
     case IPlaybackDelegate::Property::UseBuffering:
@@ -306,7 +311,7 @@ void PullModeAudioPlaybackDelegate::getProperty(const Property &type, GValue *va
             g_value_set_boolean(value, m_useBuffering);
             return;
         }
-        g_value_set_boolean(value, client->getUseBuffering());
+        g_value_set_boolean(value, client->getUseBuffering(m_isFreshPropertyReadEnabled));
         break;
     }
     case IPlaybackDelegate::Property::Async:
@@ -536,13 +541,41 @@ void PullModeAudioPlaybackDelegate::setProperty(const Property &type, const GVal
 
 void PullModeAudioPlaybackDelegate::handleQos(uint64_t processed, uint64_t dropped) const
 {
-    GstBus *bus = gst_element_get_bus(m_sink);
-    /* Hardcode isLive to FALSE and set invalid timestamps */
-    GstMessage *message = gst_message_new_qos(GST_OBJECT(m_sink), FALSE, GST_CLOCK_TIME_NONE, GST_CLOCK_TIME_NONE,
-                                              GST_CLOCK_TIME_NONE, GST_CLOCK_TIME_NONE);
-    gst_message_set_qos_stats(message, GST_FORMAT_DEFAULT, processed, dropped);
-    gst_bus_post(bus, message);
-    gst_object_unref(bus);
+    sendQos(GST_FORMAT_DEFAULT, processed, dropped);
+}
+
+GstClockTime PullModeAudioPlaybackDelegate::getPrerollAllowanceUnlocked() const
+{
+    // Compressed audio decoders need a few frames before the segment start to produce the first sample correctly
+    constexpr GstClockTime kOpusPrerollAllowance{80 * GST_MSECOND};
+    constexpr GstClockTime kDefaultPrerollAllowance{100 * GST_MSECOND};
+    if (!m_caps || gst_caps_is_empty(m_caps))
+    {
+        return kDefaultPrerollAllowance;
+    }
+    const gchar *structName{gst_structure_get_name(gst_caps_get_structure(m_caps, 0))};
+    if (g_str_has_prefix(structName, "audio/x-raw") || g_str_has_prefix(structName, "audio/b-wav"))
+    {
+        return 0;
+    }
+    if (g_str_has_prefix(structName, "audio/x-opus"))
+    {
+        return kOpusPrerollAllowance;
+    }
+    return kDefaultPrerollAllowance;
+}
+
+bool PullModeAudioPlaybackDelegate::shouldDropBufferUnlocked(GstBuffer *buffer)
+{
+    // Audio is not rendered during fast trick play, where video is reduced to keyframes. The first buffer of each
+    // segment is still sent, so that the server can preroll the audio source.
+    if (getPlaybackRateUnlocked() <= kDefaultTrickPlayKeyframeRate || m_isTrickPlayPrerollNeeded.exchange(false))
+    {
+        return false;
+    }
+    GST_LOG_OBJECT(m_sink, "Dropping audio buffer with PTS %" GST_TIME_FORMAT " during trick play",
+                   GST_TIME_ARGS(GST_BUFFER_PTS(buffer)));
+    return true;
 }
 
 std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource>
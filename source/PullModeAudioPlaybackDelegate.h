@@ -39,6 +39,10 @@ public:
     void setProperty(const Property &type, const GValue *value) override;
     void handleQos(uint64_t processed, uint64_t dropped) const override;
 
+protected:
+    bool shouldDropBufferUnlocked(GstBuffer *buffer) override;
+    GstClockTime getPrerollAllowanceUnlocked() const override;
+
 private:
     std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> createMediaSource(GstCaps *caps) const;
 
@@ -62,4 +66,5 @@ private:
     std::atomic_bool m_isBufferingLimitQueued{false};
     std::atomic_bool m_useBuffering{kDefaultUseBuffering};
     std::atomic_bool m_isUseBufferingQueued{false};
+    std::atomic_bool m_isTrickPlayPrerollNeeded{true};
 };
\ No newline at end of file
@@ -17,15 +17,23 @@
  */
 
 #include "PullModePlaybackDelegate.h"
+#include "Constants.h"
 #include "ControlBackend.h"
 #include "GstreamerCatLog.h"
+#include "MediaPlayerClientPool.h"
 #include "RialtoGStreamerMSEBaseSink.h"
 #include "RialtoGStreamerMSEBaseSinkPrivate.h"
+#include "RialtoGStreamerTracer.h"
+#include <cmath>
 
 #define GST_CAT_DEFAULT rialtoGStreamerCat
 
 namespace
 {
+// Streams without keyframe flags (or with a very long GOP) must not be blocked forever after a flush.
+// 300 frames is 5 seconds of 60 fps video.
+constexpr uint64_t kMaxLeadingDeltaFrames{300};
+
 GstObject *getOldestGstBinParent(GstElement *element)
 {
     GstObject *parent = gst_object_get_parent(GST_OBJECT_CAST(element));
@@ -100,10 +108,11 @@ void PullModePlaybackDelegate::clearBuffersUnlocked()
 {
     m_isSinkFlushOngoing = true;
     m_needDataCondVariable.notify_all();
+    m_frontSampleIndex += m_samples.size();
     while (!m_samples.empty())
     {
         GstSample *sample = m_samples.front();
-        m_samples.pop();
+        m_samples.pop_front();
         gst_sample_unref(sample);
     }
     setLastBuffer(nullptr);
@@ -144,6 +153,7 @@ void PullModePlaybackDelegate::handleEos()
 void PullModePlaybackDelegate::handleFlushCompleted()
 {
     GST_INFO_OBJECT(m_sink, "Flush completed");
+    RialtoTracing::flushCompleted(m_sink);
     std::unique_lock<std::mutex> lock(m_sinkMutex);
     m_isServerFlushOngoing = false;
     m_isTimeResetOngoing = false;
@@ -322,6 +332,15 @@ void PullModePlaybackDelegate::handleError(const std::string &message, gint code
 
 void PullModePlaybackDelegate::notifyApplicationState(firebolt::rialto::ApplicationState state)
 {
+    // Server drops the sessions of an application which is not running, pre-warmed ones can't be used anymore
+    if (state == firebolt::rialto::ApplicationState::RUNNING)
+    {
+        MediaPlayerClientPool::instance().prime();
+    }
+    else
+    {
+        MediaPlayerClientPool::instance().clear();
+    }
     if (state == firebolt::rialto::ApplicationState::UNKNOWN)
     {
         GST_WARNING_OBJECT(m_sink, "Rialto control sent unknown application state");
@@ -377,6 +396,11 @@ void PullModePlaybackDelegate::setProperty(const Property &type, const GValue *v
         }
         break;
     }
+    case Property::FreshProperties:
+    {
+        m_isFreshPropertyReadEnabled = g_value_get_boolean(value) != FALSE;
+        break;
+    }
     default:
     {
         break;
@@ -406,6 +430,11 @@ void PullModePlaybackDelegate::getProperty(const Property &type, GValue *value)
         g_value_set_boolean(value, m_hasDrm ? TRUE : FALSE);
         break;
     }
+    case Property::FreshProperties:
+    {
+        g_value_set_boolean(value, m_isFreshPropertyReadEnabled ? TRUE : FALSE);
+        break;
+    }
     case Property::Stats:
     {
         std::shared_ptr<GStreamerMSEMediaPlayerClient> client = m_mediaPlayerManager.getMediaPlayerClient();
@@ -417,10 +446,21 @@ void PullModePlaybackDelegate::getProperty(const Property &type, GValue *value)
 
         guint64 totalVideoFrames{0};
         guint64 droppedVideoFrames{0};
-        if (client->getStats(m_sourceId, totalVideoFrames, droppedVideoFrames))
+        if (client->getStats(m_sourceId, totalVideoFrames, droppedVideoFrames, m_isFreshPropertyReadEnabled))
         {
+            guint64 leadingDeltaFramesDropped{0};
+            {
+                std::lock_guard<std::mutex> lock(m_sinkMutex);
+                leadingDeltaFramesDropped = m_leadingDeltaFramesDropped;
+            }
             GstStructure *stats{gst_structure_new("stats", "rendered", G_TYPE_UINT64, totalVideoFrames, "dropped",
-                                                  G_TYPE_UINT64, droppedVideoFrames, nullptr)};
+                                                  G_TYPE_UINT64, droppedVideoFrames, "leading-delta-frames-dropped",
+                                                  G_TYPE_UINT64, leadingDeltaFramesDropped, nullptr)};
+            const std::optional<DataRequestStats::Snapshot> kDataRequestStats{client->getDataRequestStats(m_sourceId)};
+            if (kDataRequestStats)
+            {
+                DataRequestStats::addToStructure(stats, *kDataRequestStats);
+            }
             g_value_set_pointer(value, stats);
         }
         else
@@ -467,6 +507,7 @@ std::optional<gboolean> PullModePlaybackDelegate::handleQuery(GstQuery *query) c
         {
             return FALSE;
         }
+        guint64 segmentStop{GST_CLOCK_TIME_NONE};
         {
             std::unique_lock<std::mutex> lock(m_sinkMutex);
             if (m_isServerFlushOngoing && m_isTimeResetOngoing)
@@ -474,6 +515,10 @@ std::optional<gboolean> PullModePlaybackDelegate::handleQuery(GstQuery *query) c
                 GST_WARNING_OBJECT(m_sink, "Position query during server flush and time reset, returning FALSE");
                 return FALSE;
             }
+            if (m_lastSegment.format == GST_FORMAT_TIME && m_lastSegment.rate > 0)
+            {
+                segmentStop = m_lastSegment.stop;
+            }
         }
 
         GstFormat fmt;
@@ -482,7 +527,12 @@ std::optional<gboolean> PullModePlaybackDelegate::handleQuery(GstQuery *query) c
         {
         case GST_FORMAT_TIME:
         {
+            // Position is extrapolated by the client between server updates, so don't let it run past the segment end
             gint64 position = client->getPosition(m_sourceId);
+            if (GST_CLOCK_TIME_IS_VALID(segmentStop) && position > static_cast<gint64>(segmentStop))
+            {
+                position = static_cast<gint64>(segmentStop);
+            }
             GST_DEBUG_OBJECT(m_sink, "Queried position is %" GST_TIME_FORMAT, GST_TIME_ARGS(position));
             if (position < 0)
             {
@@ -567,6 +617,7 @@ gboolean PullModePlaybackDelegate::handleSendEvent(GstEvent *event)
                 gboolean update{FALSE};
                 std::lock_guard<std::mutex> lock(m_sinkMutex);
                 gst_segment_do_seek(&m_lastSegment, rate, seekFormat, flags, startType, start, stopType, stop, &update);
+                updatePlaybackRateUnlocked();
             }
         }
 #if GST_CHECK_VERSION(1, 18, 0)
@@ -600,6 +651,7 @@ gboolean PullModePlaybackDelegate::handleSendEvent(GstEvent *event)
         guint32 seqnum = gst_event_get_seqnum(event);
         gst_event_parse_instant_rate_sync_time(event, &rate, &runningTime, &upstreamRunningTime);
 
+        setInstantRate(rate);
         std::shared_ptr<GStreamerMSEMediaPlayerClient> client = m_mediaPlayerManager.getMediaPlayerClient();
         if ((client) && (m_mediaPlayerManager.hasControl()))
         {
@@ -775,6 +827,7 @@ void PullModePlaybackDelegate::copySegment(GstEvent *event)
 {
     std::lock_guard<std::mutex> lock(m_sinkMutex);
     gst_event_copy_segment(event, &m_lastSegment);
+    updatePlaybackRateUnlocked();
 }
 
 void PullModePlaybackDelegate::setSegment()
@@ -797,6 +850,7 @@ void PullModePlaybackDelegate::changePlaybackRate(GstEvent *event)
     gdouble playbackRate{1.0};
     if (gst_structure_get_double(structure, "rate", &playbackRate) == TRUE)
     {
+        setInstantRate(playbackRate);
         std::shared_ptr<GStreamerMSEMediaPlayerClient> client = m_mediaPlayerManager.getMediaPlayerClient();
         if (client && m_mediaPlayerManager.hasControl())
         {
@@ -817,6 +871,7 @@ void PullModePlaybackDelegate::startFlushing()
     if (!m_isSinkFlushOngoing)
     {
         GST_INFO_OBJECT(m_sink, "Starting flushing");
+        RialtoTracing::flushStarted(m_sink);
         if (m_isEos)
         {
             GST_DEBUG_OBJECT(m_sink, "Flush will clear EOS state.");
@@ -834,6 +889,9 @@ void PullModePlaybackDelegate::stopFlushing(bool resetTime)
     flushServer(resetTime);
     std::lock_guard<std::mutex> lock(m_sinkMutex);
     m_isSinkFlushOngoing = false;
+    ++m_flushGeneration;
+    m_leadingDeltaFramesDroppedInGeneration = 0;
+    m_isWaitingForKeyframe = (m_mediaSourceType == firebolt::rialto::MediaSourceType::VIDEO);
 
     if (resetTime)
     {
@@ -855,10 +913,179 @@ void PullModePlaybackDelegate::flushServer(bool resetTime)
         std::unique_lock<std::mutex> lock(m_sinkMutex);
         m_isServerFlushOngoing = true;
         m_isTimeResetOngoing = true;
+        m_qosState.position = -1;
     }
+    RialtoTracing::flushRequested(m_sink, resetTime);
     client->flush(m_sourceId, resetTime);
 }
 
+void PullModePlaybackDelegate::sendQos(GstFormat format, uint64_t processed, uint64_t dropped) const
+{
+    constexpr gdouble kMaxProportion{10.0};
+    constexpr gint kQualityScale{1000000};
+
+    gint64 position{-1};
+    std::shared_ptr<GStreamerMSEMediaPlayerClient> client = m_mediaPlayerManager.getMediaPlayerClient();
+    if (client)
+    {
+        position = client->getPosition(m_sourceId);
+    }
+
+    GstSegment segment;
+    uint64_t processedDelta{0};
+    uint64_t droppedDelta{0};
+    gint64 previousPosition{-1};
+    {
+        std::unique_lock<std::mutex> lock(m_sinkMutex);
+        gst_segment_copy_into(&m_lastSegment, &segment);
+        if (processed < m_qosState.processed || dropped < m_qosState.dropped)
+        {
+            // Server statistics have been reset
+            m_qosState = QosState{};
+        }
+        processedDelta = processed - m_qosState.processed;
+        droppedDelta = dropped - m_qosState.dropped;
+        previousPosition = m_qosState.position;
+        m_qosState = QosState{processed, dropped, position};
+    }
+
+    // Proportion > 1.0 means that the server is not able to render data as fast as it is received
+    gdouble proportion{1.0};
+    gint quality{kQualityScale};
+    if (processedDelta > droppedDelta)
+    {
+        proportion = static_cast<gdouble>(processedDelta) / static_cast<gdouble>(processedDelta - droppedDelta);
+        quality = static_cast<gint>(kQualityScale / proportion);
+    }
+    else if (processedDelta > 0)
+    {
+        proportion = kMaxProportion;
+        quality = 0;
+    }
+
+    // Dropped frames were late. Estimate how late with the average frame duration since the previous QoS report
+    GstClockTimeDiff jitter{0};
+    if (droppedDelta > 0 && processedDelta > 0 && previousPosition >= 0 && position > previousPosition)
+    {
+        const GstClockTimeDiff kAverageFrameDuration{(position - previousPosition) /
+                                                     static_cast<GstClockTimeDiff>(processedDelta)};
+        jitter = kAverageFrameDuration * static_cast<GstClockTimeDiff>(droppedDelta);
+    }
+
+    GstClockTime runningTime{GST_CLOCK_TIME_NONE};
+    GstClockTime streamTime{GST_CLOCK_TIME_NONE};
+    GstClockTime timestamp{GST_CLOCK_TIME_NONE};
+    if (position >= 0 && segment.format == GST_FORMAT_TIME)
+    {
+        timestamp = static_cast<GstClockTime>(position);
+        runningTime = gst_segment_to_running_time(&segment, GST_FORMAT_TIME, timestamp);
+        streamTime = gst_segment_to_stream_time(&segment, GST_FORMAT_TIME, timestamp);
+    }
+
+    GstBus *bus = gst_element_get_bus(m_sink);
+    GstMessage *message =
+        gst_message_new_qos(GST_OBJECT(m_sink), FALSE, runningTime, streamTime, timestamp, GST_CLOCK_TIME_NONE);
+    gst_message_set_qos_values(message, jitter, proportion, quality);
+    gst_message_set_qos_stats(message, format, processed, dropped);
+    gst_bus_post(bus, message);
+    gst_object_unref(bus);
+
+    if (processedDelta > 0 && GST_CLOCK_TIME_IS_VALID(runningTime))
+    {
+        GST_DEBUG_OBJECT(m_sink,
+                         "Sending QoS upstream: proportion %f, jitter %" G_GINT64_FORMAT ", time %" GST_TIME_FORMAT,
+                         proportion, jitter, GST_TIME_ARGS(runningTime));
+        GstQOSType type{jitter > 0 ? GST_QOS_TYPE_UNDERFLOW : GST_QOS_TYPE_OVERFLOW};
+        gst_pad_push_event(m_sinkPad, gst_event_new_qos(type, proportion, jitter, runningTime));
+    }
+}
+
+double PullModePlaybackDelegate::getPlaybackRateUnlocked() const
+{
+    return m_playbackRate;
+}
+
+void PullModePlaybackDelegate::setInstantRate(double rate)
+{
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    m_instantRate = rate;
+    updatePlaybackRateUnlocked();
+}
+
+void PullModePlaybackDelegate::updatePlaybackRateUnlocked()
+{
+    m_playbackRate = std::abs(m_lastSegment.rate * m_lastSegment.applied_rate * m_instantRate);
+}
+
+bool PullModePlaybackDelegate::shouldDropBufferUnlocked(GstBuffer *buffer)
+{
+    return false;
+}
+
+GstClockTime PullModePlaybackDelegate::getPrerollAllowanceUnlocked() const
+{
+    return 0;
+}
+
+bool PullModePlaybackDelegate::isOutsideSegmentUnlocked(GstBuffer *buffer) const
+{
+    // Reverse playback delivers data in chunks ending after the segment stop, so clip only forward playback
+    if (m_lastSegment.format != GST_FORMAT_TIME || m_lastSegment.rate < 0 || !GST_BUFFER_PTS_IS_VALID(buffer))
+    {
+        return false;
+    }
+    const GstClockTime kStart{GST_BUFFER_PTS(buffer)};
+    if (GST_CLOCK_TIME_IS_VALID(m_lastSegment.stop) && kStart >= m_lastSegment.stop)
+    {
+        GST_LOG_OBJECT(m_sink, "Dropping buffer with PTS %" GST_TIME_FORMAT " after segment stop %" GST_TIME_FORMAT,
+                       GST_TIME_ARGS(kStart), GST_TIME_ARGS(m_lastSegment.stop));
+        return true;
+    }
+    const GstClockTime kPrerollAllowance{getPrerollAllowanceUnlocked()};
+    if (!GST_CLOCK_TIME_IS_VALID(kPrerollAllowance) || m_lastSegment.start <= kPrerollAllowance)
+    {
+        return false;
+    }
+    const GstClockTime kEnd{GST_BUFFER_DURATION_IS_VALID(buffer) ? kStart + GST_BUFFER_DURATION(buffer) : kStart};
+    if (kEnd < m_lastSegment.start - kPrerollAllowance)
+    {
+        GST_LOG_OBJECT(m_sink, "Dropping buffer with PTS %" GST_TIME_FORMAT " before segment start %" GST_TIME_FORMAT,
+                       GST_TIME_ARGS(kStart), GST_TIME_ARGS(m_lastSegment.start));
+        return true;
+    }
+    return false;
+}
+
+bool PullModePlaybackDelegate::isLeadingDeltaFrameUnlocked(GstBuffer *buffer)
+{
+    if (!m_isWaitingForKeyframe)
+    {
+        return false;
+    }
+    if (m_leadingDeltaFramesDroppedInGeneration >= kMaxLeadingDeltaFrames)
+    {
+        GST_WARNING_OBJECT(m_sink,
+                           "No keyframe after flush %u within %" G_GUINT64_FORMAT " frames. Sending delta frames",
+                           m_flushGeneration, kMaxLeadingDeltaFrames);
+        m_isWaitingForKeyframe = false;
+        return false;
+    }
+    if (GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT))
+    {
+        ++m_leadingDeltaFramesDroppedInGeneration;
+        ++m_leadingDeltaFramesDropped;
+        GST_LOG_OBJECT(m_sink, "Dropping delta frame with PTS %" GST_TIME_FORMAT " received before first keyframe",
+                       GST_TIME_ARGS(GST_BUFFER_PTS(buffer)));
+        return true;
+    }
+    GST_INFO_OBJECT(m_sink,
+                    "First keyframe after flush %u received. Dropped %" G_GUINT64_FORMAT
+                    " leading delta frames (%" G_GUINT64_FORMAT " in total)",
+                    m_flushGeneration, m_leadingDeltaFramesDroppedInGeneration, m_leadingDeltaFramesDropped);
+    m_isWaitingForKeyframe = false;
+    return false;
+}
+
 GstFlowReturn PullModePlaybackDelegate::handleBuffer(GstBuffer *buffer)
 {
     constexpr size_t kMaxInternalBuffersQueueSize = 24;
@@ -880,16 +1107,34 @@ GstFlowReturn PullModePlaybackDelegate::handleBuffer(GstBuffer *buffer)
         return GST_FLOW_FLUSHING;
     }
 
+    if (isOutsideSegmentUnlocked(buffer) || isLeadingDeltaFrameUnlocked(buffer) || shouldDropBufferUnlocked(buffer))
+    {
+        gst_buffer_unref(buffer);
+        return GST_FLOW_OK;
+    }
+
     GstSample *sample = gst_sample_new(buffer, m_caps, &m_lastSegment, nullptr);
     if (sample)
-        m_samples.push(sample);
+    {
+        m_samples.push_back(sample);
+        RialtoTracing::sampleQueued(m_sink, buffer, m_samples.size());
+    }
     else
+    {
         GST_ERROR_OBJECT(m_sink, "Failed to create a sample");
+    }
 
     std::shared_ptr<GStreamerMSEMediaPlayerClient> client = m_mediaPlayerManager.getMediaPlayerClient();
     if (client)
     {
         client->getFlushAndDataSynchronizer().notifyDataReceived(m_sourceId);
+        if (m_isServerFlushOngoing && m_stagingFlushGeneration != m_flushGeneration &&
+            m_samples.size() >= kMaxStagedSamples)
+        {
+            // Parse samples of the new segment while waiting for the server, so they can be sent right after flush
+            m_stagingFlushGeneration = m_flushGeneration;
+            client->stageSamples(m_sourceId);
+        }
     }
 
     setLastBuffer(buffer);
@@ -899,9 +1144,10 @@ GstFlowReturn PullModePlaybackDelegate::handleBuffer(GstBuffer *buffer)
     return GST_FLOW_OK;
 }
 
-GstRefSample PullModePlaybackDelegate::getFrontSample() const
+GstRefSample PullModePlaybackDelegate::getFrontSample(uint64_t &sampleIndex) const
 {
     std::lock_guard<std::mutex> lock(m_sinkMutex);
+    sampleIndex = m_frontSampleIndex;
     if (m_isServerFlushOngoing)
     {
         GST_WARNING_OBJECT(m_sink, "Skip pulling buffer - flush is ongoing on server side...");
@@ -920,13 +1166,26 @@ GstRefSample PullModePlaybackDelegate::getFrontSample() const
     return GstRefSample{};
 }
 
+GstRefSample PullModePlaybackDelegate::getSample(size_t position, uint64_t &sampleIndex) const
+{
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    sampleIndex = m_frontSampleIndex + position;
+    if (position < m_samples.size())
+    {
+        return GstRefSample{m_samples[position]};
+    }
+    return GstRefSample{};
+}
+
 void PullModePlaybackDelegate::popSample()
 {
     std::lock_guard<std::mutex> lock(m_sinkMutex);
     if (!m_samples.empty())
     {
         gst_sample_unref(m_samples.front());
-        m_samples.pop();
+        m_samples.pop_front();
+        ++m_frontSampleIndex;
+        RialtoTracing::sampleDequeued(m_sink, m_samples.size());
     }
     m_needDataCondVariable.notify_all();
 }
@@ -31,7 +31,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <queue>
+#include <deque>
 
 class PullModePlaybackDelegate : public IPullModePlaybackDelegate,
                                  public firebolt::rialto::IControlClient,
@@ -59,7 +59,8 @@ public:
     gboolean handleSendEvent(GstEvent *event) override;
     gboolean handleEvent(GstPad *pad, GstObject *parent, GstEvent *event) override;
     GstFlowReturn handleBuffer(GstBuffer *buffer) override;
-    GstRefSample getFrontSample() const override;
+    GstRefSample getFrontSample(uint64_t &sampleIndex) const override;
+    GstRefSample getSample(size_t position, uint64_t &sampleIndex) const override;
     void popSample() override;
     bool isEos() const override;
     void lostState() override;
@@ -67,6 +68,14 @@ public:
 
 protected:
     bool attachToMediaClientAndSetStreamsNumber(const uint32_t maxVideoWidth = 0, const uint32_t maxVideoHeight = 0);
+    void sendQos(GstFormat format, uint64_t processed, uint64_t dropped) const;
+    // Absolute rate of the current segment, including instant rate changes
+    double getPlaybackRateUnlocked() const;
+    // Called with m_sinkMutex locked, before the buffer is queued for the server
+    virtual bool shouldDropBufferUnlocked(GstBuffer *buffer);
+    // How long before the segment start buffers are still needed by the decoder. GST_CLOCK_TIME_NONE disables
+    // clipping at segment start. Called with m_sinkMutex locked.
+    virtual GstClockTime getPrerollAllowanceUnlocked() const;
 
 private:
     void clearBuffersUnlocked();
@@ -74,9 +83,13 @@ private:
     void copySegment(GstEvent *event);
     void setSegment();
     void changePlaybackRate(GstEvent *event);
+    void setInstantRate(double rate);
+    void updatePlaybackRateUnlocked();
     void startFlushing();
     void stopFlushing(bool resetTime);
     void flushServer(bool resetTime);
+    bool isLeadingDeltaFrameUnlocked(GstBuffer *buffer);
+    bool isOutsideSegmentUnlocked(GstBuffer *buffer) const;
     bool setStreamsNumber(GstObject *parentObject);
     bool isLiveLatencyEnabled() const;
     GstSample *getLastSample() const;
@@ -86,10 +99,14 @@ protected:
     GstElement *m_sink{nullptr};
     GstPad *m_sinkPad{nullptr};
     GstSegment m_lastSegment{};
+    // Rate of the last instant rate change and the resulting playback rate, both locked by m_sinkMutex
+    double m_instantRate{1.0};
+    double m_playbackRate{1.0};
     GstCaps *m_caps{nullptr};
 
     std::atomic<int32_t> m_sourceId{-1};
-    std::queue<GstSample *> m_samples{};
+    std::deque<GstSample *> m_samples{};
+    uint64_t m_frontSampleIndex{0};
     bool m_isEos{false};
     std::atomic<bool> m_segmentSet{false};
     std::atomic<bool> m_isSinkFlushOngoing{false};
@@ -108,9 +125,28 @@ protected:
     std::atomic<bool> m_hasDrm{true};
     std::atomic<bool> m_isAsync{false};
     bool m_enableLastSample{false};
+    // Property getters of this sink bypass the property cache of the media player client
+    std::atomic<bool> m_isFreshPropertyReadEnabled{false};
     GstBuffer *m_lastBuffer{nullptr};
     firebolt::rialto::PlaybackState m_serverPlaybackState{firebolt::rialto::PlaybackState::UNKNOWN};
     firebolt::rialto::MediaSourceType m_mediaSourceType{firebolt::rialto::MediaSourceType::UNKNOWN};
     guint32 m_lastInstantRateChangeSeqnum{GST_SEQNUM_INVALID};
     std::atomic<guint32> m_currentInstantRateChangeSeqnum{GST_SEQNUM_INVALID};
+
+private:
+    // Last QoS stats received from the server, used to calculate jitter and proportion of the next QoS event
+    struct QosState
+    {
+        uint64_t processed{0};
+        uint64_t dropped{0};
+        gint64 position{-1};
+    };
+    mutable QosState m_qosState{};
+    // Delta frames received after flush before the first keyframe can't be decoded by the server
+    bool m_isWaitingForKeyframe{false};
+    uint32_t m_flushGeneration{0};
+    // Staging is requested once per flush generation, when enough samples are queued
+    uint32_t m_stagingFlushGeneration{0};
+    uint64_t m_leadingDeltaFramesDroppedInGeneration{0};
+    uint64_t m_leadingDeltaFramesDropped{0};
 };
\ No newline at end of file
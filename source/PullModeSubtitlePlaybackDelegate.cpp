@@ -159,7 +159,7 @@ void PullModeSubtitlePlaybackDelegate::getProperty(const Property &type, GValue
             g_value_set_boolean(value, m_isMuted);
             return;
         }
-        g_value_set_boolean(value, client->getMute(m_sourceId));
+        g_value_set_boolean(value, client->getMute(m_sourceId, m_isFreshPropertyReadEnabled));
         break;
     }
     case Property::TextTrackIdentifier:
@@ -254,14 +254,7 @@ void PullModeSubtitlePlaybackDelegate::setProperty(const Property &type, const G
 
 void PullModeSubtitlePlaybackDelegate::handleQos(uint64_t processed, uint64_t dropped) const
 {
-    GstBus *bus = gst_element_get_bus(m_sink);
-    /* Hardcode isLive to FALSE and set invalid timestamps */
-    GstMessage *message = gst_message_new_qos(GST_OBJECT(m_sink), FALSE, GST_CLOCK_TIME_NONE, GST_CLOCK_TIME_NONE,
-                                              GST_CLOCK_TIME_NONE, GST_CLOCK_TIME_NONE);
-
-    gst_message_set_qos_stats(message, GST_FORMAT_BUFFERS, processed, dropped);
-    gst_bus_post(bus, message);
-    gst_object_unref(bus);
+    sendQos(GST_FORMAT_BUFFERS, processed, dropped);
 }
 
 std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource>
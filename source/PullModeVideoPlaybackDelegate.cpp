@@ -207,7 +207,7 @@ void PullModeVideoPlaybackDelegate::getProperty(const Property &type, GValue *va
 
         if (client)
         {
-            if (!client->getImmediateOutput(m_sourceId, immediateOutputValue))
+            if (!client->getImmediateOutput(m_sourceId, immediateOutputValue, m_isFreshPropertyReadEnabled))
             {
                 GST_ERROR_OBJECT(m_sink, "Could not get immediate-output");
             }
@@ -235,6 +235,11 @@ void PullModeVideoPlaybackDelegate::getProperty(const Property &type, GValue *va
         g_value_set_int64(value, videoPts);
         break;
     }
+    case Property::TrickPlayKeyframeRate:
+    {
+        g_value_set_double(value, m_trickPlayKeyframeRate);
+        break;
+    }
     default:
     {
         PullModePlaybackDelegate::getProperty(type, value);
@@ -373,6 +378,9 @@ void PullModeVideoPlaybackDelegate::setProperty(const Property &type, const GVal
         }
         break;
     }
+    case Property::TrickPlayKeyframeRate:
+        m_trickPlayKeyframeRate = g_value_get_double(value);
+        break;
     default:
     {
         PullModePlaybackDelegate::setProperty(type, value);
@@ -383,14 +391,33 @@ void PullModeVideoPlaybackDelegate::setProperty(const Property &type, const GVal
 
 void PullModeVideoPlaybackDelegate::handleQos(uint64_t processed, uint64_t dropped) const
 {
-    GstBus *bus = gst_element_get_bus(m_sink);
-    /* Hardcode isLive to FALSE and set invalid timestamps */
-    GstMessage *message = gst_message_new_qos(GST_OBJECT(m_sink), FALSE, GST_CLOCK_TIME_NONE, GST_CLOCK_TIME_NONE,
-                                              GST_CLOCK_TIME_NONE, GST_CLOCK_TIME_NONE);
-
-    gst_message_set_qos_stats(message, GST_FORMAT_BUFFERS, processed, dropped);
-    gst_bus_post(bus, message);
-    gst_object_unref(bus);
+    sendQos(GST_FORMAT_BUFFERS, processed, dropped);
+}
+
+GstClockTime PullModeVideoPlaybackDelegate::getPrerollAllowanceUnlocked() const
+{
+    // Frames before the segment start may be references for the frames that follow, so keep the whole GOP
+    return GST_CLOCK_TIME_NONE;
+}
+
+bool PullModeVideoPlaybackDelegate::shouldDropBufferUnlocked(GstBuffer *buffer)
+{
+    // At high trick play rates server is able to display only a fraction of frames, so send only keyframes
+    const double kKeyframeRate{m_trickPlayKeyframeRate};
+    if (kKeyframeRate <= 0.0 || !GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT))
+    {
+        return false;
+    }
+    const double kRate{getPlaybackRateUnlocked()};
+    if (kRate <= kKeyframeRate)
+    {
+        return false;
+    }
+    ++m_trickPlayDroppedFrames;
+    GST_LOG_OBJECT(m_sink,
+                   "Dropping delta frame with PTS %" GST_TIME_FORMAT " at rate %.2f, dropped so far: %" G_GUINT64_FORMAT,
+                   GST_TIME_ARGS(GST_BUFFER_PTS(buffer)), kRate, m_trickPlayDroppedFrames);
+    return true;
 }
 
 std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource>
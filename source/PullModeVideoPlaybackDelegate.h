@@ -32,6 +32,10 @@ public:
     void setProperty(const Property &type, const GValue *value) override;
     void handleQos(uint64_t processed, uint64_t dropped) const override;
 
+protected:
+    bool shouldDropBufferUnlocked(GstBuffer *buffer) override;
+    GstClockTime getPrerollAllowanceUnlocked() const override;
+
 private:
     std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> createMediaSource(GstCaps *caps) const;
 
@@ -39,6 +43,8 @@ private:
     uint32_t m_maxWidth{0};
     uint32_t m_maxHeight{0};
     bool m_stepOnPrerollEnabled{false};
+    std::atomic<double> m_trickPlayKeyframeRate{kDefaultTrickPlayKeyframeRate};
+    uint64_t m_trickPlayDroppedFrames{0};
 
     std::mutex m_propertyMutex{};
     // START of variables locked by propertyMutex
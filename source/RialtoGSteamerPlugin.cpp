@@ -17,9 +17,11 @@
  */
 
 #include "GstreamerCatLog.h"
+#include "MediaPlayerClientPool.h"
 #include "RialtoGStreamerMSEAudioSink.h"
 #include "RialtoGStreamerMSESubtitleSink.h"
 #include "RialtoGStreamerMSEVideoSink.h"
+#include "RialtoGStreamerTracer.h"
 #include "RialtoGStreamerWebAudioSink.h"
 #include <cstring>
 #include <limits>
@@ -47,6 +49,12 @@ static gboolean rialto_mse_sinks_init(GstPlugin *plugin)
         GST_WARNING("Failed to get git commit ID!");
     }
 
+    // The tracer is registered independently of the sink rank, so that it can be loaded with GST_TRACERS=rialto
+    if (!gst_tracer_register(plugin, "rialto", RIALTO_TYPE_TRACER))
+    {
+        GST_WARNING("Failed to register the rialto tracer");
+    }
+
     const char *socketPathStr = getenv("RIALTO_SOCKET_PATH");
     guint sinkRank = socketPathStr ? std::numeric_limits<int>::max() : 0;
 
@@ -69,10 +77,17 @@ static gboolean rialto_mse_sinks_init(GstPlugin *plugin)
 
     GST_INFO("Registering plugins with rank %u", sinkRank);
 
-    return gst_element_register(plugin, "rialtomsevideosink", sinkRank, RIALTO_TYPE_MSE_VIDEO_SINK) &&
-           gst_element_register(plugin, "rialtomseaudiosink", sinkRank, RIALTO_TYPE_MSE_AUDIO_SINK) &&
-           gst_element_register(plugin, "rialtomsesubtitlesink", sinkRank, RIALTO_TYPE_MSE_SUBTITLE_SINK) &&
-           gst_element_register(plugin, "rialtowebaudiosink", sinkRank, RIALTO_TYPE_WEB_AUDIO_SINK);
+    if (!(gst_element_register(plugin, "rialtomsevideosink", sinkRank, RIALTO_TYPE_MSE_VIDEO_SINK) &&
+          gst_element_register(plugin, "rialtomseaudiosink", sinkRank, RIALTO_TYPE_MSE_AUDIO_SINK) &&
+          gst_element_register(plugin, "rialtomsesubtitlesink", sinkRank, RIALTO_TYPE_MSE_SUBTITLE_SINK) &&
+          gst_element_register(plugin, "rialtowebaudiosink", sinkRank, RIALTO_TYPE_WEB_AUDIO_SINK)))
+    {
+        return false;
+    }
+
+    // Pre-warmed sessions (if enabled) are created in the background, so that the first playback can use them
+    MediaPlayerClientPool::instance().prime();
+    return true;
 }
 
 GST_PLUGIN_DEFINE(GST_VERSION_MAJOR, GST_VERSION_MINOR, rialtosinks, "Sinks which communicate with RialtoServer",
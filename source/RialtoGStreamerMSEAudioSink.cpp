@@ -22,6 +22,7 @@
 
 #include "GStreamerMSEUtils.h"
 #include "IMediaPipelineCapabilities.h"
+#include "MediaPipelineCapabilitiesCache.h"
 #include "PullModeAudioPlaybackDelegate.h"
 #include "PushModeAudioPlaybackDelegate.h"
 #include "RialtoGStreamerMSEAudioSink.h"
@@ -284,7 +285,7 @@ static void rialto_mse_audio_sink_class_init(RialtoMSEAudioSinkClass *klass)
                                                          FALSE, G_PARAM_READWRITE));
 
     std::unique_ptr<firebolt::rialto::IMediaPipelineCapabilities> mediaPlayerCapabilities =
-        firebolt::rialto::IMediaPipelineCapabilitiesFactory::createFactory()->createMediaPipelineCapabilities();
+        MediaPipelineCapabilitiesCache::createMediaPipelineCapabilities();
     if (mediaPlayerCapabilities)
     {
         std::vector<std::string> supportedMimeTypes =
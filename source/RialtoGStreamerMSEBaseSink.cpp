@@ -28,8 +28,11 @@
 #include "IClientLogControl.h"
 #include "IMediaPipeline.h"
 #include "LogToGstHandler.h"
+#include "MediaPlayerClientPool.h"
 #include "RialtoGStreamerMSEBaseSink.h"
 #include "RialtoGStreamerMSEBaseSinkPrivate.h"
+#include "RialtoGStreamerTracer.h"
+#include "TraceWriter.h"
 
 GST_DEBUG_CATEGORY_STATIC(RialtoMSEBaseSinkDebug);
 #define GST_CAT_DEFAULT RialtoMSEBaseSinkDebug
@@ -49,6 +52,8 @@ enum
     PROP_STATS,
     PROP_LAST_SAMPLE,
     PROP_ENABLE_LAST_SAMPLE,
+    PROP_PREWARMED_SESSIONS,
+    PROP_FRESH_PROPERTIES,
     PROP_LAST
 };
 
@@ -106,12 +111,18 @@ gboolean rialto_mse_base_sink_event(GstPad *pad, GstObject *parent, GstEvent *ev
 
 GstFlowReturn rialto_mse_base_sink_chain(GstPad *pad, GstObject *parent, GstBuffer *buf)
 {
+    const GstClockTime kEntryTime{RialtoTracing::chainEnter(parent, buf)};
+    GstFlowReturn result{GST_FLOW_ERROR};
     if (auto delegate = rialto_mse_base_sink_get_delegate(RIALTO_MSE_BASE_SINK(parent)))
     {
-        return delegate->handleBuffer(buf);
+        result = delegate->handleBuffer(buf);
     }
-    gst_buffer_unref(buf);
-    return GST_FLOW_ERROR;
+    else
+    {
+        gst_buffer_unref(buf);
+    }
+    RialtoTracing::chainExit(parent, kEntryTime, result);
+    return result;
 }
 
 static gboolean rialto_mse_base_sink_query(GstElement *element, GstQuery *query)
@@ -133,6 +144,7 @@ static gboolean rialto_mse_base_sink_query(GstElement *element, GstQuery *query)
 static GstStateChangeReturn rialto_mse_base_sink_change_state(GstElement *element, GstStateChange transition)
 {
     RialtoMSEBaseSink *sink = RIALTO_MSE_BASE_SINK(element);
+    TraceSpan span{"state", gst_state_change_get_name(transition)};
     if (auto delegate = rialto_mse_base_sink_get_delegate(sink))
     {
         GstStateChangeReturn status = delegate->changeState(transition);
@@ -228,6 +240,15 @@ static void rialto_mse_base_sink_get_property(GObject *object, guint propId, GVa
         rialto_mse_base_sink_handle_get_property(RIALTO_MSE_BASE_SINK(object), IPlaybackDelegate::Property::LastSample,
                                                  value);
         break;
+    case PROP_PREWARMED_SESSIONS:
+        g_value_set_uint(value, MediaPlayerClientPool::instance().getSize());
+        break;
+    case PROP_FRESH_PROPERTIES:
+        // Set default value if it can't be acquired
+        g_value_set_boolean(value, FALSE);
+        rialto_mse_base_sink_handle_get_property(RIALTO_MSE_BASE_SINK(object),
+                                                 IPlaybackDelegate::Property::FreshProperties, value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, propId, pspec);
         break;
@@ -254,6 +275,13 @@ static void rialto_mse_base_sink_set_property(GObject *object, guint propId, con
         rialto_mse_base_sink_handle_set_property(RIALTO_MSE_BASE_SINK(object),
                                                  IPlaybackDelegate::Property::EnableLastSample, value);
         break;
+    case PROP_PREWARMED_SESSIONS:
+        MediaPlayerClientPool::instance().setSize(g_value_get_uint(value));
+        break;
+    case PROP_FRESH_PROPERTIES:
+        rialto_mse_base_sink_handle_set_property(RIALTO_MSE_BASE_SINK(object),
+                                                 IPlaybackDelegate::Property::FreshProperties, value);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, propId, pspec);
         break;
@@ -369,4 +397,15 @@ static void rialto_mse_base_sink_class_init(RialtoMSEBaseSinkClass *klass)
                                     g_param_spec_boxed("last-sample", "Last Sample",
                                                        "The last sample received in the sink", GST_TYPE_SAMPLE,
                                                        GParamFlags(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(gobjectClass, PROP_PREWARMED_SESSIONS,
+                                    g_param_spec_uint("prewarmed-sessions", "prewarmed sessions",
+                                                      "Number of sessions kept ready for the next playback in this "
+                                                      "process, 0 releases them",
+                                                      0, G_MAXUINT, 0, GParamFlags(G_PARAM_READWRITE)));
+
+    g_object_class_install_property(gobjectClass, PROP_FRESH_PROPERTIES,
+                                    g_param_spec_boolean("fresh-properties", "fresh properties",
+                                                         "Read property values from the server instead of the cache",
+                                                         FALSE, GParamFlags(G_PARAM_READWRITE)));
 }
@@ -23,6 +23,7 @@
 #include "GStreamerEMEUtils.h"
 #include "GStreamerMSEUtils.h"
 #include "IMediaPipelineCapabilities.h"
+#include "MediaPipelineCapabilitiesCache.h"
 #include "PullModeSubtitlePlaybackDelegate.h"
 #include "RialtoGStreamerMSEBaseSinkPrivate.h"
 #include "RialtoGStreamerMSESubtitleSink.h"
@@ -174,7 +175,7 @@ static void rialto_mse_subtitle_sink_class_init(RialtoMSESubtitleSinkClass *klas
                                     g_param_spec_boolean("async", "Async", "Asynchronous mode", FALSE, G_PARAM_READWRITE));
 
     std::unique_ptr<firebolt::rialto::IMediaPipelineCapabilities> mediaPlayerCapabilities =
-        firebolt::rialto::IMediaPipelineCapabilitiesFactory::createFactory()->createMediaPipelineCapabilities();
+        MediaPipelineCapabilitiesCache::createMediaPipelineCapabilities();
     if (mediaPlayerCapabilities)
     {
         std::vector<std::string> supportedMimeTypes =
@@ -23,6 +23,7 @@
 #include "GStreamerEMEUtils.h"
 #include "GStreamerMSEUtils.h"
 #include "IMediaPipelineCapabilities.h"
+#include "MediaPipelineCapabilitiesCache.h"
 #include "PullModeVideoPlaybackDelegate.h"
 #include "RialtoGStreamerMSEBaseSinkPrivate.h"
 #include "RialtoGStreamerMSEVideoSink.h"
@@ -51,6 +52,7 @@ enum
     PROP_SHOW_VIDEO_WINDOW,
     PROP_IS_MASTER,
     PROP_VIDEO_PTS,
+    PROP_TRICK_PLAY_KEYFRAME_RATE,
     PROP_LAST
 };
 
@@ -136,6 +138,13 @@ static void rialto_mse_video_sink_get_property(GObject *object, guint propId, GV
                                                  value);
         break;
     }
+    case PROP_TRICK_PLAY_KEYFRAME_RATE:
+    {
+        g_value_set_double(value, kDefaultTrickPlayKeyframeRate); // Set default value
+        rialto_mse_base_sink_handle_get_property(RIALTO_MSE_BASE_SINK(object),
+                                                 IPlaybackDelegate::Property::TrickPlayKeyframeRate, value);
+        break;
+    }
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, propId, pspec);
         break;
@@ -186,6 +195,12 @@ static void rialto_mse_video_sink_set_property(GObject *object, guint propId, co
                                                  IPlaybackDelegate::Property::ShowVideoWindow, value);
         break;
     }
+    case PROP_TRICK_PLAY_KEYFRAME_RATE:
+    {
+        rialto_mse_base_sink_handle_set_property(RIALTO_MSE_BASE_SINK(object),
+                                                 IPlaybackDelegate::Property::TrickPlayKeyframeRate, value);
+        break;
+    }
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, propId, pspec);
         break;
@@ -247,9 +262,15 @@ static void rialto_mse_video_sink_class_init(RialtoMSEVideoSinkClass *klass)
     g_object_class_install_property(gobjectClass, PROP_VIDEO_PTS,
                                     g_param_spec_int64("video_pts", "video PTS", "current video PTS value", G_MININT64,
                                                        G_MAXINT64, 0, G_PARAM_READABLE));
+    g_object_class_install_property(gobjectClass, PROP_TRICK_PLAY_KEYFRAME_RATE,
+                                    g_param_spec_double("trick-play-keyframe-rate", "trick play keyframe rate",
+                                                        "Playback rate above which only keyframes are sent to the "
+                                                        "server. 0 disables keyframe-only trick play",
+                                                        0.0, G_MAXDOUBLE, kDefaultTrickPlayKeyframeRate,
+                                                        GParamFlags(G_PARAM_READWRITE)));
 
     std::unique_ptr<firebolt::rialto::IMediaPipelineCapabilities> mediaPlayerCapabilities =
-        firebolt::rialto::IMediaPipelineCapabilitiesFactory::createFactory()->createMediaPipelineCapabilities();
+        MediaPipelineCapabilitiesCache::createMediaPipelineCapabilities();
     if (mediaPlayerCapabilities)
     {
         std::vector<std::string> supportedMimeTypes =
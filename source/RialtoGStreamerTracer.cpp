@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "RialtoGStreamerTracer.h"
+#include "GstreamerCatLog.h"
+#include <atomic>
+
+#define GST_CAT_DEFAULT rialtoGStreamerCat
+
+namespace
+{
+std::atomic<int> gActiveTracers{0};
+
+GstTracerRecord *gChainEnterRecord{nullptr};
+GstTracerRecord *gChainExitRecord{nullptr};
+GstTracerRecord *gSampleRecord{nullptr};
+GstTracerRecord *gAddSegmentRecord{nullptr};
+GstTracerRecord *gHaveDataRecord{nullptr};
+GstTracerRecord *gServerStateRecord{nullptr};
+GstTracerRecord *gFlushRecord{nullptr};
+GstTracerRecord *gWebAudioWriteRecord{nullptr};
+
+GstStructure *createField(GType type, GstTracerValueScope scope, const char *description)
+{
+    return gst_structure_new("value", "type", G_TYPE_GTYPE, type, "related-to", GST_TYPE_TRACER_VALUE_SCOPE, scope,
+                             "description", G_TYPE_STRING, description, nullptr);
+}
+
+GstTracerRecord *createRecord(GstTracerRecord *record)
+{
+    GST_OBJECT_FLAG_SET(record, GST_OBJECT_FLAG_MAY_BE_LEAKED);
+    return record;
+}
+
+GstStructure *createTimestampField()
+{
+    return createField(G_TYPE_UINT64, GST_TRACER_VALUE_SCOPE_PROCESS, "monotonic time of the event in ns");
+}
+
+GstStructure *createElementField()
+{
+    return createField(G_TYPE_STRING, GST_TRACER_VALUE_SCOPE_ELEMENT, "name of the rialto sink");
+}
+
+GstStructure *createSourceIdField()
+{
+    return createField(G_TYPE_INT, GST_TRACER_VALUE_SCOPE_PROCESS, "rialto source id");
+}
+
+GstStructure *createRequestIdField()
+{
+    return createField(G_TYPE_UINT, GST_TRACER_VALUE_SCOPE_PROCESS, "need data request id");
+}
+
+void createRecords()
+{
+    gChainEnterRecord = createRecord(gst_tracer_record_new(
+        "rialto-chain-enter.class", "ts", createTimestampField(), "element", createElementField(), "pts",
+        createField(G_TYPE_UINT64, GST_TRACER_VALUE_SCOPE_ELEMENT, "buffer pts in ns"), nullptr));
+    gChainExitRecord = createRecord(gst_tracer_record_new(
+        "rialto-chain-exit.class", "ts", createTimestampField(), "element", createElementField(), "duration",
+        createField(G_TYPE_UINT64, GST_TRACER_VALUE_SCOPE_ELEMENT, "time spent in the chain function in ns"),
+        "flow-return", createField(G_TYPE_STRING, GST_TRACER_VALUE_SCOPE_ELEMENT, "result of the chain function"),
+        nullptr));
+    gSampleRecord = createRecord(gst_tracer_record_new(
+        "rialto-sample.class", "ts", createTimestampField(), "element", createElementField(), "action",
+        createField(G_TYPE_STRING, GST_TRACER_VALUE_SCOPE_ELEMENT, "queued or dequeued"), "pts",
+        createField(G_TYPE_UINT64, GST_TRACER_VALUE_SCOPE_ELEMENT, "sample pts in ns, none when dequeued"),
+        "queue-size", createField(G_TYPE_UINT, GST_TRACER_VALUE_SCOPE_ELEMENT, "samples left in the sink queue"),
+        nullptr));
+    gAddSegmentRecord = createRecord(gst_tracer_record_new(
+        "rialto-add-segment.class", "ts", createTimestampField(), "source-id", createSourceIdField(), "request-id",
+        createRequestIdField(), "status",
+        createField(G_TYPE_UINT, GST_TRACER_VALUE_SCOPE_PROCESS, "firebolt::rialto::AddSegmentStatus"), "duration",
+        createField(G_TYPE_UINT64, GST_TRACER_VALUE_SCOPE_PROCESS, "time spent in addSegment in ns"), nullptr));
+    gHaveDataRecord = createRecord(gst_tracer_record_new(
+        "rialto-have-data.class", "ts", createTimestampField(), "source-id", createSourceIdField(), "request-id",
+        createRequestIdField(), "status",
+        createField(G_TYPE_UINT, GST_TRACER_VALUE_SCOPE_PROCESS, "firebolt::rialto::MediaSourceStatus"), nullptr));
+    gServerStateRecord = createRecord(gst_tracer_record_new(
+        "rialto-server-state.class", "ts", createTimestampField(), "state",
+        createField(G_TYPE_UINT, GST_TRACER_VALUE_SCOPE_PROCESS, "firebolt::rialto::PlaybackState"), nullptr));
+    gFlushRecord = createRecord(gst_tracer_record_new(
+        "rialto-flush.class", "ts", createTimestampField(), "element", createElementField(), "phase",
+        createField(G_TYPE_STRING, GST_TRACER_VALUE_SCOPE_ELEMENT, "start, request or complete"), "reset-time",
+        createField(G_TYPE_BOOLEAN, GST_TRACER_VALUE_SCOPE_ELEMENT, "whether the flush resets the time"), nullptr));
+    gWebAudioWriteRecord = createRecord(gst_tracer_record_new(
+        "rialto-web-audio-write.class", "ts", createTimestampField(), "frames",
+        createField(G_TYPE_UINT, GST_TRACER_VALUE_SCOPE_PROCESS, "frames written"), "duration",
+        createField(G_TYPE_UINT64, GST_TRACER_VALUE_SCOPE_PROCESS, "time spent in writeBuffer in ns"), "success",
+        createField(G_TYPE_BOOLEAN, GST_TRACER_VALUE_SCOPE_PROCESS, "whether the write succeeded"), nullptr));
+}
+
+void logFlush(GstElement *sink, const char *phase, bool resetTime)
+{
+    gst_tracer_record_log(gFlushRecord, gst_util_get_timestamp(), GST_OBJECT_NAME(sink), phase,
+                          static_cast<gboolean>(resetTime));
+}
+} // namespace
+
+#define rialto_tracer_parent_class parent_class
+G_DEFINE_TYPE(RialtoTracer, rialto_tracer, GST_TYPE_TRACER);
+
+static void rialto_tracer_init(RialtoTracer *self)
+{
+    gActiveTracers.fetch_add(1, std::memory_order_release);
+}
+
+static void rialto_tracer_finalize(GObject *object)
+{
+    gActiveTracers.fetch_sub(1, std::memory_order_release);
+    G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
+static void rialto_tracer_class_init(RialtoTracerClass *klass)
+{
+    G_OBJECT_CLASS(klass)->finalize = rialto_tracer_finalize;
+    createRecords();
+}
+
+bool RialtoTracing::isEnabled()
+{
+    return gActiveTracers.load(std::memory_order_acquire) > 0;
+}
+
+GstClockTime RialtoTracing::chainEnter(GstObject *sink, GstBuffer *buffer)
+{
+    if (!isEnabled())
+    {
+        return GST_CLOCK_TIME_NONE;
+    }
+    const GstClockTime kNow{gst_util_get_timestamp()};
+    gst_tracer_record_log(gChainEnterRecord, kNow, GST_OBJECT_NAME(sink), GST_BUFFER_PTS(buffer));
+    return kNow;
+}
+
+void RialtoTracing::chainExit(GstObject *sink, GstClockTime entryTime, GstFlowReturn result)
+{
+    if (!isEnabled() || !GST_CLOCK_TIME_IS_VALID(entryTime))
+    {
+        return;
+    }
+    const GstClockTime kNow{gst_util_get_timestamp()};
+    gst_tracer_record_log(gChainExitRecord, kNow, GST_OBJECT_NAME(sink), kNow - entryTime, gst_flow_get_name(result));
+}
+
+void RialtoTracing::sampleQueued(GstElement *sink, GstBuffer *buffer, size_t queueSize)
+{
+    if (isEnabled())
+    {
+        gst_tracer_record_log(gSampleRecord, gst_util_get_timestamp(), GST_OBJECT_NAME(sink), "queued",
+                              GST_BUFFER_PTS(buffer), static_cast<guint>(queueSize));
+    }
+}
+
+void RialtoTracing::sampleDequeued(GstElement *sink, size_t queueSize)
+{
+    if (isEnabled())
+    {
+        gst_tracer_record_log(gSampleRecord, gst_util_get_timestamp(), GST_OBJECT_NAME(sink), "dequeued",
+                              GST_CLOCK_TIME_NONE, static_cast<guint>(queueSize));
+    }
+}
+
+void RialtoTracing::segmentAdded(int32_t sourceId, uint32_t needDataRequestId,
+                                 firebolt::rialto::AddSegmentStatus status, GstClockTime duration)
+{
+    if (isEnabled())
+    {
+        gst_tracer_record_log(gAddSegmentRecord, gst_util_get_timestamp(), sourceId, needDataRequestId,
+                              static_cast<guint>(status), duration);
+    }
+}
+
+void RialtoTracing::haveData(int32_t sourceId, uint32_t needDataRequestId, firebolt::rialto::MediaSourceStatus status)
+{
+    if (isEnabled())
+    {
+        gst_tracer_record_log(gHaveDataRecord, gst_util_get_timestamp(), sourceId, needDataRequestId,
+                              static_cast<guint>(status));
+    }
+}
+
+void RialtoTracing::serverStateChanged(firebolt::rialto::PlaybackState state)
+{
+    if (isEnabled())
+    {
+        gst_tracer_record_log(gServerStateRecord, gst_util_get_timestamp(), static_cast<guint>(state));
+    }
+}
+
+void RialtoTracing::flushStarted(GstElement *sink)
+{
+    if (isEnabled())
+    {
+        logFlush(sink, "start", false);
+    }
+}
+
+void RialtoTracing::flushRequested(GstElement *sink, bool resetTime)
+{
+    if (isEnabled())
+    {
+        logFlush(sink, "request", resetTime);
+    }
+}
+
+void RialtoTracing::flushCompleted(GstElement *sink)
+{
+    if (isEnabled())
+    {
+        logFlush(sink, "complete", false);
+    }
+}
+
+void RialtoTracing::webAudioWritten(uint32_t frames, GstClockTime duration, bool isSuccess)
+{
+    if (isEnabled())
+    {
+        gst_tracer_record_log(gWebAudioWriteRecord, gst_util_get_timestamp(), static_cast<guint>(frames), duration,
+                              static_cast<gboolean>(isSuccess));
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include "MediaCommon.h"
+#include <cstdint>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define RIALTO_TYPE_TRACER (rialto_tracer_get_type())
+#define RIALTO_TRACER(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), RIALTO_TYPE_TRACER, RialtoTracer))
+
+typedef struct _RialtoTracer RialtoTracer;
+typedef struct _RialtoTracerClass RialtoTracerClass;
+
+struct _RialtoTracer
+{
+    GstTracer parent;
+};
+
+struct _RialtoTracerClass
+{
+    GstTracerClass parent_class;
+};
+
+GType rialto_tracer_get_type(void);
+
+G_END_DECLS
+
+// Trace points of the rialto sinks. While the "rialto" tracer is loaded (GST_TRACERS=rialto) they are logged as
+// rialto-* tracer records, readable with GST_DEBUG=GST_TRACER:7 by the usual tracer log tooling. Otherwise each call
+// costs a single atomic load.
+class RialtoTracing
+{
+public:
+    static bool isEnabled();
+
+    // Returns the entry time to be passed to chainExit, GST_CLOCK_TIME_NONE when tracing is disabled
+    static GstClockTime chainEnter(GstObject *sink, GstBuffer *buffer);
+    static void chainExit(GstObject *sink, GstClockTime entryTime, GstFlowReturn result);
+    static void sampleQueued(GstElement *sink, GstBuffer *buffer, size_t queueSize);
+    static void sampleDequeued(GstElement *sink, size_t queueSize);
+    static void segmentAdded(int32_t sourceId, uint32_t needDataRequestId, firebolt::rialto::AddSegmentStatus status,
+                             GstClockTime duration);
+    static void haveData(int32_t sourceId, uint32_t needDataRequestId, firebolt::rialto::MediaSourceStatus status);
+    static void serverStateChanged(firebolt::rialto::PlaybackState state);
+    static void flushStarted(GstElement *sink);
+    static void flushRequested(GstElement *sink, bool resetTime);
+    static void flushCompleted(GstElement *sink);
+    static void webAudioWritten(uint32_t frames, GstClockTime duration, bool isSuccess);
+};
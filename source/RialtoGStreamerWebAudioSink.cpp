@@ -21,6 +21,7 @@
 #include "Constants.h"
 #include "PushModeAudioPlaybackDelegate.h"
 #include "RialtoGStreamerWebAudioSink.h"
+#include "TraceWriter.h"
 
 using namespace firebolt::rialto::client;
 
@@ -111,6 +112,7 @@ static gboolean rialto_web_audio_sink_send_event(GstElement *element, GstEvent *
 static GstStateChangeReturn rialto_web_audio_sink_change_state(GstElement *element, GstStateChange transition)
 {
     RialtoWebAudioSink *sink = RIALTO_WEB_AUDIO_SINK(element);
+    TraceSpan span{"state", gst_state_change_get_name(transition)};
     if (GST_STATE_CHANGE_NULL_TO_READY == transition)
     {
         GST_INFO_OBJECT(sink, "RialtoWebAudioSink state change to READY. Initializing delegate");
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "SessionReader.h"
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SessionReader::SessionReader(const std::string &path)
+{
+    int fd{open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd < 0)
+    {
+        return;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && static_cast<size_t>(fileStat.st_size) >= sizeof(session_recording::FileHeader))
+    {
+        void *data{mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0)};
+        if (data != MAP_FAILED)
+        {
+            m_data = static_cast<uint8_t *>(data);
+            m_size = fileStat.st_size;
+        }
+    }
+    close(fd);
+    if (!m_data)
+    {
+        return;
+    }
+    m_isValid = getHeader().magic == session_recording::kMagic && getHeader().version == session_recording::kVersion;
+    rewind();
+}
+
+SessionReader::~SessionReader()
+{
+    if (m_data)
+    {
+        munmap(m_data, m_size);
+    }
+}
+
+bool SessionReader::isValid() const
+{
+    return m_isValid;
+}
+
+const session_recording::FileHeader &SessionReader::getHeader() const
+{
+    return *reinterpret_cast<const session_recording::FileHeader *>(m_data);
+}
+
+std::optional<SessionReader::Record> SessionReader::next()
+{
+    if (!m_isValid || m_size - m_offset < sizeof(session_recording::RecordHeader))
+    {
+        return std::nullopt;
+    }
+    const auto *kHeader{reinterpret_cast<const session_recording::RecordHeader *>(m_data + m_offset)};
+    const size_t kBodyOffset{m_offset + sizeof(session_recording::RecordHeader)};
+    if (m_size - kBodyOffset < kHeader->size)
+    {
+        return std::nullopt;
+    }
+    constexpr size_t kAlignment{session_recording::kRecordAlignment};
+    m_offset = std::min(m_size, kBodyOffset + (kHeader->size + kAlignment - 1) / kAlignment * kAlignment);
+    return Record{kHeader, m_data + kBodyOffset};
+}
+
+void SessionReader::rewind()
+{
+    m_offset = sizeof(session_recording::FileHeader);
+}
+
+std::optional<SessionReader::AttachSource> SessionReader::parseAttachSource(const Record &record)
+{
+    const auto *kRecord{record.as<session_recording::AttachSourceRecord>()};
+    if (record.header->type != session_recording::RecordType::ATTACH_SOURCE || !kRecord ||
+        record.header->size < sizeof(*kRecord) + kRecord->mimeTypeLength + kRecord->codecDataLength +
+                                  kRecord->codecSpecificConfigLength + kRecord->textTrackIdentifierLength)
+    {
+        return std::nullopt;
+    }
+    const uint8_t *data{record.body + sizeof(*kRecord)};
+    AttachSource attachSource{*kRecord, {}, {}, {}, {}};
+    attachSource.mimeType.assign(reinterpret_cast<const char *>(data), kRecord->mimeTypeLength);
+    data += kRecord->mimeTypeLength;
+    attachSource.codecData.assign(data, data + kRecord->codecDataLength);
+    data += kRecord->codecDataLength;
+    attachSource.codecSpecificConfig.assign(data, data + kRecord->codecSpecificConfigLength);
+    data += kRecord->codecSpecificConfigLength;
+    attachSource.textTrackIdentifier.assign(reinterpret_cast<const char *>(data), kRecord->textTrackIdentifierLength);
+    return attachSource;
+}
+
+const uint8_t *SessionReader::getSegmentPayload(const Record &record)
+{
+    const auto *kRecord{record.as<session_recording::SegmentRecord>()};
+    if (record.header->type != session_recording::RecordType::SEGMENT || !kRecord || !kRecord->hasPayload ||
+        record.header->size < sizeof(*kRecord) + kRecord->dataLength)
+    {
+        return nullptr;
+    }
+    return record.body + sizeof(*kRecord);
+}
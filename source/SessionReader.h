@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SESSION_READER_H_
+#define SESSION_READER_H_
+
+#include "SessionRecording.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Reads session recordings written by SessionRecorder. The file is mapped and records are read in place.
+class SessionReader
+{
+public:
+    struct Record
+    {
+        const session_recording::RecordHeader *header;
+        const uint8_t *body;
+
+        // Returns the fixed part of the body, or nullptr if the body is too short for it
+        template <typename T> const T *as() const
+        {
+            return header->size >= sizeof(T) ? reinterpret_cast<const T *>(body) : nullptr;
+        }
+    };
+
+    struct AttachSource
+    {
+        session_recording::AttachSourceRecord record;
+        std::string mimeType;
+        std::vector<uint8_t> codecData;
+        std::vector<uint8_t> codecSpecificConfig;
+        std::string textTrackIdentifier;
+    };
+
+    explicit SessionReader(const std::string &path);
+    ~SessionReader();
+    SessionReader(const SessionReader &) = delete;
+    SessionReader &operator=(const SessionReader &) = delete;
+
+    // False if the file could not be mapped or is not a session recording of a supported version
+    bool isValid() const;
+    const session_recording::FileHeader &getHeader() const;
+    // Returns nothing at the end of the recording. A record cut short by the end of the file, as left by a process
+    // which died while recording, ends the recording as well.
+    std::optional<Record> next();
+    void rewind();
+
+    static std::optional<AttachSource> parseAttachSource(const Record &record);
+    // Media data of a segment record, nullptr when recorded without payload
+    static const uint8_t *getSegmentPayload(const Record &record);
+
+private:
+    uint8_t *m_data{nullptr};
+    size_t m_size{0};
+    size_t m_offset{0};
+    bool m_isValid{false};
+};
+
+#endif // SESSION_READER_H_
@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "SessionRecorder.h"
+#include "GstreamerCatLog.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#define GST_CAT_DEFAULT rialtoGStreamerCat
+
+namespace
+{
+// Segments are written from the puller threads, so the writes should rarely reach the file system
+constexpr size_t kFileBufferSize{256 * 1024};
+constexpr uint8_t kPadding[session_recording::kRecordAlignment]{};
+
+int64_t realTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+bool isDataRecord(session_recording::RecordType type)
+{
+    return type == session_recording::RecordType::SEGMENT || type == session_recording::RecordType::HAVE_DATA ||
+           type == session_recording::RecordType::NEED_DATA;
+}
+} // namespace
+
+std::unique_ptr<SessionRecorder> SessionRecorder::createFromEnvironment()
+{
+    static std::atomic<unsigned> sessionCounter{0};
+    const char *dirStr = getenv("RIALTO_SINKS_RECORD_DIR");
+    if (!dirStr || *dirStr == '\0')
+    {
+        return nullptr;
+    }
+    const char *payloadStr = getenv("RIALTO_SINKS_RECORD_PAYLOAD");
+    const bool kIsPayloadRecorded{payloadStr && std::string(payloadStr) == "1"};
+    const std::string kPath{std::string{dirStr} + "/rialto-session-" + std::to_string(getpid()) + "-" +
+                            std::to_string(sessionCounter++) + ".rgsr"};
+    auto recorder{std::make_unique<SessionRecorder>(kPath, kIsPayloadRecorded)};
+    if (!recorder->isOpen())
+    {
+        GST_WARNING("Could not create session recording %s", kPath.c_str());
+        return nullptr;
+    }
+    GST_INFO("Recording session to %s%s", kPath.c_str(), kIsPayloadRecorded ? " with payload" : "");
+    return recorder;
+}
+
+SessionRecorder::SessionRecorder(const std::string &path, bool isPayloadRecorded)
+    : m_file{std::fopen(path.c_str(), "wb")}, m_isPayloadRecorded{isPayloadRecorded},
+      m_startTime{std::chrono::steady_clock::now()}
+{
+    if (!m_file)
+    {
+        return;
+    }
+    std::setvbuf(m_file, nullptr, _IOFBF, kFileBufferSize);
+    session_recording::FileHeader header{};
+    header.magic = session_recording::kMagic;
+    header.version = session_recording::kVersion;
+    header.flags = isPayloadRecorded ? session_recording::FileFlags::HAS_PAYLOAD : 0;
+    header.startRealTimeNs = realTimeNs();
+    std::fwrite(&header, sizeof(header), 1, m_file);
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    if (m_file)
+    {
+        std::fclose(m_file);
+    }
+}
+
+bool SessionRecorder::isOpen() const
+{
+    return m_file != nullptr;
+}
+
+void SessionRecorder::recordAttachSource(const firebolt::rialto::IMediaPipeline::MediaSource &source)
+{
+    session_recording::AttachSourceRecord record{};
+    record.sourceId = source.getId();
+    record.mediaType = static_cast<uint16_t>(source.getType());
+    record.hasDrm = source.getHasDrm();
+    record.segmentAlignment = static_cast<uint32_t>(source.getSegmentAlignment());
+    record.streamFormat = static_cast<uint32_t>(source.getStreamFormat());
+    record.dolbyVisionProfile = -1;
+
+    const std::string kMimeType{source.getMimeType()};
+    std::vector<uint8_t> codecData;
+    if (source.getCodecData())
+    {
+        codecData = source.getCodecData()->data;
+        record.codecDataType = static_cast<uint8_t>(source.getCodecData()->type);
+    }
+    std::vector<uint8_t> codecSpecificConfig;
+    std::string textTrackIdentifier;
+    if (auto *audioSource = dynamic_cast<const firebolt::rialto::IMediaPipeline::MediaSourceAudio *>(&source))
+    {
+        const firebolt::rialto::AudioConfig kAudioConfig{audioSource->getAudioConfig()};
+        record.numberOfChannels = kAudioConfig.numberOfChannels;
+        record.sampleRate = kAudioConfig.sampleRate;
+        codecSpecificConfig = kAudioConfig.codecSpecificConfig;
+    }
+    else if (auto *videoSource = dynamic_cast<const firebolt::rialto::IMediaPipeline::MediaSourceVideo *>(&source))
+    {
+        record.width = static_cast<uint32_t>(videoSource->getWidth());
+        record.height = static_cast<uint32_t>(videoSource->getHeight());
+        if (auto *dolbyVisionSource =
+                dynamic_cast<const firebolt::rialto::IMediaPipeline::MediaSourceVideoDolbyVision *>(&source))
+        {
+            record.dolbyVisionProfile = static_cast<int32_t>(dolbyVisionSource->getDolbyVisionProfile());
+        }
+    }
+    else if (auto *subtitleSource =
+                 dynamic_cast<const firebolt::rialto::IMediaPipeline::MediaSourceSubtitle *>(&source))
+    {
+        textTrackIdentifier = subtitleSource->getTextTrackIdentifier();
+    }
+    record.mimeTypeLength = kMimeType.size();
+    record.codecDataLength = codecData.size();
+    record.codecSpecificConfigLength = codecSpecificConfig.size();
+    record.textTrackIdentifierLength = textTrackIdentifier.size();
+    writeRecord(session_recording::RecordType::ATTACH_SOURCE,
+                {{&record, sizeof(record)},
+                 {kMimeType.data(), kMimeType.size()},
+                 {codecData.data(), codecData.size()},
+                 {codecSpecificConfig.data(), codecSpecificConfig.size()},
+                 {textTrackIdentifier.data(), textTrackIdentifier.size()}});
+}
+
+void SessionRecorder::recordAllSourcesAttached()
+{
+    writeRecord(session_recording::RecordType::ALL_SOURCES_ATTACHED, {});
+}
+
+void SessionRecorder::recordRemoveSource(int32_t sourceId)
+{
+    const session_recording::SourceRecord kRecord{sourceId, 0};
+    writeRecord(session_recording::RecordType::REMOVE_SOURCE, {{&kRecord, sizeof(kRecord)}});
+}
+
+void SessionRecorder::recordSegment(uint32_t needDataRequestId,
+                                    const firebolt::rialto::IMediaPipeline::MediaSegment &segment,
+                                    firebolt::rialto::AddSegmentStatus status)
+{
+    session_recording::SegmentRecord record{};
+    record.needDataRequestId = needDataRequestId;
+    record.sourceId = segment.getId();
+    record.timeStamp = segment.getTimeStamp();
+    record.duration = segment.getDuration();
+    record.dataLength = segment.getDataLength();
+    record.mediaType = static_cast<uint16_t>(segment.getType());
+    record.isEncrypted = segment.isEncrypted();
+    record.hasPayload = m_isPayloadRecorded;
+    record.addSegmentStatus = static_cast<uint32_t>(status);
+    if (auto *audioSegment = dynamic_cast<const firebolt::rialto::IMediaPipeline::MediaSegmentAudio *>(&segment))
+    {
+        record.sampleRateOrWidth = audioSegment->getSampleRate();
+        record.numberOfChannelsOrHeight = audioSegment->getNumberOfChannels();
+    }
+    else if (auto *videoSegment = dynamic_cast<const firebolt::rialto::IMediaPipeline::MediaSegmentVideo *>(&segment))
+    {
+        record.sampleRateOrWidth = videoSegment->getWidth();
+        record.numberOfChannelsOrHeight = videoSegment->getHeight();
+    }
+    writeRecord(session_recording::RecordType::SEGMENT,
+                {{&record, sizeof(record)}, {segment.getData(), m_isPayloadRecorded ? segment.getDataLength() : 0}});
+}
+
+void SessionRecorder::recordHaveData(int32_t sourceId, uint32_t needDataRequestId,
+                                     firebolt::rialto::MediaSourceStatus status)
+{
+    const session_recording::DataRequestRecord kRecord{sourceId, needDataRequestId, static_cast<uint32_t>(status), 0};
+    writeRecord(session_recording::RecordType::HAVE_DATA, {{&kRecord, sizeof(kRecord)}});
+}
+
+void SessionRecorder::recordFlush(int32_t sourceId, bool resetTime)
+{
+    const session_recording::SourceRecord kRecord{sourceId, resetTime};
+    writeRecord(session_recording::RecordType::FLUSH, {{&kRecord, sizeof(kRecord)}});
+}
+
+void SessionRecorder::recordSetSourcePosition(int32_t sourceId, int64_t position, bool resetTime, double appliedRate,
+                                              uint64_t stopPosition)
+{
+    const session_recording::SetSourcePositionRecord kRecord{sourceId, resetTime, position, appliedRate, stopPosition};
+    writeRecord(session_recording::RecordType::SET_SOURCE_POSITION, {{&kRecord, sizeof(kRecord)}});
+}
+
+void SessionRecorder::recordPlay()
+{
+    writeRecord(session_recording::RecordType::PLAY, {});
+}
+
+void SessionRecorder::recordPause()
+{
+    writeRecord(session_recording::RecordType::PAUSE, {});
+}
+
+void SessionRecorder::recordStop()
+{
+    writeRecord(session_recording::RecordType::STOP, {});
+}
+
+void SessionRecorder::recordSetPlaybackRate(double rate)
+{
+    const session_recording::PlaybackRateRecord kRecord{rate};
+    writeRecord(session_recording::RecordType::SET_PLAYBACK_RATE, {{&kRecord, sizeof(kRecord)}});
+}
+
+void SessionRecorder::recordNeedData(int32_t sourceId, size_t frameCount, uint32_t needDataRequestId)
+{
+    const session_recording::DataRequestRecord kRecord{sourceId, needDataRequestId, static_cast<uint32_t>(frameCount),
+                                                       0};
+    writeRecord(session_recording::RecordType::NEED_DATA, {{&kRecord, sizeof(kRecord)}});
+}
+
+void SessionRecorder::recordSourceFlushed(int32_t sourceId)
+{
+    const session_recording::SourceRecord kRecord{sourceId, 0};
+    writeRecord(session_recording::RecordType::SOURCE_FLUSHED, {{&kRecord, sizeof(kRecord)}});
+}
+
+void SessionRecorder::recordPlaybackState(firebolt::rialto::PlaybackState state)
+{
+    const session_recording::PlaybackStateRecord kRecord{static_cast<uint32_t>(state), 0};
+    writeRecord(session_recording::RecordType::PLAYBACK_STATE, {{&kRecord, sizeof(kRecord)}});
+}
+
+void SessionRecorder::recordBufferUnderflow(int32_t sourceId)
+{
+    const session_recording::SourceRecord kRecord{sourceId, 0};
+    writeRecord(session_recording::RecordType::BUFFER_UNDERFLOW, {{&kRecord, sizeof(kRecord)}});
+}
+
+void SessionRecorder::writeRecord(session_recording::RecordType type, std::initializer_list<Chunk> chunks)
+{
+    if (!m_file)
+    {
+        return;
+    }
+    session_recording::RecordHeader header{type, 0, 0, 0};
+    for (const Chunk &chunk : chunks)
+    {
+        header.size += chunk.size;
+    }
+    constexpr uint32_t kAlignment{session_recording::kRecordAlignment};
+    const size_t kPaddingSize{(kAlignment - header.size % kAlignment) % kAlignment};
+
+    std::unique_lock<std::mutex> lock{m_mutex};
+    // Taken under the lock, so that timestamps never go back in the file
+    header.timestampNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_startTime).count();
+    std::fwrite(&header, sizeof(header), 1, m_file);
+    for (const Chunk &chunk : chunks)
+    {
+        if (chunk.size > 0)
+        {
+            std::fwrite(chunk.data, 1, chunk.size, m_file);
+        }
+    }
+    std::fwrite(kPadding, 1, kPaddingSize, m_file);
+    // Control flow is what matters most when reproducing an issue, don't lose it if the process dies
+    if (!isDataRecord(type))
+    {
+        std::fflush(m_file);
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SESSION_RECORDER_H_
+#define SESSION_RECORDER_H_
+
+#include "IMediaPipeline.h"
+#include "SessionRecording.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Writes the traffic between GStreamerMSEMediaPlayerClient and the server into a session recording (see
+// SessionRecording.h), so that it can be replayed offline with rialto-session-replay.
+// Enabled with RIALTO_SINKS_RECORD_DIR=<directory>, RIALTO_SINKS_RECORD_PAYLOAD=1 records media data as well.
+// Safe to call from any thread.
+class SessionRecorder
+{
+public:
+    // Returns nullptr when recording is not enabled or the file could not be created
+    static std::unique_ptr<SessionRecorder> createFromEnvironment();
+
+    SessionRecorder(const std::string &path, bool isPayloadRecorded);
+    ~SessionRecorder();
+    SessionRecorder(const SessionRecorder &) = delete;
+    SessionRecorder &operator=(const SessionRecorder &) = delete;
+
+    bool isOpen() const;
+
+    void recordAttachSource(const firebolt::rialto::IMediaPipeline::MediaSource &source);
+    void recordAllSourcesAttached();
+    void recordRemoveSource(int32_t sourceId);
+    void recordSegment(uint32_t needDataRequestId, const firebolt::rialto::IMediaPipeline::MediaSegment &segment,
+                       firebolt::rialto::AddSegmentStatus status);
+    void recordHaveData(int32_t sourceId, uint32_t needDataRequestId, firebolt::rialto::MediaSourceStatus status);
+    void recordFlush(int32_t sourceId, bool resetTime);
+    void recordSetSourcePosition(int32_t sourceId, int64_t position, bool resetTime, double appliedRate,
+                                 uint64_t stopPosition);
+    void recordPlay();
+    void recordPause();
+    void recordStop();
+    void recordSetPlaybackRate(double rate);
+    void recordNeedData(int32_t sourceId, size_t frameCount, uint32_t needDataRequestId);
+    void recordSourceFlushed(int32_t sourceId);
+    void recordPlaybackState(firebolt::rialto::PlaybackState state);
+    void recordBufferUnderflow(int32_t sourceId);
+
+private:
+    struct Chunk
+    {
+        const void *data;
+        size_t size;
+    };
+
+    void writeRecord(session_recording::RecordType type, std::initializer_list<Chunk> chunks);
+
+    std::mutex m_mutex;
+    std::FILE *m_file{nullptr};
+    const bool m_isPayloadRecorded;
+    const std::chrono::steady_clock::time_point m_startTime;
+};
+
+#endif // SESSION_RECORDER_H_
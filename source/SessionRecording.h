@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SESSION_RECORDING_H_
+#define SESSION_RECORDING_H_
+
+#include <cstdint>
+
+// Layout of session recordings written by SessionRecorder. A file starts with FileHeader, followed by records, each
+// made of RecordHeader and a body. Bodies start with the struct matching the record type, optionally followed by
+// variable length data. Records start at 8 byte aligned offsets, so that a mapped file can be read in place.
+// Integers are stored in the byte order of the device which made the recording.
+namespace session_recording
+{
+constexpr uint32_t kMagic{0x52534752}; // "RGSR"
+constexpr uint16_t kVersion{1};
+constexpr uint32_t kRecordAlignment{8};
+
+enum FileFlags : uint16_t
+{
+    // Segment records carry the media data
+    HAS_PAYLOAD = 1
+};
+
+struct FileHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    // Wall clock time of the start of the recording, to match it with logs
+    int64_t startRealTimeNs;
+};
+
+enum class RecordType : uint16_t
+{
+    // Commands sent to the server
+    ATTACH_SOURCE = 1,
+    ALL_SOURCES_ATTACHED,
+    REMOVE_SOURCE,
+    SEGMENT,
+    HAVE_DATA,
+    FLUSH,
+    SET_SOURCE_POSITION,
+    PLAY,
+    PAUSE,
+    STOP,
+    SET_PLAYBACK_RATE,
+    // Notifications received from the server
+    NEED_DATA,
+    SOURCE_FLUSHED,
+    PLAYBACK_STATE,
+    BUFFER_UNDERFLOW
+};
+
+struct RecordHeader
+{
+    RecordType type;
+    uint16_t reserved;
+    // Size of the body without padding
+    uint32_t size;
+    // Monotonic time since the start of the recording
+    int64_t timestampNs;
+};
+
+// Followed by mime type, codec data, codec specific config and text track identifier
+struct AttachSourceRecord
+{
+    int32_t sourceId;
+    uint16_t mediaType;
+    uint8_t hasDrm;
+    uint8_t codecDataType;
+    uint32_t segmentAlignment;
+    uint32_t streamFormat;
+    // Video only, -1 when not Dolby Vision
+    int32_t dolbyVisionProfile;
+    uint32_t width;
+    uint32_t height;
+    // Audio only
+    uint32_t numberOfChannels;
+    uint32_t sampleRate;
+    uint32_t mimeTypeLength;
+    uint32_t codecDataLength;
+    uint32_t codecSpecificConfigLength;
+    uint32_t textTrackIdentifierLength;
+    uint32_t reserved;
+};
+
+// Followed by the media data, when recorded with payload
+struct SegmentRecord
+{
+    uint32_t needDataRequestId;
+    int32_t sourceId;
+    int64_t timeStamp;
+    int64_t duration;
+    uint32_t dataLength;
+    uint16_t mediaType;
+    uint8_t isEncrypted;
+    uint8_t hasPayload;
+    // Sample rate and number of channels for audio, width and height for video
+    int32_t sampleRateOrWidth;
+    int32_t numberOfChannelsOrHeight;
+    uint32_t addSegmentStatus;
+    uint32_t reserved;
+};
+
+// NEED_DATA and HAVE_DATA
+struct DataRequestRecord
+{
+    int32_t sourceId;
+    uint32_t needDataRequestId;
+    // Requested frame count for NEED_DATA, MediaSourceStatus for HAVE_DATA
+    uint32_t value;
+    uint32_t reserved;
+};
+
+// REMOVE_SOURCE, FLUSH, SOURCE_FLUSHED and BUFFER_UNDERFLOW
+struct SourceRecord
+{
+    int32_t sourceId;
+    // Reset time for FLUSH
+    uint32_t value;
+};
+
+struct SetSourcePositionRecord
+{
+    int32_t sourceId;
+    uint32_t resetTime;
+    int64_t position;
+    double appliedRate;
+    uint64_t stopPosition;
+};
+
+struct PlaybackRateRecord
+{
+    double rate;
+};
+
+struct PlaybackStateRecord
+{
+    uint32_t playbackState;
+    uint32_t reserved;
+};
+} // namespace session_recording
+
+#endif // SESSION_RECORDING_H_
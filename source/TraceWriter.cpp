@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "TraceWriter.h"
+#include "GstreamerCatLog.h"
+#include "MessageQueueStats.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+#define GST_CAT_DEFAULT rialtoGStreamerCat
+
+namespace
+{
+std::atomic<uint64_t> gWriterCounter{0};
+sem_t gFlushSemaphore;
+
+void onFlushSignal(int)
+{
+    // Writing the file is not async signal safe, it is left to the flush thread
+    sem_post(&gFlushSemaphore);
+}
+
+void installFlushSignalHandler(int signalNumber)
+{
+    static std::once_flag installFlag;
+    std::call_once(installFlag,
+                   [signalNumber]()
+                   {
+                       if (sem_init(&gFlushSemaphore, 0, 0) != 0)
+                       {
+                           GST_ERROR("Failed to create the trace flush semaphore");
+                           return;
+                       }
+                       // Writer returned by instance() is never destroyed, so the thread can outlive any caller
+                       std::thread{[]()
+                                   {
+                                       while (true)
+                                       {
+                                           if (sem_wait(&gFlushSemaphore) == 0)
+                                           {
+                                               TraceWriter::instance()->flush();
+                                           }
+                                       }
+                                   }}
+                           .detach();
+                       struct sigaction action{};
+                       action.sa_handler = onFlushSignal;
+                       sigemptyset(&action.sa_mask);
+                       action.sa_flags = SA_RESTART;
+                       if (sigaction(signalNumber, &action, nullptr) != 0)
+                       {
+                           GST_ERROR("Failed to install the trace flush handler of signal %d", signalNumber);
+                           return;
+                       }
+                       GST_INFO("Trace is written on signal %d", signalNumber);
+                   });
+}
+
+TraceWriter *createFromEnvironment()
+{
+    const char *kFilePath{getenv("RIALTO_SINKS_TRACE_FILE")};
+    if (!kFilePath || std::string{kFilePath}.empty())
+    {
+        return nullptr;
+    }
+    GST_INFO("Writing trace to %s", kFilePath);
+    // Never destroyed, threads may still be adding events while the process exits
+    TraceWriter *writer{new TraceWriter{kFilePath}};
+    std::atexit([]() { TraceWriter::instance()->flush(); });
+    const char *kFlushSignal{getenv("RIALTO_SINKS_TRACE_FLUSH_SIGNAL")};
+    if (kFlushSignal && std::atoi(kFlushSignal) > 0)
+    {
+        installFlushSignalHandler(std::atoi(kFlushSignal));
+    }
+    return writer;
+}
+
+int64_t toNs(TraceWriter::Clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+void writeUs(std::ostream &stream, int64_t ns)
+{
+    stream << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000 << std::setfill(' ');
+}
+
+void writeString(std::ostream &stream, const std::string &value)
+{
+    stream << '"';
+    for (const char kCharacter : value)
+    {
+        if (kCharacter == '"' || kCharacter == '\\')
+        {
+            stream << '\\';
+        }
+        stream << kCharacter;
+    }
+    stream << '"';
+}
+} // namespace
+
+TraceWriter *TraceWriter::instance()
+{
+    static TraceWriter *writer{createFromEnvironment()};
+    return writer;
+}
+
+TraceWriter::TraceWriter(const std::string &filePath, size_t eventsPerThread)
+    : m_id{++gWriterCounter}, m_filePath{filePath}, m_eventsPerThread{eventsPerThread}
+{
+}
+
+void TraceWriter::addSpan(const char *category, const char *name, Clock::time_point start, Clock::time_point end,
+                          const char *argName, int64_t argValue)
+{
+    add(Event{category, name, nullptr, argName, argValue, toNs(start), toNs(end) - toNs(start)});
+}
+
+void TraceWriter::addSpan(const char *category, const std::type_info &handlerType, Clock::time_point start,
+                          Clock::time_point end)
+{
+    add(Event{category, nullptr, &handlerType, nullptr, 0, toNs(start), toNs(end) - toNs(start)});
+}
+
+void TraceWriter::addInstant(const char *category, const char *name, const char *argName, int64_t argValue)
+{
+    add(Event{category, name, nullptr, argName, argValue, toNs(Clock::now()), -1});
+}
+
+void TraceWriter::setThreadName(const std::string &name)
+{
+    ThreadBuffer &buffer{getThreadBuffer()};
+    std::unique_lock<std::mutex> lock{buffer.mutex};
+    buffer.threadName = name;
+}
+
+void TraceWriter::add(const Event &event)
+{
+    ThreadBuffer &buffer{getThreadBuffer()};
+    const uint64_t kIndex{buffer.addedCount.load(std::memory_order_relaxed)};
+    Slot &slot{buffer.slots[kIndex % buffer.capacity]};
+    slot.sequence.store(2 * kIndex + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.category.store(event.category, std::memory_order_relaxed);
+    slot.name.store(event.name, std::memory_order_relaxed);
+    slot.handlerType.store(event.handlerType, std::memory_order_relaxed);
+    slot.argName.store(event.argName, std::memory_order_relaxed);
+    slot.argValue.store(event.argValue, std::memory_order_relaxed);
+    slot.startNs.store(event.startNs, std::memory_order_relaxed);
+    slot.durationNs.store(event.durationNs, std::memory_order_relaxed);
+    slot.sequence.store(2 * kIndex + 2, std::memory_order_release);
+    buffer.addedCount.store(kIndex + 1, std::memory_order_release);
+}
+
+TraceWriter::ThreadBuffer &TraceWriter::getThreadBuffer()
+{
+    // Retires the buffer when the thread exits or starts writing to another writer. It doesn't use the writer, which
+    // may already be destroyed.
+    struct ThreadBufferCache
+    {
+        ~ThreadBufferCache()
+        {
+            if (buffer)
+            {
+                retire(*buffer);
+            }
+        }
+        uint64_t writerId{0};
+        std::shared_ptr<ThreadBuffer> buffer;
+    };
+    thread_local ThreadBufferCache cache;
+    if (cache.writerId != m_id)
+    {
+        if (cache.buffer)
+        {
+            retire(*cache.buffer);
+        }
+        auto buffer{std::make_shared<ThreadBuffer>()};
+        buffer->threadId = static_cast<int>(syscall(SYS_gettid));
+        buffer->capacity = m_eventsPerThread;
+        buffer->slots = std::make_unique<Slot[]>(m_eventsPerThread);
+        char threadName[16]{};
+        if (pthread_getname_np(pthread_self(), threadName, sizeof(threadName)) == 0)
+        {
+            buffer->threadName = threadName;
+        }
+        cache.writerId = m_id;
+        cache.buffer = buffer;
+
+        std::unique_lock<std::mutex> lock{m_mutex};
+        discardOldRetiredBuffersUnlocked();
+        m_threadBuffers.push_back(std::move(buffer));
+    }
+    return *cache.buffer;
+}
+
+void TraceWriter::discardOldRetiredBuffersUnlocked()
+{
+    const size_t kMaxRetiredEvents{m_eventsPerThread * kRetiredThreadBuffers};
+    size_t retiredEvents{0};
+    std::vector<std::shared_ptr<ThreadBuffer>> keptBuffers;
+    for (auto it = m_threadBuffers.rbegin(); it != m_threadBuffers.rend(); ++it)
+    {
+        std::unique_lock<std::mutex> lock{(*it)->mutex};
+        if ((*it)->isRetired)
+        {
+            retiredEvents += (*it)->retiredEvents.size();
+            if (retiredEvents > kMaxRetiredEvents)
+            {
+                continue;
+            }
+        }
+        keptBuffers.push_back(*it);
+    }
+    m_threadBuffers.assign(keptBuffers.rbegin(), keptBuffers.rend());
+}
+
+void TraceWriter::retire(ThreadBuffer &buffer)
+{
+    std::unique_lock<std::mutex> lock{buffer.mutex};
+    buffer.retiredEvents = copyEventsUnlocked(buffer);
+    buffer.retiredEvents.shrink_to_fit();
+    buffer.slots.reset();
+    buffer.isRetired = true;
+}
+
+std::vector<TraceWriter::Event> TraceWriter::copyEventsUnlocked(const ThreadBuffer &buffer)
+{
+    if (buffer.isRetired)
+    {
+        return buffer.retiredEvents;
+    }
+    // Events are copied while the thread keeps adding new ones, the oldest of them may be overwritten meanwhile
+    const uint64_t kAddedCount{buffer.addedCount.load(std::memory_order_acquire)};
+    const uint64_t kFirst{kAddedCount > buffer.capacity ? kAddedCount - buffer.capacity : 0};
+    std::vector<Event> events;
+    events.reserve(kAddedCount - kFirst);
+    for (uint64_t index = kFirst; index < kAddedCount; ++index)
+    {
+        const Slot &kSlot{buffer.slots[index % buffer.capacity]};
+        const uint64_t kSequenceBefore{kSlot.sequence.load(std::memory_order_acquire)};
+        const Event kEvent{kSlot.category.load(std::memory_order_relaxed),
+                           kSlot.name.load(std::memory_order_relaxed),
+                           kSlot.handlerType.load(std::memory_order_relaxed),
+                           kSlot.argName.load(std::memory_order_relaxed),
+                           kSlot.argValue.load(std::memory_order_relaxed),
+                           kSlot.startNs.load(std::memory_order_relaxed),
+                           kSlot.durationNs.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (kSequenceBefore == 2 * index + 2 && kSlot.sequence.load(std::memory_order_relaxed) == kSequenceBefore)
+        {
+            events.push_back(kEvent);
+        }
+    }
+    return events;
+}
+
+void TraceWriter::writeJson(std::ostream &stream) const
+{
+    const int kProcessId{getpid()};
+    std::unique_lock<std::mutex> lock{m_mutex};
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool isFirst{true};
+    auto startEvent = [&](const std::string &name, const char *phase, int threadId)
+    {
+        stream << (isFirst ? "\n" : ",\n") << "{\"name\":";
+        writeString(stream, name);
+        stream << ",\"ph\":\"" << phase << "\",\"pid\":" << kProcessId << ",\"tid\":" << threadId;
+        isFirst = false;
+    };
+    std::vector<Event> events;
+    for (const auto &buffer : m_threadBuffers)
+    {
+        std::string threadName;
+        {
+            std::unique_lock<std::mutex> bufferLock{buffer->mutex};
+            threadName = buffer->threadName;
+            events = copyEventsUnlocked(*buffer);
+        }
+        startEvent("thread_name", "M", buffer->threadId);
+        stream << ",\"args\":{\"name\":";
+        writeString(stream, threadName);
+        stream << "}}";
+
+        for (const Event &kEvent : events)
+        {
+            startEvent(kEvent.handlerType ? MessageQueueStats::getHandlerName(*kEvent.handlerType) : kEvent.name,
+                       kEvent.durationNs < 0 ? "i" : "X", buffer->threadId);
+            stream << ",\"cat\":\"" << kEvent.category << "\",\"ts\":";
+            writeUs(stream, kEvent.startNs);
+            if (kEvent.durationNs < 0)
+            {
+                stream << ",\"s\":\"t\"";
+            }
+            else
+            {
+                stream << ",\"dur\":";
+                writeUs(stream, kEvent.durationNs);
+            }
+            if (kEvent.argName)
+            {
+                stream << ",\"args\":{\"" << kEvent.argName << "\":" << kEvent.argValue << "}";
+            }
+            stream << "}";
+        }
+    }
+    stream << "\n]}\n";
+}
+
+bool TraceWriter::flush() const
+{
+    const std::string kTemporaryPath{m_filePath + ".tmp"};
+    {
+        std::ofstream file{kTemporaryPath, std::ios::trunc};
+        if (!file)
+        {
+            GST_ERROR("Failed to open %s", kTemporaryPath.c_str());
+            return false;
+        }
+        writeJson(file);
+        if (!file)
+        {
+            GST_ERROR("Failed to write %s", kTemporaryPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(kTemporaryPath.c_str(), m_filePath.c_str()) != 0)
+    {
+        GST_ERROR("Failed to rename %s to %s", kTemporaryPath.c_str(), m_filePath.c_str());
+        return false;
+    }
+    return true;
+}
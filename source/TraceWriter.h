@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TRACE_WRITER_H_
+#define TRACE_WRITER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+// Timeline of spans and instants in Chrome trace event format, loadable in Perfetto and chrome://tracing. Enabled by
+// setting RIALTO_SINKS_TRACE_FILE to the output path. The file is written at exit and, if
+// RIALTO_SINKS_TRACE_FLUSH_SIGNAL is set to a signal number, whenever the process receives that signal.
+// Each thread records to its own single producer ring buffer, which keeps the latest events. Recording takes no lock:
+// the thread publishes every event with a per-slot sequence number, which the writer checks to skip slots overwritten
+// while they were copied. When the thread exits, its events are moved out of the ring. Events of exited threads are
+// kept up to the capacity of kRetiredThreadBuffers buffers, the threads which registered first are discarded first.
+// Names, categories and argument names must be string literals, they are stored by pointer.
+class TraceWriter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t kDefaultEventsPerThread{16384};
+    static constexpr size_t kRetiredThreadBuffers{4};
+
+    // Returns nullptr when tracing is not enabled
+    static TraceWriter *instance();
+
+    explicit TraceWriter(const std::string &filePath, size_t eventsPerThread = kDefaultEventsPerThread);
+
+    void addSpan(const char *category, const char *name, Clock::time_point start, Clock::time_point end,
+                 const char *argName = nullptr, int64_t argValue = 0);
+    // Span named after a message handler type, demangled when the trace is written
+    void addSpan(const char *category, const std::type_info &handlerType, Clock::time_point start,
+                 Clock::time_point end);
+    void addInstant(const char *category, const char *name, const char *argName = nullptr, int64_t argValue = 0);
+    void setThreadName(const std::string &name);
+
+    void writeJson(std::ostream &stream) const;
+    bool flush() const;
+
+private:
+    struct Event
+    {
+        const char *category;
+        const char *name;
+        const std::type_info *handlerType;
+        const char *argName;
+        int64_t argValue;
+        int64_t startNs;
+        // Negative for instants
+        int64_t durationNs;
+    };
+
+    struct Slot
+    {
+        // 2 * index + 1 while event of the given index is written, 2 * index + 2 once it is complete
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<const char *> category{nullptr};
+        std::atomic<const char *> name{nullptr};
+        std::atomic<const std::type_info *> handlerType{nullptr};
+        std::atomic<const char *> argName{nullptr};
+        std::atomic<int64_t> argValue{0};
+        std::atomic<int64_t> startNs{0};
+        std::atomic<int64_t> durationNs{0};
+    };
+
+    struct ThreadBuffer
+    {
+        int threadId{0};
+        size_t capacity{0};
+        // Written only by the owning thread
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<uint64_t> addedCount{0};
+        // Guards the fields below and the lifetime of slots, never taken when an event is added
+        std::mutex mutex;
+        std::string threadName;
+        // Events left in the ring when the thread exited, in chronological order
+        std::vector<Event> retiredEvents;
+        bool isRetired{false};
+    };
+
+    void add(const Event &event);
+    ThreadBuffer &getThreadBuffer();
+    void discardOldRetiredBuffersUnlocked();
+    static void retire(ThreadBuffer &buffer);
+    // Must be called with buffer.mutex locked
+    static std::vector<Event> copyEventsUnlocked(const ThreadBuffer &buffer);
+
+    const uint64_t m_id;
+    const std::string m_filePath;
+    const size_t m_eventsPerThread;
+    mutable std::mutex m_mutex;
+    // Shared with the thread local cache of the owning thread, which retires the buffer when the thread exits
+    std::vector<std::shared_ptr<ThreadBuffer>> m_threadBuffers;
+};
+
+// Records a span covering its own lifetime, when tracing is enabled
+class TraceSpan
+{
+public:
+    TraceSpan(const char *category, const char *name, const char *argName = nullptr, int64_t argValue = 0)
+        : m_writer{TraceWriter::instance()}, m_category{category}, m_name{name}, m_argName{argName},
+          m_argValue{argValue}, m_start{m_writer ? TraceWriter::Clock::now() : TraceWriter::Clock::time_point{}}
+    {
+    }
+    ~TraceSpan()
+    {
+        if (m_writer)
+        {
+            m_writer->addSpan(m_category, m_name, m_start, TraceWriter::Clock::now(), m_argName, m_argValue);
+        }
+    }
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    TraceWriter *const m_writer;
+    const char *const m_category;
+    const char *const m_name;
+    const char *const m_argName;
+    const int64_t m_argValue;
+    const TraceWriter::Clock::time_point m_start;
+};
+
+#endif // TRACE_WRITER_H_
@@ -17,6 +17,7 @@
  */
 #pragma once
 
+#include "TraceWriter.h"
 #include "WebAudioClientBackendInterface.h"
 #include <IWebAudioPlayer.h>
 #include <IWebAudioPlayerClient.h>
@@ -34,6 +35,7 @@ public:
     bool createWebAudioBackend(std::weak_ptr<IWebAudioPlayerClient> client, const std::string &audioMimeType,
                                const uint32_t priority, std::weak_ptr<const WebAudioConfig> config) override
     {
+        TraceSpan span{"ipc", "WebAudioPlayerFactory::createWebAudioPlayer"};
         m_webAudioPlayerBackend =
             firebolt::rialto::IWebAudioPlayerFactory::createFactory()->createWebAudioPlayer(client, audioMimeType,
                                                                                             priority, config);
@@ -47,25 +49,52 @@ public:
     }
     void destroyWebAudioBackend() override { m_webAudioPlayerBackend.reset(); }
 
-    bool play() override { return m_webAudioPlayerBackend->play(); }
-    bool pause() override { return m_webAudioPlayerBackend->pause(); }
-    bool setEos() override { return m_webAudioPlayerBackend->setEos(); }
+    bool play() override
+    {
+        TraceSpan span{"ipc", "WebAudioPlayer::play"};
+        return m_webAudioPlayerBackend->play();
+    }
+    bool pause() override
+    {
+        TraceSpan span{"ipc", "WebAudioPlayer::pause"};
+        return m_webAudioPlayerBackend->pause();
+    }
+    bool setEos() override
+    {
+        TraceSpan span{"ipc", "WebAudioPlayer::setEos"};
+        return m_webAudioPlayerBackend->setEos();
+    }
     bool getBufferAvailable(uint32_t &availableFrames) override
     {
         std::shared_ptr<firebolt::rialto::WebAudioShmInfo> webAudioShmInfo;
+        TraceSpan span{"ipc", "WebAudioPlayer::getBufferAvailable"};
         return m_webAudioPlayerBackend->getBufferAvailable(availableFrames, webAudioShmInfo);
     }
-    bool getBufferDelay(uint32_t &delayFrames) override { return m_webAudioPlayerBackend->getBufferDelay(delayFrames); }
+    bool getBufferDelay(uint32_t &delayFrames) override
+    {
+        TraceSpan span{"ipc", "WebAudioPlayer::getBufferDelay"};
+        return m_webAudioPlayerBackend->getBufferDelay(delayFrames);
+    }
     bool writeBuffer(const uint32_t numberOfFrames, void *data) override
     {
+        TraceSpan span{"ipc", "WebAudioPlayer::writeBuffer"};
         return m_webAudioPlayerBackend->writeBuffer(numberOfFrames, data);
     }
     bool getDeviceInfo(uint32_t &preferredFrames, uint32_t &maximumFrames, bool &supportDeferredPlay) override
     {
+        TraceSpan span{"ipc", "WebAudioPlayer::getDeviceInfo"};
         return m_webAudioPlayerBackend->getDeviceInfo(preferredFrames, maximumFrames, supportDeferredPlay);
     }
-    bool setVolume(double volume) override { return m_webAudioPlayerBackend->setVolume(volume); }
-    bool getVolume(double &volume) override { return m_webAudioPlayerBackend->getVolume(volume); }
+    bool setVolume(double volume) override
+    {
+        TraceSpan span{"ipc", "WebAudioPlayer::setVolume"};
+        return m_webAudioPlayerBackend->setVolume(volume);
+    }
+    bool getVolume(double &volume) override
+    {
+        TraceSpan span{"ipc", "WebAudioPlayer::getVolume"};
+        return m_webAudioPlayerBackend->getVolume(volume);
+    }
 
 private:
     std::unique_ptr<IWebAudioPlayer> m_webAudioPlayerBackend;
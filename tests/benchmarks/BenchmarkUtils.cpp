@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BenchmarkUtils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <new>
+#include <numeric>
+#include <sstream>
+
+namespace
+{
+std::atomic<uint64_t> gAllocationCount{0};
+
+std::vector<int> readAllowedCpus()
+{
+    std::vector<int> cpus;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &mask))
+                cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+const std::vector<int> &allowedCpus()
+{
+    static const std::vector<int> kCpus{readAllowedCpus()};
+    return kCpus;
+}
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+uint64_t AllocationCounter::count()
+{
+    return gAllocationCount.load(std::memory_order_relaxed);
+}
+
+void LatencySamples::reserve(size_t count)
+{
+    m_samples.reserve(count);
+}
+
+void LatencySamples::add(const std::chrono::nanoseconds &latency)
+{
+    m_samples.push_back(latency.count());
+    m_isSorted = false;
+}
+
+void LatencySamples::clear()
+{
+    m_samples.clear();
+    m_isSorted = true;
+}
+
+size_t LatencySamples::count() const
+{
+    return m_samples.size();
+}
+
+int64_t LatencySamples::sum() const
+{
+    return std::accumulate(m_samples.begin(), m_samples.end(), int64_t{0});
+}
+
+void LatencySamples::merge(const LatencySamples &other)
+{
+    m_samples.insert(m_samples.end(), other.m_samples.begin(), other.m_samples.end());
+    m_isSorted = m_samples.empty();
+}
+
+int64_t LatencySamples::percentile(double percent) const
+{
+    if (m_samples.empty())
+    {
+        return 0;
+    }
+    if (!m_isSorted)
+    {
+        std::sort(m_samples.begin(), m_samples.end());
+        m_isSorted = true;
+    }
+    const size_t kRank{static_cast<size_t>(std::ceil(percent / 100.0 * m_samples.size()))};
+    return m_samples[std::clamp<size_t>(kRank, 1, m_samples.size()) - 1];
+}
+
+void LatencySamples::report(benchmark::State &state, const std::string &prefix) const
+{
+    constexpr double kNsPerUs{1000.0};
+    state.counters[prefix + "p50_us"] = percentile(50) / kNsPerUs;
+    state.counters[prefix + "p90_us"] = percentile(90) / kNsPerUs;
+    state.counters[prefix + "p99_us"] = percentile(99) / kNsPerUs;
+    state.counters[prefix + "max_us"] = percentile(100) / kNsPerUs;
+}
+
+ProcessStats readProcessStats()
+{
+    ProcessStats stats{0, 0, std::chrono::nanoseconds{0}};
+    std::ifstream status{"/proc/self/status"};
+    std::string line;
+    while (std::getline(status, line))
+    {
+        std::istringstream fields{line};
+        std::string name;
+        fields >> name;
+        if (name == "Threads:")
+            fields >> stats.threadCount;
+        else if (name == "VmRSS:")
+            fields >> stats.rssKb;
+    }
+    timespec cpuTime{};
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuTime) == 0)
+    {
+        stats.cpuTime = std::chrono::seconds{cpuTime.tv_sec} + std::chrono::nanoseconds{cpuTime.tv_nsec};
+    }
+    return stats;
+}
+
+bool pinCurrentThread(unsigned cpuIndex)
+{
+    const std::vector<int> &kCpus{allowedCpus()};
+    if (kCpus.empty())
+    {
+        return false;
+    }
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(kCpus[cpuIndex % kCpus.size()], &mask);
+    return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+}
+
+unsigned allowedCpuCount()
+{
+    return allowedCpus().size();
+}
+
+ScopedCpuAffinity::ScopedCpuAffinity(unsigned cpuIndex) : m_thread{pthread_self()}
+{
+    if (pthread_getaffinity_np(m_thread, sizeof(m_previousMask), &m_previousMask) == 0)
+    {
+        m_isPinned = pinCurrentThread(cpuIndex);
+    }
+}
+
+ScopedCpuAffinity::~ScopedCpuAffinity()
+{
+    if (m_isPinned)
+    {
+        pthread_setaffinity_np(m_thread, sizeof(m_previousMask), &m_previousMask);
+    }
+}
+
+bool ScopedCpuAffinity::isPinned() const
+{
+    return m_isPinned;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Collects latency samples of a benchmark run and reports their percentiles as benchmark counters
+class LatencySamples
+{
+public:
+    void reserve(size_t count);
+    void add(const std::chrono::nanoseconds &latency);
+    void clear();
+    size_t count() const;
+    int64_t sum() const;
+    void merge(const LatencySamples &other);
+    // Returns the given percentile (0-100) in nanoseconds
+    int64_t percentile(double percent) const;
+    // Adds <prefix>p50_us, <prefix>p90_us, <prefix>p99_us and <prefix>max_us counters
+    void report(benchmark::State &state, const std::string &prefix = "") const;
+
+private:
+    // Sorted lazily, when the first percentile is requested
+    mutable std::vector<int64_t> m_samples;
+    mutable bool m_isSorted{true};
+};
+
+// Number of C++ heap allocations made by the whole process so far. GLib allocations are not counted.
+class AllocationCounter
+{
+public:
+    static uint64_t count();
+};
+
+struct ProcessStats
+{
+    unsigned threadCount;
+    uint64_t rssKb;
+    std::chrono::nanoseconds cpuTime;
+};
+
+// Reads thread count and resident set size from /proc/self/status and cpu time used by all threads of the process
+ProcessStats readProcessStats();
+
+// Pins the calling thread to one of the CPUs the process is allowed to run on. Index wraps around the number of
+// allowed CPUs, so that consecutive indexes give distinct CPUs whenever there are enough of them.
+bool pinCurrentThread(unsigned cpuIndex);
+unsigned allowedCpuCount();
+
+// Pins the calling thread for the lifetime of the object and restores its previous affinity afterwards.
+// Used for threads owned by the benchmark library, which are reused between benchmarks.
+class ScopedCpuAffinity
+{
+public:
+    explicit ScopedCpuAffinity(unsigned cpuIndex);
+    ~ScopedCpuAffinity();
+    ScopedCpuAffinity(const ScopedCpuAffinity &) = delete;
+    ScopedCpuAffinity &operator=(const ScopedCpuAffinity &) = delete;
+
+    bool isPinned() const;
+
+private:
+    pthread_t m_thread;
+    cpu_set_t m_previousMask;
+    bool m_isPinned{false};
+};
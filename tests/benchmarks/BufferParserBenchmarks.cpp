@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BenchmarkUtils.h"
+#include "BufferParser.h"
+#include "GStreamerEMEUtils.h"
+#include "GStreamerMSEUtils.h"
+#include "GStreamerUtils.h"
+#include "SampleFactory.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <optional>
+
+namespace
+{
+using CapsFactory = GstCaps *(*)();
+
+constexpr int kStreamId{1};
+
+std::unique_ptr<BufferParser> createBufferParser(firebolt::rialto::MediaSourceType type)
+{
+    switch (type)
+    {
+    case firebolt::rialto::MediaSourceType::AUDIO:
+        return std::make_unique<AudioBufferParser>();
+    case firebolt::rialto::MediaSourceType::VIDEO:
+        return std::make_unique<VideoBufferParser>();
+    default:
+        return std::make_unique<SubtitleBufferParser>();
+    }
+}
+
+void reportAllocations(benchmark::State &state, uint64_t allocationsBefore)
+{
+    const uint64_t kAllocations{AllocationCounter::count() - allocationsBefore};
+    state.counters["allocs/op"] =
+        benchmark::Counter(static_cast<double>(kAllocations), benchmark::Counter::kAvgIterations);
+}
+
+// Buffer mapping is not part of the measurement, the same as the parser gets an already mapped buffer
+void parseBuffer(benchmark::State &state, firebolt::rialto::MediaSourceType type, CapsFactory createCaps,
+                 size_t frameSize, std::optional<EncryptionParams> encryption)
+{
+    GstBuffer *buffer{createBuffer(frameSize)};
+    GstCaps *caps{createCaps()};
+    if (encryption)
+    {
+        addProtectionMetadata(buffer, *encryption);
+        caps = createEncryptedCaps(caps);
+    }
+    GstSample *sample{createSample(buffer, caps)};
+    GstRefSample refSample{sample};
+    gst_sample_unref(sample);
+    GstMapInfo map;
+    if (!gst_buffer_map(refSample.getBuffer(), &map, GST_MAP_READ))
+    {
+        state.SkipWithError("Could not map buffer");
+        return;
+    }
+    std::unique_ptr<BufferParser> parser{createBufferParser(type)};
+
+    const uint64_t kAllocationsBefore{AllocationCounter::count()};
+    for (auto _ : state)
+    {
+        auto segment{parser->parseBuffer(refSample, refSample.getBuffer(), map, kStreamId)};
+        benchmark::DoNotOptimize(segment);
+    }
+    reportAllocations(state, kAllocationsBefore);
+    state.SetBytesProcessed(state.iterations() * frameSize);
+
+    gst_buffer_unmap(refSample.getBuffer(), &map);
+}
+
+// Argument: number of subsamples
+void processProtectionMetadata(benchmark::State &state, const char *cipherMode)
+{
+    constexpr size_t kFrameSize{40000};
+    GstBuffer *buffer{createBuffer(kFrameSize)};
+    addProtectionMetadata(buffer, EncryptionParams{cipherMode, static_cast<unsigned int>(state.range(0))});
+
+    const uint64_t kAllocationsBefore{AllocationCounter::count()};
+    for (auto _ : state)
+    {
+        BufferProtectionMetadata metadata;
+        ProcessProtectionMetadata(buffer, metadata);
+        benchmark::DoNotOptimize(metadata);
+    }
+    reportAllocations(state, kAllocationsBefore);
+
+    gst_buffer_unref(buffer);
+}
+
+void getCodecData(benchmark::State &state, CapsFactory createCaps)
+{
+    GstCaps *caps{createCaps()};
+    const GstStructure *structure{gst_caps_get_structure(caps, 0)};
+
+    const uint64_t kAllocationsBefore{AllocationCounter::count()};
+    for (auto _ : state)
+    {
+        auto codecData{get_codec_data(structure)};
+        benchmark::DoNotOptimize(codecData);
+    }
+    reportAllocations(state, kAllocationsBefore);
+
+    gst_caps_unref(caps);
+}
+
+const EncryptionParams kCenc{"cenc", 1};
+const EncryptionParams kCencSliced{"cenc", 4};
+const EncryptionParams kCbcsSliced{"cbcs", 4};
+} // namespace
+
+BENCHMARK_CAPTURE(parseBuffer, AacClear, firebolt::rialto::MediaSourceType::AUDIO, createAacCaps, 768, std::nullopt);
+BENCHMARK_CAPTURE(parseBuffer, AacCenc, firebolt::rialto::MediaSourceType::AUDIO, createAacCaps, 768, kCenc);
+BENCHMARK_CAPTURE(parseBuffer, Eac3Clear, firebolt::rialto::MediaSourceType::AUDIO, createEac3Caps, 1536, std::nullopt);
+BENCHMARK_CAPTURE(parseBuffer, Eac3Cenc, firebolt::rialto::MediaSourceType::AUDIO, createEac3Caps, 1536, kCenc);
+BENCHMARK_CAPTURE(parseBuffer, OpusClear, firebolt::rialto::MediaSourceType::AUDIO, createOpusCaps, 320, std::nullopt);
+BENCHMARK_CAPTURE(parseBuffer, H264Clear, firebolt::rialto::MediaSourceType::VIDEO, createH264Caps, 40000,
+                  std::nullopt);
+BENCHMARK_CAPTURE(parseBuffer, H264Cenc, firebolt::rialto::MediaSourceType::VIDEO, createH264Caps, 40000, kCencSliced);
+BENCHMARK_CAPTURE(parseBuffer, H264Cbcs, firebolt::rialto::MediaSourceType::VIDEO, createH264Caps, 40000, kCbcsSliced);
+BENCHMARK_CAPTURE(parseBuffer, HevcClear, firebolt::rialto::MediaSourceType::VIDEO, createHevcCaps, 100000,
+                  std::nullopt);
+BENCHMARK_CAPTURE(parseBuffer, HevcCbcs, firebolt::rialto::MediaSourceType::VIDEO, createHevcCaps, 100000,
+                  kCbcsSliced);
+BENCHMARK_CAPTURE(parseBuffer, Av1Clear, firebolt::rialto::MediaSourceType::VIDEO, createAv1Caps, 100000,
+                  std::nullopt);
+BENCHMARK_CAPTURE(parseBuffer, Av1Cenc, firebolt::rialto::MediaSourceType::VIDEO, createAv1Caps, 100000,
+                  kCencSliced);
+BENCHMARK_CAPTURE(parseBuffer, Ttml, firebolt::rialto::MediaSourceType::SUBTITLE, createTtmlCaps, 2000, std::nullopt);
+
+BENCHMARK_CAPTURE(processProtectionMetadata, Cenc, "cenc")->ArgName("subsamples")->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK_CAPTURE(processProtectionMetadata, Cbcs, "cbcs")->ArgName("subsamples")->RangeMultiplier(2)->Range(1, 64);
+
+BENCHMARK_CAPTURE(getCodecData, Aac, createAacCaps);
+BENCHMARK_CAPTURE(getCodecData, Opus, createOpusCaps);
+BENCHMARK_CAPTURE(getCodecData, H264, createH264Caps);
+BENCHMARK_CAPTURE(getCodecData, Hevc, createHevcCaps);
+BENCHMARK_CAPTURE(getCodecData, Av1, createAv1Caps);
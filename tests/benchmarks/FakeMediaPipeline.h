@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include "FakeMediaPlayerClientBackend.h"
+#include "IMediaPipeline.h"
+
+#include <memory>
+#include <string>
+
+// Media pipeline handed out by the IMediaPipelineFactory stub, so that clients created by MediaPlayerManager with
+// the real MediaPlayerClientBackend end up talking to FakeMediaPlayerClientBackend instead of the Rialto server.
+class FakeMediaPipeline : public firebolt::rialto::IMediaPipeline
+{
+public:
+    FakeMediaPipeline(std::weak_ptr<firebolt::rialto::IMediaPipelineClient> client,
+                      const std::shared_ptr<FakeMediaPlayerClientBackend> &backend)
+        : m_client{client}, m_backend{backend}
+    {
+        m_backend->createMediaPlayerBackend(client, 0, 0);
+    }
+
+    std::weak_ptr<firebolt::rialto::IMediaPipelineClient> getClient() override { return m_client; }
+    bool load(firebolt::rialto::MediaType type, const std::string &mimeType, const std::string &url,
+              bool isLive) override
+    {
+        return m_backend->load(type, mimeType, url, isLive);
+    }
+    bool attachSource(const std::unique_ptr<MediaSource> &source) override
+    {
+        m_backend->assignSourceId(*source);
+        return true;
+    }
+    bool removeSource(int32_t id) override { return m_backend->removeSource(id); }
+    bool allSourcesAttached() override { return m_backend->allSourcesAttached(); }
+    bool play(bool &async) override { return m_backend->play(async); }
+    bool pause() override { return m_backend->pause(); }
+    bool stop() override { return m_backend->stop(); }
+    bool setPlaybackRate(double rate) override { return m_backend->setPlaybackRate(rate); }
+    bool setPosition(int64_t position) override { return true; }
+    bool getPosition(int64_t &position) override { return m_backend->getPosition(position); }
+    bool setImmediateOutput(int32_t sourceId, bool immediateOutput) override
+    {
+        return m_backend->setImmediateOutput(sourceId, immediateOutput);
+    }
+    bool getImmediateOutput(int32_t sourceId, bool &immediateOutput) override
+    {
+        return m_backend->getImmediateOutput(sourceId, immediateOutput);
+    }
+    bool getStats(int32_t sourceId, uint64_t &renderedFrames, uint64_t &droppedFrames) override
+    {
+        return m_backend->getStats(sourceId, renderedFrames, droppedFrames);
+    }
+    bool setVideoWindow(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override
+    {
+        return m_backend->setVideoWindow(x, y, width, height);
+    }
+    bool haveData(firebolt::rialto::MediaSourceStatus status, uint32_t needDataRequestId) override
+    {
+        return m_backend->haveData(status, needDataRequestId);
+    }
+    firebolt::rialto::AddSegmentStatus addSegment(uint32_t needDataRequestId,
+                                                  const std::unique_ptr<MediaSegment> &mediaSegment) override
+    {
+        return m_backend->addSegment(needDataRequestId, mediaSegment);
+    }
+    bool renderFrame() override { return m_backend->renderFrame(); }
+    bool setVolume(double targetVolume, uint32_t volumeDuration, firebolt::rialto::EaseType type) override
+    {
+        return m_backend->setVolume(targetVolume, volumeDuration, type);
+    }
+    bool getVolume(double &currentVolume) override { return m_backend->getVolume(currentVolume); }
+    bool setMute(int32_t sourceId, bool mute) override { return m_backend->setMute(mute, sourceId); }
+    bool getMute(int32_t sourceId, bool &mute) override { return m_backend->getMute(mute, sourceId); }
+    bool setTextTrackIdentifier(const std::string &textTrackIdentifier) override
+    {
+        return m_backend->setTextTrackIdentifier(textTrackIdentifier);
+    }
+    bool getTextTrackIdentifier(std::string &textTrackIdentifier) override
+    {
+        return m_backend->getTextTrackIdentifier(textTrackIdentifier);
+    }
+    bool setLowLatency(bool lowLatency) override { return m_backend->setLowLatency(lowLatency); }
+    bool setSync(bool sync) override { return m_backend->setSync(sync); }
+    bool getSync(bool &sync) override { return m_backend->getSync(sync); }
+    bool setSyncOff(bool syncOff) override { return m_backend->setSyncOff(syncOff); }
+    bool setStreamSyncMode(int32_t sourceId, int32_t streamSyncMode) override
+    {
+        return m_backend->setStreamSyncMode(sourceId, streamSyncMode);
+    }
+    bool getStreamSyncMode(int32_t &streamSyncMode) override { return m_backend->getStreamSyncMode(streamSyncMode); }
+    bool flush(int32_t sourceId, bool resetTime, bool &async) override
+    {
+        return m_backend->flush(sourceId, resetTime, async);
+    }
+    bool setSourcePosition(int32_t sourceId, int64_t position, bool resetTime, double appliedRate,
+                           uint64_t stopPosition) override
+    {
+        return m_backend->setSourcePosition(sourceId, position, resetTime, appliedRate, stopPosition);
+    }
+    bool processAudioGap(int64_t position, uint32_t duration, int64_t discontinuityGap, bool audioAac) override
+    {
+        return m_backend->processAudioGap(position, duration, discontinuityGap, audioAac);
+    }
+    bool setBufferingLimit(uint32_t limitBufferingMs) override
+    {
+        return m_backend->setBufferingLimit(limitBufferingMs);
+    }
+    bool getBufferingLimit(uint32_t &limitBufferingMs) override
+    {
+        return m_backend->getBufferingLimit(limitBufferingMs);
+    }
+    bool setUseBuffering(bool useBuffering) override { return m_backend->setUseBuffering(useBuffering); }
+    bool getUseBuffering(bool &useBuffering) override { return m_backend->getUseBuffering(useBuffering); }
+    bool switchSource(const std::unique_ptr<MediaSource> &source) override { return m_backend->switchSource(source); }
+    bool setSubtitleOffset(int32_t sourceId, int64_t position) override
+    {
+        return m_backend->setSubtitleOffset(sourceId, position);
+    }
+    bool getDuration(int64_t &duration) override { return m_backend->getDuration(duration); }
+
+private:
+    std::weak_ptr<firebolt::rialto::IMediaPipelineClient> m_client;
+    std::shared_ptr<FakeMediaPlayerClientBackend> m_backend;
+};
@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "FakeMediaPlayerClientBackend.h"
+
+#include <cstring>
+
+FakeMediaPlayerClientBackend::FakeMediaPlayerClientBackend(size_t bufferSize) : m_buffer(bufferSize) {}
+
+FakeMediaPlayerClientBackend::~FakeMediaPlayerClientBackend()
+{
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_isRunning = false;
+        m_tasksCondVar.notify_all();
+    }
+    if (m_taskThread.joinable())
+    {
+        m_taskThread.join();
+    }
+}
+
+void FakeMediaPlayerClientBackend::enableServerDrivenStreaming(const StreamingBehaviour &behaviour)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_streamingBehaviour = behaviour;
+    if (!m_taskThread.joinable())
+    {
+        m_taskThread = std::thread(&FakeMediaPlayerClientBackend::runTasks, this);
+    }
+}
+
+void FakeMediaPlayerClientBackend::setServerEventCallback(const ServerEventCallback &callback)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_serverEventCallback = callback;
+}
+
+uint32_t FakeMediaPlayerClientBackend::sendNeedData(int32_t sourceId, size_t frameCount)
+{
+    return sendNeedDataInternal(sourceId, frameCount, false);
+}
+
+uint32_t FakeMediaPlayerClientBackend::sendNeedDataInternal(int32_t sourceId, size_t frameCount, bool isAutomatic)
+{
+    uint32_t needDataRequestId{0};
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        needDataRequestId = ++m_lastNeedDataRequestId;
+        m_needDataRequests[needDataRequestId] =
+            NeedDataRequest{std::chrono::steady_clock::now(), 0, std::nullopt, sourceId, isAutomatic};
+    }
+    if (auto client = m_client.lock())
+    {
+        client->notifyNeedMediaData(sourceId, frameCount, needDataRequestId, nullptr);
+    }
+    return needDataRequestId;
+}
+
+std::optional<FakeMediaPlayerClientBackend::HaveDataResult>
+FakeMediaPlayerClientBackend::waitForHaveData(uint32_t needDataRequestId, const std::chrono::milliseconds &timeout)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    auto requestIt = m_needDataRequests.find(needDataRequestId);
+    if (requestIt == m_needDataRequests.end())
+    {
+        return std::nullopt;
+    }
+    // References to elements stay valid when other requests are added in the meantime, iterators don't
+    const NeedDataRequest &request{requestIt->second};
+    m_haveDataCondVar.wait_for(lock, timeout, [&]() { return request.result.has_value(); });
+    std::optional<HaveDataResult> result{request.result};
+    m_needDataRequests.erase(needDataRequestId);
+    return result;
+}
+
+std::optional<FakeMediaPlayerClientBackend::HaveDataResult>
+FakeMediaPlayerClientBackend::requestData(int32_t sourceId, size_t frameCount, const std::chrono::milliseconds &timeout)
+{
+    return waitForHaveData(sendNeedData(sourceId, frameCount), timeout);
+}
+
+uint64_t FakeMediaPlayerClientBackend::getReceivedBytes() const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return m_receivedBytes;
+}
+
+std::vector<int32_t> FakeMediaPlayerClientBackend::getSourceIds() const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return std::vector<int32_t>{m_sourceIds.begin(), m_sourceIds.end()};
+}
+
+void FakeMediaPlayerClientBackend::assignSourceId(firebolt::rialto::IMediaPipeline::MediaSource &source)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    source.setId(++m_lastSourceId);
+    m_sourceIds.insert(m_lastSourceId);
+}
+
+void FakeMediaPlayerClientBackend::createMediaPlayerBackend(
+    std::weak_ptr<firebolt::rialto::IMediaPipelineClient> client, uint32_t maxWidth, uint32_t maxHeight)
+{
+    m_client = client;
+}
+
+bool FakeMediaPlayerClientBackend::isMediaPlayerBackendCreated() const
+{
+    return !m_client.expired();
+}
+
+bool FakeMediaPlayerClientBackend::attachSource(std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> &source)
+{
+    assignSourceId(*source);
+    return true;
+}
+
+bool FakeMediaPlayerClientBackend::removeSource(int32_t id)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_sourceIds.erase(id);
+    m_prerolledSources.erase(id);
+    m_flushedSources.erase(id);
+    return true;
+}
+
+bool FakeMediaPlayerClientBackend::allSourcesAttached()
+{
+    std::set<int32_t> sourceIds;
+    size_t frameCount{0};
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        if (!m_streamingBehaviour)
+        {
+            return true;
+        }
+        m_isPrerolling = true;
+        m_prerolledSources.clear();
+        sourceIds = m_sourceIds;
+        frameCount = m_streamingBehaviour->framesPerNeedData;
+    }
+    for (int32_t sourceId : sourceIds)
+    {
+        sendNeedDataInternal(sourceId, frameCount, true);
+    }
+    return true;
+}
+
+bool FakeMediaPlayerClientBackend::play(bool &async)
+{
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_isPauseRequested = false;
+    }
+    async = false;
+    return true;
+}
+
+bool FakeMediaPlayerClientBackend::pause()
+{
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_isPauseRequested = true;
+        if (m_streamingBehaviour && m_isPrerolling)
+        {
+            // PAUSED will be reported when preroll is finished
+            return true;
+        }
+    }
+    if (auto client = m_client.lock())
+    {
+        client->notifyPlaybackState(firebolt::rialto::PlaybackState::PAUSED);
+    }
+    return true;
+}
+
+bool FakeMediaPlayerClientBackend::stop()
+{
+    if (auto client = m_client.lock())
+    {
+        client->notifyPlaybackState(firebolt::rialto::PlaybackState::STOPPED);
+    }
+    return true;
+}
+
+bool FakeMediaPlayerClientBackend::haveData(firebolt::rialto::MediaSourceStatus status, unsigned int needDataRequestId)
+{
+    const auto kNow{std::chrono::steady_clock::now()};
+    std::unique_lock<std::mutex> lock{m_mutex};
+    auto requestIt = m_needDataRequests.find(needDataRequestId);
+    if (requestIt == m_needDataRequests.end())
+    {
+        return false;
+    }
+    if (requestIt->second.isAutomatic)
+    {
+        const NeedDataRequest kRequest{requestIt->second};
+        m_needDataRequests.erase(requestIt);
+        lock.unlock();
+        handleAutomaticHaveData(status, kRequest);
+        return true;
+    }
+    requestIt->second.result =
+        HaveDataResult{status, requestIt->second.segmentCount, kNow - requestIt->second.sendTime};
+    m_haveDataCondVar.notify_all();
+    return true;
+}
+
+void FakeMediaPlayerClientBackend::handleAutomaticHaveData(firebolt::rialto::MediaSourceStatus status,
+                                                           const NeedDataRequest &request)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    const int32_t kSourceId{request.sourceId};
+    if (request.segmentCount == 0 && status != firebolt::rialto::MediaSourceStatus::EOS)
+    {
+        const size_t kFrameCount{m_streamingBehaviour->framesPerNeedData};
+        scheduleTaskUnlocked(m_streamingBehaviour->needDataRetryDelay,
+                             [this, kSourceId, kFrameCount]() { sendNeedDataInternal(kSourceId, kFrameCount, true); });
+        return;
+    }
+    m_prerolledSources.insert(kSourceId);
+    if (!m_isPrerolling || m_prerolledSources.size() < m_sourceIds.size())
+    {
+        return;
+    }
+    m_isPrerolling = false;
+    scheduleTaskUnlocked(m_streamingBehaviour->prerollDelay,
+                         [this]()
+                         {
+                             bool isPauseRequested{false};
+                             {
+                                 std::unique_lock<std::mutex> lock{m_mutex};
+                                 isPauseRequested = m_isPauseRequested;
+                             }
+                             notifyServerEvent(ServerEvent::PREROLLED, -1);
+                             auto client = m_client.lock();
+                             if (isPauseRequested && client)
+                             {
+                                 client->notifyPlaybackState(firebolt::rialto::PlaybackState::PAUSED);
+                             }
+                         });
+}
+
+firebolt::rialto::AddSegmentStatus FakeMediaPlayerClientBackend::addSegment(
+    unsigned int needDataRequestId, const std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> &mediaSegment)
+{
+    const size_t kDataLength{mediaSegment->getDataLength()};
+    std::unique_lock<std::mutex> lock{m_mutex};
+    auto requestIt = m_needDataRequests.find(needDataRequestId);
+    if (requestIt == m_needDataRequests.end() || kDataLength > m_buffer.size())
+    {
+        return firebolt::rialto::AddSegmentStatus::ERROR;
+    }
+    // The buffer works like the shared memory partition of the server, which is reused for every request
+    if (m_bufferOffset + kDataLength > m_buffer.size())
+    {
+        m_bufferOffset = 0;
+    }
+    std::memcpy(m_buffer.data() + m_bufferOffset, mediaSegment->getData(), kDataLength);
+    m_bufferOffset += kDataLength;
+    m_receivedBytes += kDataLength;
+    ++requestIt->second.segmentCount;
+    const int32_t kSourceId{requestIt->second.sourceId};
+    if (m_flushedSources.erase(kSourceId) > 0)
+    {
+        lock.unlock();
+        notifyServerEvent(ServerEvent::FIRST_SEGMENT_AFTER_FLUSH, kSourceId);
+    }
+    return firebolt::rialto::AddSegmentStatus::OK;
+}
+
+bool FakeMediaPlayerClientBackend::flush(int32_t sourceId, bool resetTime, bool &async)
+{
+    async = true;
+    notifyServerEvent(ServerEvent::FLUSH, sourceId);
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        if (m_streamingBehaviour)
+        {
+            m_isPrerolling = true;
+            m_prerolledSources.erase(sourceId);
+            m_flushedSources.insert(sourceId);
+            const size_t kFrameCount{m_streamingBehaviour->framesPerNeedData};
+            scheduleTaskUnlocked(m_streamingBehaviour->flushDelay,
+                                 [this, sourceId, kFrameCount]()
+                                 {
+                                     notifyServerEvent(ServerEvent::SOURCE_FLUSHED, sourceId);
+                                     if (auto client = m_client.lock())
+                                     {
+                                         client->notifySourceFlushed(sourceId);
+                                     }
+                                     sendNeedDataInternal(sourceId, kFrameCount, true);
+                                 });
+            return true;
+        }
+    }
+    if (auto client = m_client.lock())
+    {
+        client->notifySourceFlushed(sourceId);
+    }
+    return true;
+}
+
+void FakeMediaPlayerClientBackend::notifyServerEvent(ServerEvent event, int32_t sourceId)
+{
+    ServerEventCallback callback;
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        callback = m_serverEventCallback;
+    }
+    if (callback)
+    {
+        callback(event, sourceId);
+    }
+}
+
+void FakeMediaPlayerClientBackend::scheduleTaskUnlocked(const std::chrono::milliseconds &delay,
+                                                        std::function<void()> &&task)
+{
+    m_tasks.emplace(std::chrono::steady_clock::now() + delay, std::move(task));
+    m_tasksCondVar.notify_all();
+}
+
+void FakeMediaPlayerClientBackend::runTasks()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (m_isRunning)
+    {
+        if (m_tasks.empty())
+        {
+            m_tasksCondVar.wait(lock);
+            continue;
+        }
+        auto taskIt = m_tasks.begin();
+        if (taskIt->first > std::chrono::steady_clock::now())
+        {
+            m_tasksCondVar.wait_until(lock, taskIt->first);
+            continue;
+        }
+        std::function<void()> task{std::move(taskIt->second)};
+        m_tasks.erase(taskIt);
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
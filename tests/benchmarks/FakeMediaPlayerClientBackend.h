@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include "MediaPlayerClientBackendInterface.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// In-process stand-in for the Rialto server. Need data requests are sent on demand by the benchmark, segments are
+// copied into a memory buffer and state changes are confirmed immediately.
+// With server driven streaming enabled, the backend sends need data itself and delays flush and preroll like the
+// server does.
+class FakeMediaPlayerClientBackend : public firebolt::rialto::client::MediaPlayerClientBackendInterface
+{
+public:
+    struct HaveDataResult
+    {
+        firebolt::rialto::MediaSourceStatus status;
+        unsigned int segmentCount;
+        // Time between sending need data and receiving have data
+        std::chrono::nanoseconds latency;
+    };
+
+    // Need data is sent for every source after all sources are attached and after each flush, until the source
+    // answers with data. PAUSED is reported once all sources have data and pause was requested.
+    struct StreamingBehaviour
+    {
+        // Time between flush request and source flushed notification
+        std::chrono::milliseconds flushDelay{0};
+        // Time between receiving data for all sources and reporting PAUSED
+        std::chrono::milliseconds prerollDelay{0};
+        // Need data is sent again after this time, when the client had no samples
+        std::chrono::milliseconds needDataRetryDelay{15};
+        size_t framesPerNeedData{8};
+    };
+
+    enum class ServerEvent
+    {
+        FLUSH,
+        SOURCE_FLUSHED,
+        FIRST_SEGMENT_AFTER_FLUSH,
+        PREROLLED
+    };
+    using ServerEventCallback = std::function<void(ServerEvent event, int32_t sourceId)>;
+
+    explicit FakeMediaPlayerClientBackend(size_t bufferSize = kDefaultBufferSize);
+    ~FakeMediaPlayerClientBackend() override;
+
+    void enableServerDrivenStreaming(const StreamingBehaviour &behaviour);
+    // Called from server threads, sourceId is -1 for events which are not related to a single source
+    void setServerEventCallback(const ServerEventCallback &callback);
+
+    // Sends need data to the client and returns its id without waiting for the answer
+    uint32_t sendNeedData(int32_t sourceId, size_t frameCount);
+    std::optional<HaveDataResult> waitForHaveData(uint32_t needDataRequestId, const std::chrono::milliseconds &timeout);
+    std::optional<HaveDataResult> requestData(int32_t sourceId, size_t frameCount,
+                                              const std::chrono::milliseconds &timeout);
+    uint64_t getReceivedBytes() const;
+    std::vector<int32_t> getSourceIds() const;
+    void assignSourceId(firebolt::rialto::IMediaPipeline::MediaSource &source);
+
+    void createMediaPlayerBackend(std::weak_ptr<firebolt::rialto::IMediaPipelineClient> client, uint32_t maxWidth,
+                                  uint32_t maxHeight) override;
+    bool isMediaPlayerBackendCreated() const override;
+    bool attachSource(std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> &source) override;
+    bool removeSource(int32_t id) override;
+    bool allSourcesAttached() override;
+    bool load(firebolt::rialto::MediaType type, const std::string &mimeType, const std::string &url,
+              bool isLive) override
+    {
+        return true;
+    }
+    bool play(bool &async) override;
+    bool pause() override;
+    bool stop() override;
+    bool haveData(firebolt::rialto::MediaSourceStatus status, unsigned int needDataRequestId) override;
+    bool setPlaybackRate(double rate) override { return true; }
+    bool setVideoWindow(unsigned int x, unsigned int y, unsigned int width, unsigned int height) override
+    {
+        return true;
+    }
+    firebolt::rialto::AddSegmentStatus
+    addSegment(unsigned int needDataRequestId,
+               const std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> &mediaSegment) override;
+    bool getPosition(int64_t &position) override { return false; }
+    bool getDuration(int64_t &duration) override { return false; }
+    bool setImmediateOutput(int32_t sourceId, bool immediateOutput) override { return true; }
+    bool getImmediateOutput(int32_t sourceId, bool &immediateOutput) override { return false; }
+    bool getStats(int32_t sourceId, uint64_t &renderedFrames, uint64_t &droppedFrames) override { return false; }
+    bool renderFrame() override { return true; }
+    bool setVolume(double targetVolume, uint32_t volumeDuration, firebolt::rialto::EaseType easeType) override
+    {
+        return true;
+    }
+    bool getVolume(double &currentVolume) override { return false; }
+    bool setMute(bool mute, int sourceId) override { return true; }
+    bool getMute(bool &mute, int sourceId) override { return false; }
+    bool setTextTrackIdentifier(const std::string &textTrackIdentifier) override { return true; }
+    bool getTextTrackIdentifier(std::string &textTrackIdentifier) override { return false; }
+    bool setLowLatency(bool lowLatency) override { return true; }
+    bool setSync(bool sync) override { return true; }
+    bool getSync(bool &sync) override { return false; }
+    bool setSyncOff(bool syncOff) override { return true; }
+    bool setStreamSyncMode(int32_t sourceId, int32_t streamSyncMode) override { return true; }
+    bool getStreamSyncMode(int32_t &streamSyncMode) override { return false; }
+    bool flush(int32_t sourceId, bool resetTime, bool &async) override;
+    bool setSourcePosition(int32_t sourceId, int64_t position, bool resetTime, double appliedRate,
+                           uint64_t stopPosition) override
+    {
+        return true;
+    }
+    bool setSubtitleOffset(int32_t sourceId, int64_t position) override { return true; }
+    bool processAudioGap(int64_t position, uint32_t duration, int64_t discontinuityGap, bool audioAac) override
+    {
+        return true;
+    }
+    bool setBufferingLimit(uint32_t limitBufferingMs) override { return true; }
+    bool getBufferingLimit(uint32_t &limitBufferingMs) override { return false; }
+    bool setUseBuffering(bool useBuffering) override { return true; }
+    bool getUseBuffering(bool &useBuffering) override { return false; }
+    bool switchSource(const std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> &source) override
+    {
+        return true;
+    }
+
+private:
+    static constexpr size_t kDefaultBufferSize{8 * 1024 * 1024};
+
+    struct NeedDataRequest
+    {
+        std::chrono::steady_clock::time_point sendTime;
+        unsigned int segmentCount;
+        std::optional<HaveDataResult> result;
+        int32_t sourceId;
+        // Sent by the backend itself in server driven streaming, nobody waits for the result
+        bool isAutomatic;
+    };
+
+    uint32_t sendNeedDataInternal(int32_t sourceId, size_t frameCount, bool isAutomatic);
+    void handleAutomaticHaveData(firebolt::rialto::MediaSourceStatus status, const NeedDataRequest &request);
+    void notifyServerEvent(ServerEvent event, int32_t sourceId);
+    // Must be called with m_mutex locked
+    void scheduleTaskUnlocked(const std::chrono::milliseconds &delay, std::function<void()> &&task);
+    void runTasks();
+
+    std::weak_ptr<firebolt::rialto::IMediaPipelineClient> m_client;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_haveDataCondVar;
+    std::unordered_map<uint32_t, NeedDataRequest> m_needDataRequests;
+    uint32_t m_lastNeedDataRequestId{0};
+    int32_t m_lastSourceId{0};
+    std::vector<uint8_t> m_buffer;
+    size_t m_bufferOffset{0};
+    uint64_t m_receivedBytes{0};
+
+    std::optional<StreamingBehaviour> m_streamingBehaviour;
+    ServerEventCallback m_serverEventCallback;
+    std::set<int32_t> m_sourceIds;
+    std::set<int32_t> m_prerolledSources;
+    // Sources which have been flushed and did not send any segment since
+    std::set<int32_t> m_flushedSources;
+    bool m_isPrerolling{false};
+    bool m_isPauseRequested{false};
+
+    // Delayed tasks of server driven streaming, run by m_taskThread
+    std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> m_tasks;
+    std::condition_variable m_tasksCondVar;
+    bool m_isRunning{true};
+    std::thread m_taskThread;
+};
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include "IPullModePlaybackDelegate.h"
+
+#include <atomic>
+#include <cstdint>
+
+// Serves the same sample for every pull, so that the measurement does not include the upstream pipeline
+class FakePullModePlaybackDelegate : public IPullModePlaybackDelegate
+{
+public:
+    explicit FakePullModePlaybackDelegate(GstSample *sample) : m_sample{gst_sample_ref(sample)} {}
+    ~FakePullModePlaybackDelegate() override { gst_sample_unref(m_sample); }
+
+    uint64_t getPoppedSamples() const { return m_poppedSamples; }
+
+    void setSourceId(int32_t sourceId) override {}
+    void handleEos() override {}
+    void handleFlushCompleted() override {}
+    void handleStateChanged(firebolt::rialto::PlaybackState state) override {}
+    void handleError(const std::string &message, gint code) override {}
+    void handleQos(uint64_t processed, uint64_t dropped) const override {}
+    GstStateChangeReturn changeState(GstStateChange transition) override { return GST_STATE_CHANGE_SUCCESS; }
+    void postAsyncStart() override {}
+    void setProperty(const Property &type, const GValue *value) override {}
+    void getProperty(const Property &type, GValue *value) override {}
+    std::optional<gboolean> handleQuery(GstQuery *query) const override { return std::nullopt; }
+    gboolean handleSendEvent(GstEvent *event) override { return TRUE; }
+    gboolean handleEvent(GstPad *pad, GstObject *parent, GstEvent *event) override { return TRUE; }
+    GstFlowReturn handleBuffer(GstBuffer *buffer) override { return GST_FLOW_OK; }
+    GstRefSample getFrontSample(uint64_t &sampleIndex) const override
+    {
+        sampleIndex = m_poppedSamples;
+        return GstRefSample{m_sample};
+    }
+    GstRefSample getSample(size_t position, uint64_t &sampleIndex) const override
+    {
+        sampleIndex = m_poppedSamples + position;
+        return GstRefSample{m_sample};
+    }
+    void popSample() override { ++m_poppedSamples; }
+    bool isEos() const override { return false; }
+    void lostState() override {}
+    bool isReadyToSendData() const override { return true; }
+
+private:
+    GstSample *m_sample;
+    std::atomic<uint64_t> m_poppedSamples{0};
+};
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BenchmarkUtils.h"
+#include "IMessageQueue.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using MessageQueueFactoryCreator = std::function<std::shared_ptr<IMessageQueueFactory>()>;
+
+// Queue implementations under test. Alternative designs are compared by adding their factory here.
+const std::vector<std::pair<std::string, MessageQueueFactoryCreator>> kMessageQueueFactories{
+    {"MessageQueue", &IMessageQueueFactory::createFactory}};
+
+// When pinned, the event loop runs on the first allowed cpu and each other thread on a cpu of its own
+constexpr unsigned kEventLoopCpu{0};
+constexpr unsigned kFirstProducerCpu{1};
+constexpr size_t kMessagesPerProducer{10000};
+// Background producers are throttled, so that the queue does not grow without limit when the event loop is slower
+constexpr uint64_t kMaxMessagesInFlight{64};
+
+// Records time from its creation, just before it is posted, until it is handled. Latency samples are written only by
+// the event loop thread and read by the benchmark thread once all messages are handled.
+class TimestampedMessage : public Message
+{
+public:
+    TimestampedMessage(LatencySamples &latency, std::atomic<uint64_t> &handledCount)
+        : m_postTime{std::chrono::steady_clock::now()}, m_latency{latency}, m_handledCount{handledCount}
+    {
+    }
+
+    void handle() override
+    {
+        m_latency.add(std::chrono::steady_clock::now() - m_postTime);
+        m_handledCount.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    const std::chrono::steady_clock::time_point m_postTime;
+    LatencySamples &m_latency;
+    std::atomic<uint64_t> &m_handledCount;
+};
+
+class BackgroundMessage : public Message
+{
+public:
+    explicit BackgroundMessage(std::atomic<uint64_t> &inFlightCount) : m_inFlightCount{inFlightCount} {}
+
+    void handle() override { m_inFlightCount.fetch_sub(1, std::memory_order_relaxed); }
+    void skip() override { m_inFlightCount.fetch_sub(1, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> &m_inFlightCount;
+};
+
+// Keeps the queue busy with up to kMaxMessagesInFlight messages from the given number of threads
+class BackgroundProducers
+{
+public:
+    BackgroundProducers(IMessageQueue &queue, unsigned count, bool isPinned)
+    {
+        for (unsigned i = 0; i < count; ++i)
+        {
+            m_threads.emplace_back(
+                [this, &queue, i, isPinned]()
+                {
+                    if (isPinned)
+                        pinCurrentThread(kFirstProducerCpu + 1 + i);
+                    while (m_isRunning)
+                    {
+                        if (m_inFlightCount.fetch_add(1, std::memory_order_relaxed) >= kMaxMessagesInFlight ||
+                            !queue.postMessage(std::make_shared<BackgroundMessage>(m_inFlightCount)))
+                        {
+                            m_inFlightCount.fetch_sub(1, std::memory_order_relaxed);
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+        }
+    }
+
+    ~BackgroundProducers()
+    {
+        m_isRunning = false;
+        for (auto &thread : m_threads)
+        {
+            thread.join();
+        }
+        // Messages still in the queue refer to the in flight counter
+        while (m_inFlightCount.load(std::memory_order_relaxed) > 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    std::atomic<bool> m_isRunning{true};
+    std::atomic<uint64_t> m_inFlightCount{0};
+    std::vector<std::thread> m_threads;
+};
+
+std::unique_ptr<IMessageQueue> startQueue(const MessageQueueFactoryCreator &createFactory, bool isPinned)
+{
+    std::unique_ptr<IMessageQueue> queue{createFactory()->createMessageQueue()};
+    queue->start();
+    if (isPinned)
+    {
+        queue->callInEventLoop([]() { pinCurrentThread(kEventLoopCpu); });
+    }
+    return queue;
+}
+
+void waitForHandledCount(const std::atomic<uint64_t> &handledCount, uint64_t expectedCount)
+{
+    while (handledCount.load(std::memory_order_acquire) < expectedCount)
+    {
+        std::this_thread::yield();
+    }
+}
+
+// Latency of a single message posted to an idle queue, i.e. the cost of waking up the event loop.
+// Arguments: pinned
+void postToHandle(benchmark::State &state, const MessageQueueFactoryCreator &createFactory)
+{
+    const bool kIsPinned{state.range(0) != 0};
+    std::optional<ScopedCpuAffinity> affinity;
+    if (kIsPinned)
+        affinity.emplace(kFirstProducerCpu);
+    std::unique_ptr<IMessageQueue> queue{startQueue(createFactory, kIsPinned)};
+
+    LatencySamples latency;
+    latency.reserve(state.max_iterations);
+    std::atomic<uint64_t> handledCount{0};
+    uint64_t postedCount{0};
+    for (auto _ : state)
+    {
+        if (!queue->postMessage(std::make_shared<TimestampedMessage>(latency, handledCount)))
+        {
+            state.SkipWithError("Could not post message");
+            break;
+        }
+        waitForHandledCount(handledCount, ++postedCount);
+    }
+    queue->stop();
+    latency.report(state, "post_to_handle_");
+}
+
+// Round trip of callInEventLoop with an empty function, optionally while other threads keep the queue busy.
+// Arguments: pinned, number of background producers
+void callInEventLoopRoundTrip(benchmark::State &state, const MessageQueueFactoryCreator &createFactory,
+                              bool isHighPriority)
+{
+    const bool kIsPinned{state.range(0) != 0};
+    std::optional<ScopedCpuAffinity> affinity;
+    if (kIsPinned)
+        affinity.emplace(kFirstProducerCpu);
+    std::unique_ptr<IMessageQueue> queue{startQueue(createFactory, kIsPinned)};
+
+    LatencySamples latency;
+    latency.reserve(state.max_iterations);
+    {
+        BackgroundProducers producers{*queue, static_cast<unsigned>(state.range(1)), kIsPinned};
+        for (auto _ : state)
+        {
+            const auto kStart{std::chrono::steady_clock::now()};
+            const bool kResult{isHighPriority ? queue->callInEventLoopWithPriority([]() {})
+                                              : queue->callInEventLoop([]() {})};
+            latency.add(std::chrono::steady_clock::now() - kStart);
+            if (!kResult)
+            {
+                state.SkipWithError("Could not call in event loop");
+                break;
+            }
+        }
+    }
+    queue->stop();
+    latency.report(state, "round_trip_");
+}
+
+// Throughput of N threads posting kMessagesPerProducer messages each, as fast as they can.
+// Arguments: pinned, number of producers
+void producerThroughput(benchmark::State &state, const MessageQueueFactoryCreator &createFactory)
+{
+    const bool kIsPinned{state.range(0) != 0};
+    const unsigned kProducerCount{static_cast<unsigned>(state.range(1))};
+    std::unique_ptr<IMessageQueue> queue{startQueue(createFactory, kIsPinned)};
+
+    LatencySamples latency;
+    std::atomic<uint64_t> handledCount{0};
+    std::atomic<bool> isPostFailed{false};
+    uint64_t postedCount{0};
+    for (auto _ : state)
+    {
+        std::vector<std::thread> producers;
+        for (unsigned i = 0; i < kProducerCount; ++i)
+        {
+            producers.emplace_back(
+                [&, i]()
+                {
+                    if (kIsPinned)
+                        pinCurrentThread(kFirstProducerCpu + i);
+                    for (size_t message = 0; message < kMessagesPerProducer; ++message)
+                    {
+                        if (!queue->postMessage(std::make_shared<TimestampedMessage>(latency, handledCount)))
+                        {
+                            isPostFailed = true;
+                            return;
+                        }
+                    }
+                });
+        }
+        for (auto &producer : producers)
+        {
+            producer.join();
+        }
+        if (isPostFailed)
+        {
+            state.SkipWithError("Could not post message");
+            break;
+        }
+        postedCount += kProducerCount * kMessagesPerProducer;
+        waitForHandledCount(handledCount, postedCount);
+    }
+    queue->stop();
+
+    state.SetItemsProcessed(postedCount);
+    latency.report(state, "post_to_handle_");
+}
+
+bool registerMessageQueueBenchmarks()
+{
+    for (const auto &[kName, kCreateFactory] : kMessageQueueFactories)
+    {
+        benchmark::RegisterBenchmark(("postToHandle/" + kName).c_str(), postToHandle, kCreateFactory)
+            ->ArgName("pinned")
+            ->DenseRange(0, 1)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("callInEventLoop/" + kName).c_str(), callInEventLoopRoundTrip, kCreateFactory,
+                                     false)
+            ->ArgNames({"pinned", "producers"})
+            ->ArgsProduct({{0, 1}, {0, 1, 4}})
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("callInEventLoopWithPriority/" + kName).c_str(), callInEventLoopRoundTrip,
+                                     kCreateFactory, true)
+            ->ArgNames({"pinned", "producers"})
+            ->ArgsProduct({{0, 1}, {0, 1, 4}})
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("producerThroughput/" + kName).c_str(), producerThroughput, kCreateFactory)
+            ->ArgNames({"pinned", "producers"})
+            ->ArgsProduct({{0, 1}, {1, 2, 4, 8}})
+            ->UseRealTime();
+    }
+    return true;
+}
+
+const bool kAreMessageQueueBenchmarksRegistered{registerMessageQueueBenchmarks()};
+} // namespace
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BenchmarkUtils.h"
+#include "FakeMediaPlayerClientBackend.h"
+#include "FakePullModePlaybackDelegate.h"
+#include "GStreamerMSEMediaPlayerClient.h"
+#include "SampleFactory.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace
+{
+constexpr std::chrono::milliseconds kHaveDataTimeout{1000};
+// Typical frames of 128 kbit/s AAC at 48 kHz and 8 Mbit/s H.264 at 25 fps
+constexpr size_t kAudioFrameSize{768};
+constexpr size_t kVideoFrameSize{40000};
+constexpr int64_t kAudioFrameDuration{21333333};
+constexpr int64_t kVideoFrameDuration{40000000};
+
+GstSample *buildSample(firebolt::rialto::MediaSourceType type, bool isEncrypted)
+{
+    const bool kIsAudio{type == firebolt::rialto::MediaSourceType::AUDIO};
+    GstBuffer *buffer{kIsAudio ? createBuffer(kAudioFrameSize, 0, kAudioFrameDuration)
+                               : createBuffer(kVideoFrameSize, 0, kVideoFrameDuration)};
+    GstCaps *caps{kIsAudio ? createAacCaps() : createH264Caps()};
+    if (isEncrypted)
+    {
+        // Video frames are usually split into a clear NAL header and an encrypted payload per slice
+        addProtectionMetadata(buffer, EncryptionParams{"cenc", kIsAudio ? 1u : 4u});
+        caps = createEncryptedCaps(caps);
+    }
+    return createSample(buffer, caps);
+}
+
+std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> createMediaSource(firebolt::rialto::MediaSourceType type,
+                                                                                 bool isEncrypted)
+{
+    if (type == firebolt::rialto::MediaSourceType::AUDIO)
+    {
+        return std::make_unique<firebolt::rialto::IMediaPipeline::MediaSourceAudio>("audio/mp4", isEncrypted);
+    }
+    return std::make_unique<firebolt::rialto::IMediaPipeline::MediaSourceVideo>("video/h264", isEncrypted);
+}
+
+// Measures the path from need data to have data: NeedDataMessage, PullBufferMessage with BufferParser, addSegment
+// and HaveDataMessage, all going through the real message queues.
+// Arguments: frames per need data request, interval between need data requests in us (0 - send back to back)
+void pullPath(benchmark::State &state, firebolt::rialto::MediaSourceType type, bool isEncrypted)
+{
+    const size_t kFramesPerRequest{static_cast<size_t>(state.range(0))};
+    const std::chrono::microseconds kRequestInterval{state.range(1)};
+
+    auto backend{std::make_shared<FakeMediaPlayerClientBackend>()};
+    auto client{std::make_shared<GStreamerMSEMediaPlayerClient>(IMessageQueueFactory::createFactory(), backend, 0, 0,
+                                                                false)};
+    if (!client->createBackend())
+    {
+        state.SkipWithError("Could not create media player backend");
+        return;
+    }
+    GstSample *sample{buildSample(type, isEncrypted)};
+    auto delegate{std::make_shared<FakePullModePlaybackDelegate>(sample)};
+    gst_sample_unref(sample);
+    auto source{createMediaSource(type, isEncrypted)};
+    // Sink element is used only for logging on the pull path
+    if (!client->attachSource(source, nullptr, delegate))
+    {
+        state.SkipWithError("Could not attach source");
+        return;
+    }
+    const int32_t kSourceId{source->getId()};
+
+    LatencySamples latency;
+    latency.reserve(state.max_iterations);
+    uint64_t frames{0};
+    const uint64_t kAllocationsBefore{AllocationCounter::count()};
+    auto nextRequestTime{std::chrono::steady_clock::now()};
+    for (auto _ : state)
+    {
+        const auto kResult{backend->requestData(kSourceId, kFramesPerRequest, kHaveDataTimeout)};
+        if (!kResult || kResult->status != firebolt::rialto::MediaSourceStatus::OK)
+        {
+            state.SkipWithError("Need data was not answered with data");
+            break;
+        }
+        latency.add(kResult->latency);
+        frames += kResult->segmentCount;
+        if (kRequestInterval.count() > 0)
+        {
+            state.PauseTiming();
+            nextRequestTime += kRequestInterval;
+            std::this_thread::sleep_until(nextRequestTime);
+            state.ResumeTiming();
+        }
+    }
+    const uint64_t kAllocations{AllocationCounter::count() - kAllocationsBefore};
+
+    if (frames > 0)
+    {
+        state.counters["frames/s"] = benchmark::Counter(frames, benchmark::Counter::kIsRate);
+        state.counters["ns/frame"] = static_cast<double>(latency.sum()) / frames;
+        state.counters["allocs/frame"] = static_cast<double>(kAllocations) / frames;
+    }
+    state.SetBytesProcessed(backend->getReceivedBytes());
+    latency.report(state, "have_data_");
+}
+
+void pullPathArguments(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->ArgNames({"frames", "interval_us"})->ArgsProduct({{1, 8, 24}, {0, 10000}})->UseRealTime();
+}
+} // namespace
+
+BENCHMARK_CAPTURE(pullPath, ClearAudio, firebolt::rialto::MediaSourceType::AUDIO, false)->Apply(pullPathArguments);
+BENCHMARK_CAPTURE(pullPath, EncryptedAudio, firebolt::rialto::MediaSourceType::AUDIO, true)->Apply(pullPathArguments);
+BENCHMARK_CAPTURE(pullPath, ClearVideo, firebolt::rialto::MediaSourceType::VIDEO, false)->Apply(pullPathArguments);
+BENCHMARK_CAPTURE(pullPath, EncryptedVideo, firebolt::rialto::MediaSourceType::VIDEO, true)->Apply(pullPathArguments);
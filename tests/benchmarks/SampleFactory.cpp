@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "SampleFactory.h"
+#include "RialtoGStreamerEMEProtectionMetadata.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+constexpr size_t kKeyIdSize{16};
+constexpr size_t kIvSize{16};
+constexpr size_t kSubsampleEntrySize{sizeof(uint16_t) + sizeof(uint32_t)};
+constexpr int kMediaKeySessionId{1};
+constexpr unsigned int kCbcsCryptByteBlock{1};
+constexpr unsigned int kCbcsSkipByteBlock{9};
+
+GstBuffer *createFilledBuffer(size_t size, uint8_t value)
+{
+    GstBuffer *buffer = gst_buffer_new_allocate(nullptr, size, nullptr);
+    gst_buffer_memset(buffer, 0, value, size);
+    return buffer;
+}
+
+GstBuffer *createSubsamplesBuffer(size_t dataSize, unsigned int subsampleCount)
+{
+    // 'senc' layout: big endian uint16 BytesOfClearData followed by uint32 BytesOfEncryptedData
+    std::vector<uint8_t> subsamples(subsampleCount * kSubsampleEntrySize);
+    const size_t kSubsampleSize{dataSize / subsampleCount};
+    const uint16_t kClearBytes{static_cast<uint16_t>(std::min<size_t>(kSubsampleSize / 8, UINT16_MAX))};
+    const uint32_t kEncryptedBytes{static_cast<uint32_t>(kSubsampleSize - kClearBytes)};
+    for (unsigned int i = 0; i < subsampleCount; ++i)
+    {
+        uint8_t *entry = subsamples.data() + i * kSubsampleEntrySize;
+        entry[0] = kClearBytes >> 8;
+        entry[1] = kClearBytes & 0xFF;
+        entry[2] = kEncryptedBytes >> 24;
+        entry[3] = (kEncryptedBytes >> 16) & 0xFF;
+        entry[4] = (kEncryptedBytes >> 8) & 0xFF;
+        entry[5] = kEncryptedBytes & 0xFF;
+    }
+    GstBuffer *buffer = gst_buffer_new_allocate(nullptr, subsamples.size(), nullptr);
+    gst_buffer_fill(buffer, 0, subsamples.data(), subsamples.size());
+    return buffer;
+}
+
+GstBuffer *createBufferFromBytes(const std::vector<uint8_t> &bytes)
+{
+    GstBuffer *buffer = gst_buffer_new_allocate(nullptr, bytes.size(), nullptr);
+    gst_buffer_fill(buffer, 0, bytes.data(), bytes.size());
+    return buffer;
+}
+} // namespace
+
+GstBuffer *createBuffer(size_t size, int64_t timestamp, int64_t duration)
+{
+    GstBuffer *buffer = createFilledBuffer(size, 0xAB);
+    GST_BUFFER_PTS(buffer) = timestamp;
+    GST_BUFFER_DURATION(buffer) = duration;
+    return buffer;
+}
+
+void addProtectionMetadata(GstBuffer *buffer, const EncryptionParams &params)
+{
+    const bool kIsCbcs{params.cipherMode == "cbcs"};
+    GstBuffer *keyId = createFilledBuffer(kKeyIdSize, 0x01);
+    GstBuffer *iv = createFilledBuffer(kIvSize, 0x02);
+    GstStructure *info = gst_structure_new("application/x-cenc", "encrypted", G_TYPE_BOOLEAN, TRUE, "mks_id",
+                                           G_TYPE_INT, kMediaKeySessionId, "kid", GST_TYPE_BUFFER, keyId, "iv",
+                                           GST_TYPE_BUFFER, iv, "cipher-mode", G_TYPE_STRING,
+                                           params.cipherMode.c_str(), nullptr);
+    if (kIsCbcs)
+    {
+        gst_structure_set(info, "iv_size", G_TYPE_UINT, 0, "constant_iv_size", G_TYPE_UINT,
+                          static_cast<guint>(kIvSize), "crypt_byte_block", G_TYPE_UINT, kCbcsCryptByteBlock,
+                          "skip_byte_block", G_TYPE_UINT, kCbcsSkipByteBlock, nullptr);
+    }
+    else
+    {
+        gst_structure_set(info, "iv_size", G_TYPE_UINT, static_cast<guint>(kIvSize), nullptr);
+    }
+    if (params.subsampleCount > 0)
+    {
+        GstBuffer *subsamples = createSubsamplesBuffer(gst_buffer_get_size(buffer), params.subsampleCount);
+        gst_structure_set(info, "subsample_count", G_TYPE_UINT, params.subsampleCount, "subsamples", GST_TYPE_BUFFER,
+                          subsamples, nullptr);
+        gst_buffer_unref(subsamples);
+    }
+    rialto_mse_add_protection_metadata(buffer, info);
+    gst_buffer_unref(iv);
+    gst_buffer_unref(keyId);
+}
+
+GstCaps *createAacCaps()
+{
+    GstBuffer *codecData = createBufferFromBytes({0x11, 0x90});
+    GstCaps *caps = gst_caps_new_simple("audio/mpeg", "mpegversion", G_TYPE_INT, 4, "stream-format", G_TYPE_STRING,
+                                        "raw", "rate", G_TYPE_INT, 48000, "channels", G_TYPE_INT, 2, "codec_data",
+                                        GST_TYPE_BUFFER, codecData, nullptr);
+    gst_buffer_unref(codecData);
+    return caps;
+}
+
+GstCaps *createEac3Caps()
+{
+    return gst_caps_new_simple("audio/x-eac3", "framed", G_TYPE_BOOLEAN, TRUE, "alignment", G_TYPE_STRING, "frame",
+                               "rate", G_TYPE_INT, 48000, "channels", G_TYPE_INT, 6, nullptr);
+}
+
+GstCaps *createOpusCaps()
+{
+    // OpusHead and OpusTags packets, as set by matroskademux
+    GstBuffer *opusHead = createBufferFromBytes({'O', 'p', 'u', 's', 'H', 'e', 'a', 'd', 0x01, 0x02, 0x38, 0x01,
+                                                 0x80, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x00});
+    GstBuffer *opusTags = createBufferFromBytes({'O', 'p', 'u', 's', 'T', 'a', 'g', 's', 0x00, 0x00, 0x00, 0x00,
+                                                 0x00, 0x00, 0x00, 0x00});
+    GValue streamHeader = G_VALUE_INIT;
+    GValue header = G_VALUE_INIT;
+    g_value_init(&streamHeader, GST_TYPE_ARRAY);
+    for (GstBuffer *buffer : {opusHead, opusTags})
+    {
+        g_value_init(&header, GST_TYPE_BUFFER);
+        gst_value_set_buffer(&header, buffer);
+        gst_value_array_append_value(&streamHeader, &header);
+        g_value_unset(&header);
+        gst_buffer_unref(buffer);
+    }
+    GstCaps *caps = gst_caps_new_simple("audio/x-opus", "channel-mapping-family", G_TYPE_INT, 0, "rate", G_TYPE_INT,
+                                        48000, "channels", G_TYPE_INT, 2, nullptr);
+    gst_structure_take_value(gst_caps_get_structure(caps, 0), "streamheader", &streamHeader);
+    return caps;
+}
+
+GstCaps *createH264Caps()
+{
+    GstBuffer *codecData = createBufferFromBytes({0x01, 0x64, 0x00, 0x28, 0xFF, 0xE1, 0x00, 0x04, 0x67, 0x64,
+                                                  0x00, 0x28, 0x01, 0x00, 0x04, 0x68, 0xEE, 0x3C, 0x80});
+    GstCaps *caps = gst_caps_new_simple("video/x-h264", "stream-format", G_TYPE_STRING, "avc", "alignment",
+                                        G_TYPE_STRING, "au", "width", G_TYPE_INT, 1920, "height", G_TYPE_INT, 1080,
+                                        "framerate", GST_TYPE_FRACTION, 25, 1, "codec_data", GST_TYPE_BUFFER,
+                                        codecData, nullptr);
+    gst_buffer_unref(codecData);
+    return caps;
+}
+
+GstCaps *createHevcCaps()
+{
+    // hvcC box is dominated by VPS, SPS and PPS, so a record of a typical size is enough
+    std::vector<uint8_t> hvcC{0x01, 0x02, 0x20, 0x00, 0x00, 0x00, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x99,
+                              0xF0, 0x00, 0xFC, 0xFD, 0xFA, 0xFA, 0x00, 0x00, 0x0F, 0x03};
+    hvcC.resize(120, 0x42);
+    GstBuffer *codecData = createBufferFromBytes(hvcC);
+    GstCaps *caps = gst_caps_new_simple("video/x-h265", "stream-format", G_TYPE_STRING, "hvc1", "alignment",
+                                        G_TYPE_STRING, "au", "width", G_TYPE_INT, 3840, "height", G_TYPE_INT, 2160,
+                                        "framerate", GST_TYPE_FRACTION, 50, 1, "codec_data", GST_TYPE_BUFFER,
+                                        codecData, nullptr);
+    gst_buffer_unref(codecData);
+    return caps;
+}
+
+GstCaps *createAv1Caps()
+{
+    // av1C header followed by the sequence header OBU
+    GstBuffer *codecData =
+        createBufferFromBytes({0x81, 0x08, 0x0C, 0x00, 0x0A, 0x0B, 0x00, 0x00, 0x00, 0x42, 0xAB, 0xBF, 0xC3, 0x71});
+    GstCaps *caps = gst_caps_new_simple("video/x-av1", "stream-format", G_TYPE_STRING, "obu-stream", "alignment",
+                                        G_TYPE_STRING, "tu", "width", G_TYPE_INT, 3840, "height", G_TYPE_INT, 2160,
+                                        "framerate", GST_TYPE_FRACTION, 60, 1, "codec_data", GST_TYPE_BUFFER,
+                                        codecData, nullptr);
+    gst_buffer_unref(codecData);
+    return caps;
+}
+
+GstCaps *createTtmlCaps()
+{
+    return gst_caps_new_empty_simple("application/ttml+xml");
+}
+
+GstCaps *createEncryptedCaps(GstCaps *caps)
+{
+    GstCaps *encryptedCaps = gst_caps_make_writable(caps);
+    GstStructure *structure = gst_caps_get_structure(encryptedCaps, 0);
+    gst_structure_set(structure, "original-media-type", G_TYPE_STRING, gst_structure_get_name(structure),
+                      "protection-system", G_TYPE_STRING, "9a04f079-9840-4286-ab92-e65be0885f95", nullptr);
+    gst_structure_set_name(structure, "application/x-cenc");
+    return encryptedCaps;
+}
+
+GstSample *createSample(GstBuffer *buffer, GstCaps *caps)
+{
+    GstSample *sample = gst_sample_new(buffer, caps, nullptr, nullptr);
+    gst_buffer_unref(buffer);
+    gst_caps_unref(caps);
+    return sample;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <gst/gst.h>
+
+#include <cstdint>
+#include <string>
+
+// Synthetic samples shaped like the ones produced by qtdemux and the decryptor in the field
+struct EncryptionParams
+{
+    std::string cipherMode{"cenc"};
+    unsigned int subsampleCount{1};
+};
+
+GstBuffer *createBuffer(size_t size, int64_t timestamp = 0, int64_t duration = 0);
+void addProtectionMetadata(GstBuffer *buffer, const EncryptionParams &params);
+GstCaps *createAacCaps();
+GstCaps *createEac3Caps();
+GstCaps *createOpusCaps();
+GstCaps *createH264Caps();
+GstCaps *createHevcCaps();
+GstCaps *createAv1Caps();
+GstCaps *createTtmlCaps();
+// Wraps the caps into application/x-cenc the same way as the protection decryptor elements do
+GstCaps *createEncryptedCaps(GstCaps *caps);
+// Takes ownership of the buffer and caps
+GstSample *createSample(GstBuffer *buffer, GstCaps *caps);
@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BenchmarkUtils.h"
+#include "FakeMediaPlayerClientBackend.h"
+#include "RialtoGStreamerMSEAudioSink.h"
+#include "RialtoGStreamerMSEVideoSink.h"
+#include "SampleFactory.h"
+#include "SinkEnvironment.h"
+#include "StandInServer.h"
+
+#include <benchmark/benchmark.h>
+#include <gst/gst.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::chrono::milliseconds kHaveDataTimeout{1000};
+// Every tick sends need data to all sources of all pipelines at once, like the server does at the start of playback
+constexpr std::chrono::milliseconds kTickInterval{10};
+// Time for the feeders to fill the queues of the sinks before the first need data
+constexpr std::chrono::milliseconds kFillTime{100};
+constexpr int64_t kTicks{300};
+constexpr size_t kFramesPerRequest{8};
+constexpr size_t kAudioFrameSize{768};
+constexpr size_t kVideoFrameSize{40000};
+constexpr int64_t kAudioFrameDuration{21333333};
+constexpr int64_t kVideoFrameDuration{40000000};
+
+struct Stream
+{
+    GstElement *sink;
+    GstPad *pad;
+    GstCaps *(*createCaps)();
+    size_t frameSize;
+    int64_t frameDuration;
+    std::thread feeder;
+};
+
+// Stand-in for a playbin with a rialto audio and video sink. Buffers are pushed to the sink pads by a feeder thread per
+// stream, as a demuxer would do, and block in the sink while its queue is full until the server asks for data.
+struct Pipeline
+{
+    GstElement *pipeline{nullptr};
+    std::vector<Stream> streams;
+    std::atomic<bool> isFeeding{false};
+    LatencySamples startLatency;
+    LatencySamples stopLatency;
+};
+
+std::unique_ptr<Pipeline> createPipeline()
+{
+    auto pipeline{std::make_unique<Pipeline>()};
+    pipeline->pipeline = gst_pipeline_new(nullptr);
+    pipeline->streams.push_back({GST_ELEMENT_CAST(g_object_new(RIALTO_TYPE_MSE_AUDIO_SINK, nullptr)), nullptr,
+                                 createAacCaps, kAudioFrameSize, kAudioFrameDuration, {}});
+    pipeline->streams.push_back({GST_ELEMENT_CAST(g_object_new(RIALTO_TYPE_MSE_VIDEO_SINK, nullptr)), nullptr,
+                                 createH264Caps, kVideoFrameSize, kVideoFrameDuration, {}});
+    for (auto &stream : pipeline->streams)
+    {
+        gst_bin_add(GST_BIN(pipeline->pipeline), stream.sink);
+        stream.pad = gst_element_get_static_pad(stream.sink, "sink");
+    }
+    return pipeline;
+}
+
+void feed(const std::atomic<bool> &isFeeding, const Stream &stream)
+{
+    int64_t timestamp{0};
+    while (isFeeding)
+    {
+        if (gst_pad_chain(stream.pad, createBuffer(stream.frameSize, timestamp, stream.frameDuration)) != GST_FLOW_OK)
+        {
+            break;
+        }
+        timestamp += stream.frameDuration;
+    }
+}
+
+// Sources are attached to the server when the sinks handle their caps, as in a playbin
+bool startPipeline(Pipeline &pipeline)
+{
+    const auto kStart{std::chrono::steady_clock::now()};
+    if (gst_element_set_state(pipeline.pipeline, GST_STATE_PAUSED) == GST_STATE_CHANGE_FAILURE)
+    {
+        return false;
+    }
+    for (auto &stream : pipeline.streams)
+    {
+        GstCaps *caps{stream.createCaps()};
+        gst_pad_send_event(stream.pad, gst_event_new_stream_start(GST_OBJECT_NAME(stream.sink)));
+        gst_pad_send_event(stream.pad, gst_event_new_caps(caps));
+        gst_caps_unref(caps);
+        GstSegment segment;
+        gst_segment_init(&segment, GST_FORMAT_TIME);
+        gst_pad_send_event(stream.pad, gst_event_new_segment(&segment));
+    }
+    pipeline.startLatency.add(std::chrono::steady_clock::now() - kStart);
+
+    pipeline.isFeeding = true;
+    for (auto &stream : pipeline.streams)
+    {
+        stream.feeder = std::thread{[&pipeline, &stream]() { feed(pipeline.isFeeding, stream); }};
+    }
+    return true;
+}
+
+void stopPipeline(Pipeline &pipeline)
+{
+    const auto kStart{std::chrono::steady_clock::now()};
+    pipeline.isFeeding = false;
+    // Wakes up feeders waiting for space in the queue of the sink
+    for (auto &stream : pipeline.streams)
+    {
+        gst_pad_send_event(stream.pad, gst_event_new_flush_start());
+    }
+    for (auto &stream : pipeline.streams)
+    {
+        if (stream.feeder.joinable())
+        {
+            stream.feeder.join();
+        }
+    }
+    gst_element_set_state(pipeline.pipeline, GST_STATE_NULL);
+    pipeline.stopLatency.add(std::chrono::steady_clock::now() - kStart);
+}
+
+// Runs the given function for every pipeline on its own thread, all released at the same moment
+template <typename Function>
+void forEachPipelineConcurrently(std::vector<std::unique_ptr<Pipeline>> &pipelines, Function function)
+{
+    std::atomic<bool> isStarted{false};
+    std::vector<std::thread> threads;
+    for (auto &pipeline : pipelines)
+    {
+        threads.emplace_back(
+            [&isStarted, &pipeline, &function]()
+            {
+                while (!isStarted)
+                    std::this_thread::yield();
+                function(*pipeline);
+            });
+    }
+    isStarted = true;
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+// N pipelines in one process, as with a main player, a PiP player and preview tiles. Every pipeline has real rialto
+// audio and video sinks, which talk to the stand-in server through MediaPlayerManager and
+// GStreamerMSEMediaPlayerClient. All pipelines are started at once, so start latency shows the contention of
+// attaching to the shared MediaPlayerManager state. Then need data is serviced for all sources every tick, through the
+// sinks' queues. Stop covers flushing the sinks and the state change to NULL, which releases the clients.
+// Cpu time includes the feeder threads and the benchmark thread, which plays the role of the server.
+// Arguments: number of pipelines, delay of media pipeline creation in the stand-in server in ms
+void multiplePipelines(benchmark::State &state)
+{
+    setUpSinkEnvironment();
+    const size_t kPipelineCount{static_cast<size_t>(state.range(0))};
+    StandInServer server{std::chrono::milliseconds{state.range(1)}};
+
+    const ProcessStats kStatsBefore{readProcessStats()};
+    std::vector<std::unique_ptr<Pipeline>> pipelines;
+    for (size_t i = 0; i < kPipelineCount; ++i)
+    {
+        pipelines.push_back(createPipeline());
+    }
+    std::atomic<bool> isStartFailed{false};
+    forEachPipelineConcurrently(pipelines,
+                                [&isStartFailed](Pipeline &pipeline)
+                                {
+                                    if (!startPipeline(pipeline))
+                                        isStartFailed = true;
+                                });
+    const ProcessStats kStatsStarted{readProcessStats()};
+    std::this_thread::sleep_for(kFillTime);
+
+    std::vector<std::pair<std::shared_ptr<FakeMediaPlayerClientBackend>, std::vector<int32_t>>> sources;
+    for (auto &backend : server.getBackends())
+    {
+        sources.emplace_back(backend, backend->getSourceIds());
+        if (sources.back().second.size() != 2)
+        {
+            isStartFailed = true;
+        }
+    }
+    if (sources.size() != kPipelineCount)
+    {
+        isStartFailed = true;
+    }
+
+    LatencySamples needDataLatency;
+    needDataLatency.reserve(kTicks * kPipelineCount * 2);
+    std::vector<std::pair<FakeMediaPlayerClientBackend *, uint32_t>> requests;
+    const auto kSoakStart{std::chrono::steady_clock::now()};
+    auto nextTickTime{kSoakStart};
+    for (auto _ : state)
+    {
+        if (isStartFailed)
+        {
+            state.SkipWithError("Could not start pipelines");
+            break;
+        }
+        requests.clear();
+        for (const auto &[kBackend, kSourceIds] : sources)
+        {
+            for (int32_t sourceId : kSourceIds)
+            {
+                requests.emplace_back(kBackend.get(), kBackend->sendNeedData(sourceId, kFramesPerRequest));
+            }
+        }
+        for (const auto &[kBackend, kRequestId] : requests)
+        {
+            const auto kResult{kBackend->waitForHaveData(kRequestId, kHaveDataTimeout)};
+            if (!kResult || kResult->status != firebolt::rialto::MediaSourceStatus::OK)
+            {
+                state.SkipWithError("Need data was not answered with data");
+                break;
+            }
+            needDataLatency.add(kResult->latency);
+        }
+        state.PauseTiming();
+        nextTickTime += kTickInterval;
+        std::this_thread::sleep_until(nextTickTime);
+        state.ResumeTiming();
+    }
+    const ProcessStats kStatsSoaked{readProcessStats()};
+    const std::chrono::duration<double> kSoakDuration{std::chrono::steady_clock::now() - kSoakStart};
+
+    sources.clear();
+    forEachPipelineConcurrently(pipelines, stopPipeline);
+    LatencySamples startLatency;
+    LatencySamples stopLatency;
+    for (auto &pipeline : pipelines)
+    {
+        startLatency.merge(pipeline->startLatency);
+        stopLatency.merge(pipeline->stopLatency);
+        for (auto &stream : pipeline->streams)
+        {
+            gst_object_unref(stream.pad);
+        }
+        gst_object_unref(pipeline->pipeline);
+    }
+
+    const double kPipelines{static_cast<double>(kPipelineCount)};
+    state.counters["threads/pipeline"] = (kStatsStarted.threadCount - kStatsBefore.threadCount) / kPipelines;
+    state.counters["rss_kb/pipeline"] = (static_cast<double>(kStatsStarted.rssKb) - kStatsBefore.rssKb) / kPipelines;
+    state.counters["cpu_%/pipeline"] = std::chrono::duration<double>(kStatsSoaked.cpuTime - kStatsStarted.cpuTime) /
+                                       kSoakDuration * 100.0 / kPipelines;
+    needDataLatency.report(state, "need_data_");
+    startLatency.report(state, "start_");
+    stopLatency.report(state, "stop_");
+}
+} // namespace
+
+BENCHMARK(multiplePipelines)
+    ->ArgNames({"pipelines", "create_delay_ms"})
+    ->ArgsProduct({{1, 2, 3, 4, 8, 16}, {0, 20}})
+    ->Iterations(kTicks)
+    ->UseRealTime();
@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BenchmarkUtils.h"
+#include "FakeMediaPlayerClientBackend.h"
+#include "RialtoGStreamerMSEAudioSink.h"
+#include "RialtoGStreamerMSEVideoSink.h"
+#include "SampleFactory.h"
+#include "SinkEnvironment.h"
+#include "StandInServer.h"
+
+#include <benchmark/benchmark.h>
+#include <gst/gst.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace
+{
+using ServerEvent = FakeMediaPlayerClientBackend::ServerEvent;
+
+constexpr int64_t kSeeks{100};
+constexpr std::chrono::milliseconds kAsyncDoneTimeout{5000};
+// Enough to preroll, but below the number of queued buffers, which blocks the streaming thread
+constexpr size_t kBuffersPerSegment{4};
+constexpr int64_t kSeekStep{GST_SECOND};
+constexpr int64_t kSeekRange{60 * GST_SECOND};
+constexpr size_t kAudioFrameSize{768};
+constexpr size_t kVideoFrameSize{40000};
+constexpr int64_t kAudioFrameDuration{21333333};
+constexpr int64_t kVideoFrameDuration{40000000};
+
+struct Stream
+{
+    GstElement *sink;
+    GstPad *pad;
+    GstCaps *(*createCaps)();
+    size_t frameSize;
+    int64_t frameDuration;
+};
+
+// Timestamps of the server events and of the async done of the pipeline, collected during one seek
+class SeekTimeline
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit SeekTimeline(GstElement *pipeline) : m_pipeline{pipeline} {}
+
+    void reset()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_lastEventTimes.clear();
+        m_eventCounts.clear();
+        m_asyncDoneTime.reset();
+    }
+
+    void onServerEvent(ServerEvent event, int32_t sourceId)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_lastEventTimes[event] = Clock::now();
+        ++m_eventCounts[event];
+    }
+
+    static GstBusSyncReply onBusMessage(GstBus *bus, GstMessage *message, gpointer userData)
+    {
+        SeekTimeline *self{static_cast<SeekTimeline *>(userData)};
+        if (GST_MESSAGE_TYPE(message) == GST_MESSAGE_ASYNC_DONE &&
+            GST_MESSAGE_SRC(message) == GST_OBJECT_CAST(self->m_pipeline))
+        {
+            std::unique_lock<std::mutex> lock{self->m_mutex};
+            self->m_asyncDoneTime = Clock::now();
+            self->m_asyncDoneCondVar.notify_all();
+        }
+        return GST_BUS_DROP;
+    }
+
+    std::optional<Clock::time_point> waitForAsyncDone()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_asyncDoneCondVar.wait_for(lock, kAsyncDoneTimeout, [this]() { return m_asyncDoneTime.has_value(); });
+        return m_asyncDoneTime;
+    }
+
+    // Time of the event of the last source, or nothing if the event did not happen for all sources
+    std::optional<Clock::time_point> getLastEventTime(ServerEvent event, size_t sourceCount) const
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        auto countIt = m_eventCounts.find(event);
+        if (countIt == m_eventCounts.end() || countIt->second != sourceCount)
+        {
+            return std::nullopt;
+        }
+        return m_lastEventTimes.at(event);
+    }
+
+private:
+    GstElement *m_pipeline;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_asyncDoneCondVar;
+    std::map<ServerEvent, Clock::time_point> m_lastEventTimes;
+    std::map<ServerEvent, size_t> m_eventCounts;
+    std::optional<Clock::time_point> m_asyncDoneTime;
+};
+
+void sendSegmentAndBuffers(const Stream &stream, int64_t position)
+{
+    GstSegment segment;
+    gst_segment_init(&segment, GST_FORMAT_TIME);
+    segment.start = position;
+    segment.time = position;
+    segment.position = position;
+    gst_pad_send_event(stream.pad, gst_event_new_segment(&segment));
+    for (size_t i = 0; i < kBuffersPerSegment; ++i)
+    {
+        const int64_t kTimestamp{position + static_cast<int64_t>(i) * stream.frameDuration};
+        gst_pad_chain(stream.pad, createBuffer(stream.frameSize, kTimestamp, stream.frameDuration));
+    }
+}
+
+// Seeks a paused pipeline with a rialto audio and video sink, which talk to the stand-in server through the real
+// GStreamerMSEMediaPlayerClient. Flush events, segments and buffers are sent straight to the sink pads, as a demuxer
+// would do after a flushing seek. Every seek is split into phases, each of them ending when it ends for all sources:
+//   flush_start    - FLUSH_START handling in the sinks, including the wait in FlushAndDataSynchronizer
+//   flush_ipc      - from FLUSH_STOP until the flush request reaches the server
+//   source_flushed - flush in the server until the source flushed notification
+//   first_segment  - from source flushed until the first segment after flush is added
+//   async_done     - from the first segment until the pipeline posts async done (preroll in the server)
+// Iteration time is the whole seek, from FLUSH_START until async done.
+// Arguments: flush delay and preroll delay of the stand-in server in ms
+void seek(benchmark::State &state)
+{
+    setUpSinkEnvironment();
+    FakeMediaPlayerClientBackend::StreamingBehaviour behaviour;
+    behaviour.flushDelay = std::chrono::milliseconds{state.range(0)};
+    behaviour.prerollDelay = std::chrono::milliseconds{state.range(1)};
+    StandInServer server{std::chrono::milliseconds{0}, behaviour};
+
+    GstElement *pipeline{gst_pipeline_new(nullptr)};
+    SeekTimeline timeline{pipeline};
+    GstBus *bus{gst_element_get_bus(pipeline)};
+    gst_bus_set_sync_handler(bus, &SeekTimeline::onBusMessage, &timeline, nullptr);
+    gst_object_unref(bus);
+
+    std::vector<Stream> streams{
+        {GST_ELEMENT_CAST(g_object_new(RIALTO_TYPE_MSE_AUDIO_SINK, nullptr)), nullptr, createAacCaps, kAudioFrameSize,
+         kAudioFrameDuration},
+        {GST_ELEMENT_CAST(g_object_new(RIALTO_TYPE_MSE_VIDEO_SINK, nullptr)), nullptr, createH264Caps, kVideoFrameSize,
+         kVideoFrameDuration}};
+    for (auto &stream : streams)
+    {
+        gst_bin_add(GST_BIN(pipeline), stream.sink);
+        stream.pad = gst_element_get_static_pad(stream.sink, "sink");
+    }
+
+    gst_element_set_state(pipeline, GST_STATE_PAUSED);
+    for (auto &stream : streams)
+    {
+        GstCaps *caps{stream.createCaps()};
+        gst_pad_send_event(stream.pad, gst_event_new_stream_start(GST_OBJECT_NAME(stream.sink)));
+        gst_pad_send_event(stream.pad, gst_event_new_caps(caps));
+        gst_caps_unref(caps);
+    }
+    auto backend{server.getOnlyBackend()};
+    if (backend)
+    {
+        backend->setServerEventCallback([&timeline](ServerEvent event, int32_t sourceId)
+                                        { timeline.onServerEvent(event, sourceId); });
+    }
+    for (auto &stream : streams)
+    {
+        sendSegmentAndBuffers(stream, 0);
+    }
+    const bool kIsPrerolled{backend && timeline.waitForAsyncDone()};
+
+    LatencySamples flushStartLatency;
+    LatencySamples flushIpcLatency;
+    LatencySamples sourceFlushedLatency;
+    LatencySamples firstSegmentLatency;
+    LatencySamples asyncDoneLatency;
+    LatencySamples seekLatency;
+    int64_t position{0};
+    for (auto _ : state)
+    {
+        if (!kIsPrerolled)
+        {
+            state.SkipWithError("Pipeline did not preroll");
+            break;
+        }
+        position = (position + kSeekStep) % kSeekRange;
+        timeline.reset();
+
+        const auto kSeekStart{SeekTimeline::Clock::now()};
+        for (auto &stream : streams)
+        {
+            gst_pad_send_event(stream.pad, gst_event_new_flush_start());
+        }
+        const auto kFlushStarted{SeekTimeline::Clock::now()};
+        for (auto &stream : streams)
+        {
+            gst_pad_send_event(stream.pad, gst_event_new_flush_stop(TRUE));
+        }
+        for (auto &stream : streams)
+        {
+            sendSegmentAndBuffers(stream, position);
+        }
+        const auto kAsyncDone{timeline.waitForAsyncDone()};
+        const auto kFlushed{timeline.getLastEventTime(ServerEvent::FLUSH, streams.size())};
+        const auto kSourceFlushed{timeline.getLastEventTime(ServerEvent::SOURCE_FLUSHED, streams.size())};
+        const auto kFirstSegment{timeline.getLastEventTime(ServerEvent::FIRST_SEGMENT_AFTER_FLUSH, streams.size())};
+        if (!kAsyncDone || !kFlushed || !kSourceFlushed || !kFirstSegment)
+        {
+            state.SkipWithError("Seek did not complete");
+            break;
+        }
+        state.SetIterationTime(std::chrono::duration<double>(*kAsyncDone - kSeekStart).count());
+        flushStartLatency.add(kFlushStarted - kSeekStart);
+        flushIpcLatency.add(*kFlushed - kFlushStarted);
+        sourceFlushedLatency.add(*kSourceFlushed - *kFlushed);
+        firstSegmentLatency.add(*kFirstSegment - *kSourceFlushed);
+        asyncDoneLatency.add(*kAsyncDone - *kFirstSegment);
+        seekLatency.add(*kAsyncDone - kSeekStart);
+    }
+
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    for (auto &stream : streams)
+    {
+        gst_object_unref(stream.pad);
+    }
+    if (backend)
+    {
+        backend->setServerEventCallback(nullptr);
+    }
+    gst_object_unref(pipeline);
+
+    flushStartLatency.report(state, "flush_start_");
+    flushIpcLatency.report(state, "flush_ipc_");
+    sourceFlushedLatency.report(state, "source_flushed_");
+    firstSegmentLatency.report(state, "first_segment_");
+    asyncDoneLatency.report(state, "async_done_");
+    seekLatency.report(state, "seek_");
+}
+} // namespace
+
+BENCHMARK(seek)
+    ->ArgNames({"flush_delay_ms", "preroll_delay_ms"})
+    ->ArgsProduct({{0, 10, 50}, {0, 20}})
+    ->Iterations(kSeeks)
+    ->UseManualTime();
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "SinkEnvironment.h"
+#include "ClientLogControlMock.h"
+#include "ControlMock.h"
+#include "MediaPipelineCapabilitiesMock.h"
+
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using firebolt::rialto::ApplicationState;
+using firebolt::rialto::MediaSourceType;
+using testing::_;
+using testing::DoAll;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnArg;
+using testing::ReturnRef;
+using testing::SetArgReferee;
+using testing::StrictMock;
+
+namespace
+{
+const std::vector<std::string> kSupportedAudioMimeTypes{"audio/mp4", "audio/aac", "audio/x-eac3", "audio/x-opus"};
+const std::vector<std::string> kSupportedVideoMimeTypes{"video/h264", "video/h265", "video/x-av1", "video/x-vp9"};
+const std::vector<std::string> kSupportedSubtitlesMimeTypes{"text/vtt", "text/ttml"};
+
+std::unique_ptr<firebolt::rialto::IMediaPipelineCapabilities> createCapabilities()
+{
+    auto capabilities{std::make_unique<NiceMock<firebolt::rialto::MediaPipelineCapabilitiesMock>>()};
+    ON_CALL(*capabilities, getSupportedMimeTypes(MediaSourceType::AUDIO))
+        .WillByDefault(Return(kSupportedAudioMimeTypes));
+    ON_CALL(*capabilities, getSupportedMimeTypes(MediaSourceType::VIDEO))
+        .WillByDefault(Return(kSupportedVideoMimeTypes));
+    ON_CALL(*capabilities, getSupportedMimeTypes(MediaSourceType::SUBTITLE))
+        .WillByDefault(Return(kSupportedSubtitlesMimeTypes));
+    ON_CALL(*capabilities, isMimeTypeSupported(_)).WillByDefault(Return(true));
+    // All properties are supported
+    ON_CALL(*capabilities, getSupportedProperties(_, _)).WillByDefault(ReturnArg<1>());
+    return capabilities;
+}
+
+void setUpStubs()
+{
+    static NiceMock<firebolt::rialto::ClientLogControlMock> clientLogControl;
+    ON_CALL(clientLogControl, registerLogHandler(_, _)).WillByDefault(Return(true));
+    auto clientLogControlFactory{std::dynamic_pointer_cast<StrictMock<firebolt::rialto::ClientLogControlFactoryMock>>(
+        firebolt::rialto::IClientLogControlFactory::createFactory())};
+    EXPECT_CALL(*clientLogControlFactory, createClientLogControl()).WillRepeatedly(ReturnRef(clientLogControl));
+
+    auto capabilitiesFactory{
+        std::dynamic_pointer_cast<StrictMock<firebolt::rialto::MediaPipelineCapabilitiesFactoryMock>>(
+            firebolt::rialto::IMediaPipelineCapabilitiesFactory::createFactory())};
+    EXPECT_CALL(*capabilitiesFactory, createMediaPipelineCapabilities()).WillRepeatedly(Invoke(createCapabilities));
+
+    // Sinks are always allowed to play, as if the application was in the foreground
+    static auto control{std::make_shared<NiceMock<firebolt::rialto::ControlMock>>()};
+    ON_CALL(*control, registerClient(_, _))
+        .WillByDefault(DoAll(SetArgReferee<1>(ApplicationState::RUNNING), Return(true)));
+    auto controlFactory{std::dynamic_pointer_cast<StrictMock<firebolt::rialto::ControlFactoryMock>>(
+        firebolt::rialto::IControlFactory::createFactory())};
+    EXPECT_CALL(*controlFactory, createControl()).WillRepeatedly(Return(control));
+}
+} // namespace
+
+void setUpSinkEnvironment()
+{
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, setUpStubs);
+}
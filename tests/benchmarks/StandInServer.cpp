@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "StandInServer.h"
+#include "FakeMediaPipeline.h"
+
+#include <thread>
+
+using testing::_;
+using testing::Invoke;
+using testing::StrictMock;
+
+StandInServer::StandInServer(const std::chrono::milliseconds &createDelay,
+                             const std::optional<FakeMediaPlayerClientBackend::StreamingBehaviour> &streamingBehaviour)
+    : m_factory{std::dynamic_pointer_cast<StrictMock<firebolt::rialto::MediaPipelineFactoryMock>>(
+          firebolt::rialto::IMediaPipelineFactory::createFactory())}
+{
+    EXPECT_CALL(*m_factory, createMediaPipeline(_, _))
+        .WillRepeatedly(Invoke(
+            [this, createDelay, streamingBehaviour](std::weak_ptr<firebolt::rialto::IMediaPipelineClient> client,
+                                                    const firebolt::rialto::VideoRequirements &videoRequirements)
+                -> std::unique_ptr<firebolt::rialto::IMediaPipeline>
+            {
+                std::this_thread::sleep_for(createDelay);
+                auto backend{std::make_shared<FakeMediaPlayerClientBackend>()};
+                if (streamingBehaviour)
+                {
+                    backend->enableServerDrivenStreaming(*streamingBehaviour);
+                }
+                {
+                    std::unique_lock<std::mutex> lock{m_mutex};
+                    m_backends[client.lock().get()] = backend;
+                }
+                return std::make_unique<FakeMediaPipeline>(client, backend);
+            }));
+}
+
+StandInServer::~StandInServer()
+{
+    testing::Mock::VerifyAndClearExpectations(m_factory.get());
+}
+
+std::shared_ptr<FakeMediaPlayerClientBackend> StandInServer::getOnlyBackend()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return m_backends.size() == 1 ? m_backends.begin()->second : nullptr;
+}
+
+std::vector<std::shared_ptr<FakeMediaPlayerClientBackend>> StandInServer::getBackends()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    std::vector<std::shared_ptr<FakeMediaPlayerClientBackend>> backends;
+    for (const auto &[kClient, kBackend] : m_backends)
+    {
+        backends.push_back(kBackend);
+    }
+    return backends;
+}
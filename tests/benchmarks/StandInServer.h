@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include "FakeMediaPlayerClientBackend.h"
+#include "IMediaPipeline.h"
+#include "MediaPipelineMock.h"
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// Hands out FakeMediaPipelines from the IMediaPipelineFactory stub, so that clients created by MediaPlayerManager
+// talk to a FakeMediaPlayerClientBackend. Creation delay stands for the createMediaPipeline and load IPC.
+class StandInServer
+{
+public:
+    explicit StandInServer(const std::chrono::milliseconds &createDelay,
+                           const std::optional<FakeMediaPlayerClientBackend::StreamingBehaviour> &streamingBehaviour =
+                               std::nullopt);
+    ~StandInServer();
+    StandInServer(const StandInServer &) = delete;
+    StandInServer &operator=(const StandInServer &) = delete;
+
+    // For benchmarks, which create media pipelines only through sinks. Returns nullptr unless exactly one media
+    // pipeline was created.
+    std::shared_ptr<FakeMediaPlayerClientBackend> getOnlyBackend();
+    std::vector<std::shared_ptr<FakeMediaPlayerClientBackend>> getBackends();
+
+private:
+    std::shared_ptr<testing::StrictMock<firebolt::rialto::MediaPipelineFactoryMock>> m_factory;
+    std::mutex m_mutex;
+    std::map<const firebolt::rialto::IMediaPipelineClient *, std::shared_ptr<FakeMediaPlayerClientBackend>> m_backends;
+};
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BenchmarkUtils.h"
+#include "ITimer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+
+namespace
+{
+// Long enough for the timer never to fire during the measurement
+constexpr std::chrono::milliseconds kTimeout{10000};
+
+// Cost of creating a timer and cancelling it before it fires, as done by the web audio push timer and the parked
+// client grace period. Timer threads inherit the affinity of the creating thread, so when pinned both share one cpu.
+// Arguments: pinned
+void timerCreateCancel(benchmark::State &state, TimerType timerType)
+{
+    std::optional<ScopedCpuAffinity> affinity;
+    if (state.range(0) != 0)
+        affinity.emplace(0);
+    std::shared_ptr<ITimerFactory> factory{ITimerFactory::getFactory()};
+
+    LatencySamples createLatency;
+    LatencySamples cancelLatency;
+    createLatency.reserve(state.max_iterations);
+    cancelLatency.reserve(state.max_iterations);
+    for (auto _ : state)
+    {
+        const auto kStart{std::chrono::steady_clock::now()};
+        std::unique_ptr<ITimer> timer{factory->createTimer(kTimeout, []() {}, timerType)};
+        const auto kCreated{std::chrono::steady_clock::now()};
+        timer->cancel();
+        const auto kCancelled{std::chrono::steady_clock::now()};
+        createLatency.add(kCreated - kStart);
+        cancelLatency.add(kCancelled - kCreated);
+    }
+    createLatency.report(state, "create_");
+    cancelLatency.report(state, "cancel_");
+}
+} // namespace
+
+BENCHMARK_CAPTURE(timerCreateCancel, OneShot, TimerType::ONE_SHOT)->ArgName("pinned")->DenseRange(0, 1)->UseRealTime();
+BENCHMARK_CAPTURE(timerCreateCancel, Periodic, TimerType::PERIODIC)->ArgName("pinned")->DenseRange(0, 1)->UseRealTime();
@@ -30,10 +30,14 @@ public:
     MOCK_METHOD(void, processMessages, (), (override));
     MOCK_METHOD(bool, scheduleInEventLoop, (const std::function<void()> &func), (override));
     MOCK_METHOD(bool, callInEventLoop, (const std::function<void()> &func), (override));
+    MOCK_METHOD(bool, postMessageWithPriority, (const std::shared_ptr<Message> &msg), (override));
+    MOCK_METHOD(bool, scheduleInEventLoopWithPriority, (const std::function<void()> &func), (override));
+    MOCK_METHOD(bool, callInEventLoopWithPriority, (const std::function<void()> &func), (override));
 };
 
 class MessageQueueFactoryMock : public IMessageQueueFactory
 {
 public:
+    using IMessageQueueFactory::createMessageQueue;
     MOCK_METHOD(std::unique_ptr<IMessageQueue>, createMessageQueue, (), (const, override));
 };
@@ -36,7 +36,8 @@ public:
     MOCK_METHOD(gboolean, handleSendEvent, (GstEvent * event), (override));
     MOCK_METHOD(gboolean, handleEvent, (GstPad * pad, GstObject *parent, GstEvent *event), (override));
     MOCK_METHOD(GstFlowReturn, handleBuffer, (GstBuffer * buffer), (override));
-    MOCK_METHOD(GstRefSample, getFrontSample, (), (const, override));
+    MOCK_METHOD(GstRefSample, getFrontSample, (uint64_t & sampleIndex), (const, override));
+    MOCK_METHOD(GstRefSample, getSample, (size_t position, uint64_t &sampleIndex), (const, override));
     MOCK_METHOD(void, popSample, (), (override));
     MOCK_METHOD(bool, isEos, (), (const, override));
     MOCK_METHOD(void, lostState, (), (override));
@@ -20,6 +20,7 @@
 #include "ControlMock.h"
 #include <gtest/gtest.h>
 #include <memory>
+#include <thread>
 
 using firebolt::rialto::ApplicationState;
 using firebolt::rialto::ControlFactoryMock;
@@ -29,6 +30,7 @@ using firebolt::rialto::IControlFactory;
 using firebolt::rialto::client::ControlBackend;
 using testing::_;
 using testing::DoAll;
+using testing::Invoke;
 using testing::Return;
 using testing::SaveArg;
 using testing::SetArgReferee;
@@ -153,4 +155,78 @@ TEST_F(ControlBackendTests, ShouldHandleStateNotificationWhenExternalControlClie
     ASSERT_TRUE(client);
 
     client->notifyApplicationState(ApplicationState::UNKNOWN);
-}
\ No newline at end of file
+}
+
+TEST_F(ControlBackendTests, ShouldShareControlBetweenBackends)
+{
+    std::weak_ptr<IControlClient> weakClient;
+    auto firstExternalClient = std::make_shared<StrictMock<ControlClientMock>>();
+    auto secondExternalClient = std::make_shared<StrictMock<ControlClientMock>>();
+    EXPECT_CALL(*m_controlFactoryMock, createControl()).WillOnce(Return(m_controlMock));
+    EXPECT_CALL(*m_controlMock, registerClient(_, _))
+        .WillOnce(DoAll(SaveArg<0>(&weakClient), SetArgReferee<1>(ApplicationState::RUNNING), Return(true)));
+    m_sut = std::make_unique<ControlBackend>(firstExternalClient);
+    ControlBackend secondBackend{secondExternalClient};
+    EXPECT_TRUE(secondBackend.waitForRunning());
+
+    auto client = weakClient.lock();
+    ASSERT_TRUE(client);
+
+    EXPECT_CALL(*firstExternalClient, notifyApplicationState(ApplicationState::INACTIVE));
+    EXPECT_CALL(*secondExternalClient, notifyApplicationState(ApplicationState::INACTIVE));
+    client->notifyApplicationState(ApplicationState::INACTIVE);
+
+    m_sut->removeControlBackend();
+    EXPECT_CALL(*secondExternalClient, notifyApplicationState(ApplicationState::RUNNING));
+    client->notifyApplicationState(ApplicationState::RUNNING);
+}
+
+TEST_F(ControlBackendTests, ShouldAddBackendFromAnotherThreadDuringNotification)
+{
+    std::weak_ptr<IControlClient> weakClient;
+    auto externalClient = std::make_shared<StrictMock<ControlClientMock>>();
+    EXPECT_CALL(*m_controlFactoryMock, createControl()).WillOnce(Return(m_controlMock));
+    EXPECT_CALL(*m_controlMock, registerClient(_, _))
+        .WillOnce(DoAll(SaveArg<0>(&weakClient), SetArgReferee<1>(ApplicationState::INACTIVE), Return(true)));
+    m_sut = std::make_unique<ControlBackend>(externalClient);
+
+    auto client = weakClient.lock();
+    ASSERT_TRUE(client);
+
+    // Listeners are notified without the shared lock, so the other thread is not blocked by it
+    EXPECT_CALL(*externalClient, notifyApplicationState(ApplicationState::RUNNING))
+        .WillOnce(Invoke(
+            [](ApplicationState)
+            {
+                std::thread{[]()
+                            {
+                                ControlBackend backend;
+                                EXPECT_TRUE(backend.waitForRunning());
+                            }}
+                    .join();
+            }));
+    client->notifyApplicationState(ApplicationState::RUNNING);
+}
+
+TEST_F(ControlBackendTests, ShouldRemoveBackendFromWithinItsNotification)
+{
+    std::weak_ptr<IControlClient> weakClient;
+    auto firstExternalClient = std::make_shared<StrictMock<ControlClientMock>>();
+    auto secondExternalClient = std::make_shared<StrictMock<ControlClientMock>>();
+    EXPECT_CALL(*m_controlFactoryMock, createControl()).WillOnce(Return(m_controlMock));
+    EXPECT_CALL(*m_controlMock, registerClient(_, _))
+        .WillOnce(DoAll(SaveArg<0>(&weakClient), SetArgReferee<1>(ApplicationState::RUNNING), Return(true)));
+    m_sut = std::make_unique<ControlBackend>(firstExternalClient);
+    ControlBackend secondBackend{secondExternalClient};
+
+    auto client = weakClient.lock();
+    ASSERT_TRUE(client);
+
+    EXPECT_CALL(*firstExternalClient, notifyApplicationState(ApplicationState::INACTIVE))
+        .WillOnce(Invoke([this](ApplicationState) { m_sut->removeControlBackend(); }));
+    EXPECT_CALL(*secondExternalClient, notifyApplicationState(ApplicationState::INACTIVE));
+    client->notifyApplicationState(ApplicationState::INACTIVE);
+
+    EXPECT_CALL(*secondExternalClient, notifyApplicationState(ApplicationState::RUNNING));
+    client->notifyApplicationState(ApplicationState::RUNNING);
+}
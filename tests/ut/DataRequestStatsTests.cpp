@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "DataRequestStats.h"
+#include <gst/gst.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr uint32_t kNeedDataRequestId{7};
+constexpr size_t kFrameCount{24};
+constexpr std::chrono::microseconds kRequestToPull{300};
+constexpr std::chrono::microseconds kTurnaround{4000};
+constexpr std::chrono::microseconds kParse{50};
+constexpr std::chrono::microseconds kAddSegment{120};
+const DataRequestStats::Clock::time_point kReceivedTime{std::chrono::seconds{10}};
+} // namespace
+
+class DataRequestStatsTests : public testing::Test
+{
+protected:
+    DataRequestStats m_sut;
+};
+
+TEST_F(DataRequestStatsTests, ShouldMeasureRequestTimings)
+{
+    m_sut.onNeedData(kNeedDataRequestId, kFrameCount, kReceivedTime);
+    m_sut.onPullStarted(kNeedDataRequestId, kReceivedTime + kRequestToPull);
+    m_sut.onSegmentParsed(kParse);
+    m_sut.onSegmentAdded(kAddSegment, firebolt::rialto::AddSegmentStatus::OK);
+    m_sut.onSegmentAdded(kAddSegment, firebolt::rialto::AddSegmentStatus::NO_SPACE);
+    m_sut.onHaveData(kNeedDataRequestId, firebolt::rialto::MediaSourceStatus::OK, kReceivedTime + kTurnaround);
+
+    const DataRequestStats::Snapshot kSnapshot{m_sut.getSnapshot()};
+    EXPECT_EQ(kSnapshot.needDataCount, 1u);
+    EXPECT_EQ(kSnapshot.framesRequested, kFrameCount);
+    EXPECT_EQ(kSnapshot.framesDelivered, 1u);
+    EXPECT_EQ(kSnapshot.noSpaceCount, 1u);
+    EXPECT_EQ(kSnapshot.noAvailableSamplesCount, 0u);
+    EXPECT_EQ(kSnapshot.requestToPull.getSumUs(), static_cast<uint64_t>(kRequestToPull.count()));
+    EXPECT_EQ(kSnapshot.parse.getSumUs(), static_cast<uint64_t>(kParse.count()));
+    EXPECT_EQ(kSnapshot.addSegment.getCount(), 2u);
+    EXPECT_EQ(kSnapshot.turnaround.getSumUs(), static_cast<uint64_t>(kTurnaround.count()));
+}
+
+TEST_F(DataRequestStatsTests, ShouldCountRequestsWithoutSamples)
+{
+    m_sut.onNeedData(kNeedDataRequestId, kFrameCount, kReceivedTime);
+    m_sut.onPullStarted(kNeedDataRequestId, kReceivedTime);
+    m_sut.onHaveData(kNeedDataRequestId, firebolt::rialto::MediaSourceStatus::NO_AVAILABLE_SAMPLES, kReceivedTime);
+
+    const DataRequestStats::Snapshot kSnapshot{m_sut.getSnapshot()};
+    EXPECT_EQ(kSnapshot.noAvailableSamplesCount, 1u);
+    EXPECT_EQ(kSnapshot.framesDelivered, 0u);
+    EXPECT_EQ(kSnapshot.turnaround.getCount(), 1u);
+}
+
+TEST_F(DataRequestStatsTests, ShouldIgnoreUnknownRequests)
+{
+    m_sut.onPullStarted(kNeedDataRequestId, kReceivedTime);
+    m_sut.onHaveData(kNeedDataRequestId, firebolt::rialto::MediaSourceStatus::OK, kReceivedTime);
+
+    const DataRequestStats::Snapshot kSnapshot{m_sut.getSnapshot()};
+    EXPECT_EQ(kSnapshot.requestToPull.getCount(), 0u);
+    EXPECT_EQ(kSnapshot.turnaround.getCount(), 0u);
+}
+
+TEST_F(DataRequestStatsTests, ShouldAddStatsToStructure)
+{
+    m_sut.onNeedData(kNeedDataRequestId, kFrameCount, kReceivedTime);
+    m_sut.onHaveData(kNeedDataRequestId, firebolt::rialto::MediaSourceStatus::OK, kReceivedTime + kTurnaround);
+
+    GstStructure *structure{gst_structure_new_empty("stats")};
+    DataRequestStats::addToStructure(structure, m_sut.getSnapshot());
+
+    guint64 framesRequested{0};
+    EXPECT_TRUE(gst_structure_get_uint64(structure, "frames-requested", &framesRequested));
+    EXPECT_EQ(framesRequested, kFrameCount);
+
+    GstStructure *turnaround{nullptr};
+    ASSERT_TRUE(gst_structure_get(structure, "turnaround", GST_TYPE_STRUCTURE, &turnaround, nullptr));
+    guint64 count{0};
+    EXPECT_TRUE(gst_structure_get_uint64(turnaround, "count", &count));
+    EXPECT_EQ(count, 1u);
+    const GValue *kBuckets{gst_structure_get_value(turnaround, "buckets")};
+    ASSERT_NE(kBuckets, nullptr);
+    EXPECT_EQ(gst_value_array_get_size(kBuckets), LatencyHistogram::kBucketBoundsUs.size() + 1);
+
+    gst_structure_free(turnaround);
+    gst_structure_free(structure);
+}
@@ -162,4 +162,41 @@ TEST_F(FlushAndDataSynchronizerTests, ShouldWaitForDataPushOfSecondSource)
     EXPECT_FALSE(waitFinished);
     m_sut.notifyDataPushed(kVideoSourceId);
     waitingThread.join();
-}
\ No newline at end of file
+}
+TEST_F(FlushAndDataSynchronizerTests, ShouldTrackDataAfterFlushWhenSourcesWereSettled)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool waiting{false};
+    bool waitFinished{false};
+
+    m_sut.notifyDataReceived(kAudioSourceId);
+    m_sut.notifyDataPushed(kAudioSourceId);
+    m_sut.notifyDataReceived(kVideoSourceId);
+    m_sut.notifyDataPushed(kVideoSourceId);
+    m_sut.notifyDataReceived(kVideoSourceId); // should be ignored
+
+    m_sut.waitIfRequired(kAudioSourceId);
+    m_sut.notifyFlushStarted(kAudioSourceId);
+    EXPECT_TRUE(m_sut.isAnySourceFlushing());
+    m_sut.notifyFlushCompleted(kAudioSourceId);
+    EXPECT_FALSE(m_sut.isAnySourceFlushing());
+    m_sut.notifyDataReceived(kAudioSourceId);
+
+    std::thread waitingThread(
+        [&]()
+        {
+            std::unique_lock lock(mutex);
+            waiting = true;
+            cv.notify_one();
+            lock.unlock();
+            m_sut.waitIfRequired(kVideoSourceId);
+            waitFinished = true;
+        });
+
+    std::unique_lock lock(mutex);
+    cv.wait(lock, [&waiting]() { return waiting; });
+    EXPECT_FALSE(waitFinished);
+    m_sut.notifyDataPushed(kAudioSourceId);
+    waitingThread.join();
+}
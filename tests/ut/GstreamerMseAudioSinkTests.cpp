@@ -1389,3 +1389,120 @@ TEST_F(GstreamerMseAudioSinkTests, ShouldFailToHandleSwitchSourceEventWhenOperat
     gst_caps_unref(caps);
     gst_object_unref(textContext.m_pipeline);
 }
+
+TEST_F(GstreamerMseAudioSinkTests, ShouldDropAudioBuffersDuringTrickPlay)
+{
+    constexpr gdouble kRate{4.0};
+    RialtoMSEBaseSink *audioSink = createAudioSink();
+    g_object_set(audioSink, "enable-last-sample", TRUE, nullptr);
+
+    GstSegment *segment{gst_segment_new()};
+    gst_segment_init(segment, GST_FORMAT_TIME);
+    segment->rate = kRate;
+    EXPECT_TRUE(rialto_mse_base_sink_event(audioSink->priv->m_sinkPad, GST_OBJECT_CAST(audioSink),
+                                           gst_event_new_segment(segment)));
+
+    // First buffer of the segment is needed by the server to preroll
+    GstBuffer *firstBuffer{gst_buffer_new()};
+    GstBuffer *firstBufferRef{gst_buffer_ref(firstBuffer)};
+    EXPECT_EQ(GST_FLOW_OK,
+              rialto_mse_base_sink_chain(audioSink->priv->m_sinkPad, GST_OBJECT_CAST(audioSink), firstBuffer));
+
+    GstBuffer *secondBuffer{gst_buffer_new()};
+    EXPECT_EQ(GST_FLOW_OK,
+              rialto_mse_base_sink_chain(audioSink->priv->m_sinkPad, GST_OBJECT_CAST(audioSink), secondBuffer));
+
+    GstSample *lastSample{nullptr};
+    g_object_get(audioSink, "last-sample", &lastSample, nullptr);
+    ASSERT_NE(lastSample, nullptr);
+    EXPECT_EQ(gst_sample_get_buffer(lastSample), firstBufferRef);
+    gst_sample_unref(lastSample);
+    gst_buffer_unref(firstBufferRef);
+
+    gst_segment_free(segment);
+    gst_element_set_state(GST_ELEMENT_CAST(audioSink), GST_STATE_NULL);
+    gst_object_unref(audioSink);
+}
+
+TEST_F(GstreamerMseAudioSinkTests, ShouldNotDropAudioBuffersAtModerateRate)
+{
+    constexpr gdouble kRate{1.5};
+    RialtoMSEBaseSink *audioSink = createAudioSink();
+    g_object_set(audioSink, "enable-last-sample", TRUE, nullptr);
+
+    GstSegment *segment{gst_segment_new()};
+    gst_segment_init(segment, GST_FORMAT_TIME);
+    segment->rate = kRate;
+    EXPECT_TRUE(rialto_mse_base_sink_event(audioSink->priv->m_sinkPad, GST_OBJECT_CAST(audioSink),
+                                           gst_event_new_segment(segment)));
+
+    GstBuffer *firstBuffer{gst_buffer_new()};
+    EXPECT_EQ(GST_FLOW_OK,
+              rialto_mse_base_sink_chain(audioSink->priv->m_sinkPad, GST_OBJECT_CAST(audioSink), firstBuffer));
+
+    GstBuffer *secondBuffer{gst_buffer_new()};
+    GstBuffer *secondBufferRef{gst_buffer_ref(secondBuffer)};
+    EXPECT_EQ(GST_FLOW_OK,
+              rialto_mse_base_sink_chain(audioSink->priv->m_sinkPad, GST_OBJECT_CAST(audioSink), secondBuffer));
+
+    GstSample *lastSample{nullptr};
+    g_object_get(audioSink, "last-sample", &lastSample, nullptr);
+    ASSERT_NE(lastSample, nullptr);
+    EXPECT_EQ(gst_sample_get_buffer(lastSample), secondBufferRef);
+    gst_sample_unref(lastSample);
+    gst_buffer_unref(secondBufferRef);
+
+    gst_segment_free(segment);
+    gst_element_set_state(GST_ELEMENT_CAST(audioSink), GST_STATE_NULL);
+    gst_object_unref(audioSink);
+}
+
+TEST_F(GstreamerMseAudioSinkTests, ShouldDropBuffersOutsideOfSegment)
+{
+    constexpr GstClockTime kSegmentStart{10 * GST_SECOND};
+    constexpr GstClockTime kSegmentStop{20 * GST_SECOND};
+    constexpr GstClockTime kDuration{20 * GST_MSECOND};
+    RialtoMSEBaseSink *audioSink = createAudioSink();
+    g_object_set(audioSink, "enable-last-sample", TRUE, nullptr);
+
+    GstSegment *segment{gst_segment_new()};
+    gst_segment_init(segment, GST_FORMAT_TIME);
+    segment->start = kSegmentStart;
+    segment->stop = kSegmentStop;
+    EXPECT_TRUE(rialto_mse_base_sink_event(audioSink->priv->m_sinkPad, GST_OBJECT_CAST(audioSink),
+                                           gst_event_new_segment(segment)));
+
+    GstBuffer *bufferBeforeStart{gst_buffer_new()};
+    GST_BUFFER_PTS(bufferBeforeStart) = GST_SECOND;
+    GST_BUFFER_DURATION(bufferBeforeStart) = kDuration;
+    EXPECT_EQ(GST_FLOW_OK,
+              rialto_mse_base_sink_chain(audioSink->priv->m_sinkPad, GST_OBJECT_CAST(audioSink), bufferBeforeStart));
+
+    GstSample *lastSample{nullptr};
+    g_object_get(audioSink, "last-sample", &lastSample, nullptr);
+    EXPECT_EQ(lastSample, nullptr);
+
+    // Buffer within preroll allowance should be kept for the decoder
+    GstBuffer *prerollBuffer{gst_buffer_new()};
+    GstBuffer *prerollBufferRef{gst_buffer_ref(prerollBuffer)};
+    GST_BUFFER_PTS(prerollBuffer) = kSegmentStart - 2 * kDuration;
+    GST_BUFFER_DURATION(prerollBuffer) = kDuration;
+    EXPECT_EQ(GST_FLOW_OK,
+              rialto_mse_base_sink_chain(audioSink->priv->m_sinkPad, GST_OBJECT_CAST(audioSink), prerollBuffer));
+
+    GstBuffer *bufferAfterStop{gst_buffer_new()};
+    GST_BUFFER_PTS(bufferAfterStop) = kSegmentStop;
+    GST_BUFFER_DURATION(bufferAfterStop) = kDuration;
+    EXPECT_EQ(GST_FLOW_OK,
+              rialto_mse_base_sink_chain(audioSink->priv->m_sinkPad, GST_OBJECT_CAST(audioSink), bufferAfterStop));
+
+    g_object_get(audioSink, "last-sample", &lastSample, nullptr);
+    ASSERT_NE(lastSample, nullptr);
+    EXPECT_EQ(gst_sample_get_buffer(lastSample), prerollBufferRef);
+    gst_sample_unref(lastSample);
+    gst_buffer_unref(prerollBufferRef);
+
+    gst_segment_free(segment);
+    gst_element_set_state(GST_ELEMENT_CAST(audioSink), GST_STATE_NULL);
+    gst_object_unref(audioSink);
+}
@@ -426,6 +426,22 @@ TEST_F(GstreamerMseBaseSinkTests, ShouldSetAndGetHasDrmProperty)
     gst_object_unref(audioSink);
 }
 
+TEST_F(GstreamerMseBaseSinkTests, ShouldSetAndGetFreshPropertiesProperty)
+{
+    RialtoMSEBaseSink *audioSink = createAudioSink();
+
+    gboolean value{TRUE};
+    g_object_get(audioSink, "fresh-properties", &value, nullptr);
+    EXPECT_FALSE(value);
+
+    g_object_set(audioSink, "fresh-properties", TRUE, nullptr);
+    g_object_get(audioSink, "fresh-properties", &value, nullptr);
+    EXPECT_TRUE(value);
+
+    gst_element_set_state(GST_ELEMENT_CAST(audioSink), GST_STATE_NULL);
+    gst_object_unref(audioSink);
+}
+
 TEST_F(GstreamerMseBaseSinkTests, ShouldQuerySeeking)
 {
     RialtoMSEBaseSink *audioSink = createAudioSink();
@@ -24,8 +24,12 @@
 #include "RialtoGStreamerMSEBaseSinkPrivate.h"
 #include "RialtoGstTest.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
 
 using firebolt::rialto::MediaSourceMock;
 using firebolt::rialto::client::MediaPlayerClientBackendMock;
@@ -127,6 +131,13 @@ public:
                     msg->handle();
                     return true;
                 }));
+        EXPECT_CALL(m_messageQueueMock, postMessageWithPriority(_))
+            .WillRepeatedly(Invoke(
+                [](const auto &msg)
+                {
+                    msg->handle();
+                    return true;
+                }));
     }
 
     void expectCallInEventLoop()
@@ -138,6 +149,20 @@ public:
                     f();
                     return true;
                 }));
+        EXPECT_CALL(m_messageQueueMock, callInEventLoopWithPriority(_))
+            .WillRepeatedly(Invoke(
+                [](const auto &f)
+                {
+                    f();
+                    return true;
+                }));
+        EXPECT_CALL(m_messageQueueMock, scheduleInEventLoopWithPriority(_))
+            .WillRepeatedly(Invoke(
+                [](const auto &f)
+                {
+                    f();
+                    return true;
+                }));
     }
 
     int32_t attachSource(RialtoMSEBaseSink *sink, const firebolt::rialto::MediaSourceType &type)
@@ -197,7 +222,7 @@ public:
     void allSourcesWantToPlaySynchronously()
     {
         EXPECT_CALL(*m_mediaPlayerClientBackendMock, play(_)).WillOnce(DoAll(SetArgReferee<0>(false), Return(true)));
-        EXPECT_CALL(*m_delegateMock, postAsyncStart());
+        EXPECT_CALL(*m_delegateMock, postAsyncStart()).Times(2);
         expectPostMessage();
         EXPECT_CALL(*m_delegateMock, handleStateChanged(firebolt::rialto::PlaybackState::PLAYING)).Times(2);
         m_sut->play(m_audioSourceId);
@@ -425,7 +450,7 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldNotifyNeedMediaDataWithNoSample
     expectCallInEventLoop();
     expectPostMessage();
     EXPECT_CALL(*m_delegateMock, isReadyToSendData()).WillOnce(Return(true));
-    EXPECT_CALL(*m_delegateMock, getFrontSample()).WillOnce(Invoke([]() { return GstRefSample{}; }));
+    EXPECT_CALL(*m_delegateMock, getFrontSample(_)).WillOnce(Invoke([]() { return GstRefSample{}; }));
     EXPECT_CALL(*m_delegateMock, isEos()).WillOnce(Return(false));
     EXPECT_CALL(bufferPullerMsgQueueMock, postMessage(_))
         .WillOnce(Invoke(
@@ -478,7 +503,7 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldNotifyNeedMediaDataWithEos)
     expectCallInEventLoop();
     expectPostMessage();
     EXPECT_CALL(*m_delegateMock, isReadyToSendData()).WillOnce(Return(true));
-    EXPECT_CALL(*m_delegateMock, getFrontSample()).WillOnce(Invoke([]() { return GstRefSample{}; }));
+    EXPECT_CALL(*m_delegateMock, getFrontSample(_)).WillOnce(Invoke([]() { return GstRefSample{}; }));
     EXPECT_CALL(*m_delegateMock, isEos()).WillOnce(Return(true));
     EXPECT_CALL(bufferPullerMsgQueueMock, postMessage(_))
         .WillOnce(Invoke(
@@ -503,7 +528,7 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldNotifyNeedMediaDataWithEmptySam
     const int32_t kSourceId{attachSource(audioSink, firebolt::rialto::MediaSourceType::AUDIO)};
 
     EXPECT_CALL(*m_delegateMock, isReadyToSendData()).WillOnce(Return(true));
-    EXPECT_CALL(*m_delegateMock, getFrontSample()).WillOnce(Invoke([&]() { return GstRefSample{}; }));
+    EXPECT_CALL(*m_delegateMock, getFrontSample(_)).WillOnce(Invoke([&]() { return GstRefSample{}; }));
     EXPECT_CALL(*m_delegateMock, isEos()).WillOnce(Return(false));
 
     expectCallInEventLoop();
@@ -534,7 +559,7 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldNotifyNeedMediaDataWithNoSpace)
     GstCaps *caps{gst_caps_new_simple("application/x-cenc", "rate", G_TYPE_INT, 1, "channels", G_TYPE_INT, 2, nullptr)};
     GstSample *sample{gst_sample_new(buffer, caps, nullptr, nullptr)};
     EXPECT_CALL(*m_delegateMock, isReadyToSendData()).WillOnce(Return(true));
-    EXPECT_CALL(*m_delegateMock, getFrontSample()).WillOnce(Invoke([&]() { return GstRefSample{sample}; }));
+    EXPECT_CALL(*m_delegateMock, getFrontSample(_)).WillOnce(Invoke([&]() { return GstRefSample{sample}; }));
 
     expectCallInEventLoop();
     expectPostMessage();
@@ -569,7 +594,7 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldNotifyNeedMediaData)
     GstCaps *caps{gst_caps_new_simple("application/x-cenc", "rate", G_TYPE_INT, 1, "channels", G_TYPE_INT, 2, nullptr)};
     GstSample *sample{gst_sample_new(buffer, caps, nullptr, nullptr)};
     EXPECT_CALL(*m_delegateMock, isReadyToSendData()).WillOnce(Return(true));
-    EXPECT_CALL(*m_delegateMock, getFrontSample()).WillOnce(Invoke([&]() { return GstRefSample{sample}; }));
+    EXPECT_CALL(*m_delegateMock, getFrontSample(_)).WillOnce(Invoke([&]() { return GstRefSample{sample}; }));
     EXPECT_CALL(*m_delegateMock, popSample());
 
     expectCallInEventLoop();
@@ -593,6 +618,58 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldNotifyNeedMediaData)
     gst_object_unref(audioSink);
 }
 
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldSendStagedSamplesOnNeedMediaData)
+{
+    constexpr uint64_t kSampleIndex{7};
+    RialtoMSEBaseSink *audioSink = createSinkWithMockedDelegate();
+
+    auto &bufferPullerMsgQueueMock{bufferPullerWillBeCreated()};
+    const int32_t kSourceId{attachSource(audioSink, firebolt::rialto::MediaSourceType::AUDIO)};
+
+    GstBuffer *buffer{gst_buffer_new()};
+    GstCaps *caps{gst_caps_new_simple("application/x-cenc", "rate", G_TYPE_INT, 1, "channels", G_TYPE_INT, 2, nullptr)};
+    GstSample *sample{gst_sample_new(buffer, caps, nullptr, nullptr)};
+
+    expectCallInEventLoop();
+    expectPostMessage();
+    EXPECT_CALL(m_messageQueueMock, scheduleInEventLoop(_))
+        .WillOnce(Invoke(
+            [](const auto &f)
+            {
+                f();
+                return true;
+            }));
+    EXPECT_CALL(bufferPullerMsgQueueMock, postMessage(_))
+        .Times(2)
+        .WillRepeatedly(Invoke(
+            [](const auto &msg)
+            {
+                msg->handle();
+                return true;
+            }));
+
+    // Sample is parsed while server is flushing
+    EXPECT_CALL(*m_delegateMock, getSample(0, _))
+        .WillOnce(DoAll(SetArgReferee<1>(kSampleIndex), Invoke([&]() { return GstRefSample{sample}; })));
+    EXPECT_CALL(*m_delegateMock, getSample(1, _)).WillOnce(Invoke([]() { return GstRefSample{}; }));
+    m_sut->stageSamples(kSourceId);
+
+    EXPECT_CALL(*m_delegateMock, isReadyToSendData()).WillOnce(Return(true));
+    EXPECT_CALL(*m_delegateMock, getFrontSample(_))
+        .WillOnce(DoAll(SetArgReferee<0>(kSampleIndex), Invoke([&]() { return GstRefSample{sample}; })));
+    EXPECT_CALL(*m_delegateMock, popSample());
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, addSegment(kNeedDataRequestId, _))
+        .WillOnce(Return(firebolt::rialto::AddSegmentStatus::OK));
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, haveData(firebolt::rialto::MediaSourceStatus::OK, kNeedDataRequestId))
+        .WillOnce(Return(true));
+    m_sut->notifyNeedMediaData(kSourceId, kFrameCount, kNeedDataRequestId, kShmInfo);
+
+    gst_caps_unref(caps);
+    gst_sample_unref(sample);
+    gst_buffer_unref(buffer);
+    gst_object_unref(audioSink);
+}
+
 TEST_F(GstreamerMseMediaPlayerClientTests, ShouldFailToNotifyQosWhenSourceIdIsNotKnown)
 {
     expectPostMessage();
@@ -788,6 +865,59 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldNotHandlePositionInfoWhenFlushi
     gst_object_unref(audioSink);
 }
 
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldExtrapolatePositionOnlyWhenPlaying)
+{
+    RialtoMSEBaseSink *audioSink = createAudioSink();
+    bufferPullerWillBeCreated();
+    const int32_t kSourceId{attachSource(audioSink, firebolt::rialto::MediaSourceType::AUDIO)};
+
+    expectPostMessage();
+    EXPECT_CALL(*m_delegateMock, handleStateChanged(firebolt::rialto::PlaybackState::PLAYING));
+    m_sut->notifyPlaybackState(firebolt::rialto::PlaybackState::PLAYING);
+    m_sut->notifyPlaybackInfo(firebolt::rialto::PlaybackInfo{kPosition, kVolume});
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_GT(m_sut->getPosition(kSourceId), kPosition);
+
+    expectPostMessage();
+    EXPECT_CALL(*m_delegateMock, handleStateChanged(firebolt::rialto::PlaybackState::PAUSED));
+    m_sut->notifyPlaybackState(firebolt::rialto::PlaybackState::PAUSED);
+    const int64_t kPausedPosition{m_sut->getPosition(kSourceId)};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(m_sut->getPosition(kSourceId), kPausedPosition);
+
+    gst_element_set_state(GST_ELEMENT_CAST(audioSink), GST_STATE_NULL);
+    gst_object_unref(audioSink);
+}
+
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldResumePositionExtrapolationWhenFlushIsCompleted)
+{
+    RialtoMSEBaseSink *audioSink = createAudioSink();
+    bufferPullerWillBeCreated();
+    const int32_t kSourceId{attachSource(audioSink, firebolt::rialto::MediaSourceType::AUDIO)};
+
+    expectPostMessage();
+    EXPECT_CALL(*m_delegateMock, handleStateChanged(firebolt::rialto::PlaybackState::PLAYING));
+    m_sut->notifyPlaybackState(firebolt::rialto::PlaybackState::PLAYING);
+    m_sut->notifyPlaybackInfo(firebolt::rialto::PlaybackInfo{kPosition, kVolume});
+
+    expectPostMessage();
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, flush(kSourceId, kResetTime, _)).WillOnce(Return(true));
+    EXPECT_CALL(*m_delegateMock, lostState());
+    m_sut->flush(kSourceId, kResetTime);
+    const int64_t kFlushPosition{m_sut->getPosition(kSourceId)};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(m_sut->getPosition(kSourceId), kFlushPosition);
+
+    expectPostMessage();
+    EXPECT_CALL(*m_delegateMock, handleFlushCompleted());
+    m_sut->notifySourceFlushed(kSourceId);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_GT(m_sut->getPosition(kSourceId), kFlushPosition);
+
+    gst_element_set_state(GST_ELEMENT_CAST(audioSink), GST_STATE_NULL);
+    gst_object_unref(audioSink);
+}
+
 TEST_F(GstreamerMseMediaPlayerClientTests, ShouldFailToCreateBackend)
 {
     EXPECT_CALL(*m_mediaPlayerClientBackendMock, createMediaPlayerBackend(_, kMaxVideoWidth, kMaxVideoHeight));
@@ -1101,6 +1231,108 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldStop)
     m_sut->stop();
 }
 
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldHandlePendingStateNotificationBeforePlayDecision)
+{
+    attachAudioVideo();
+    allSourcesWantToPause();
+
+    std::shared_ptr<Message> pendingMessage;
+    EXPECT_CALL(m_messageQueueMock, postMessageWithPriority(_))
+        .WillOnce(Invoke(
+            [&](const auto &msg)
+            {
+                pendingMessage = msg;
+                return true;
+            }));
+    m_sut->notifyPlaybackState(firebolt::rialto::PlaybackState::PAUSED);
+    ASSERT_TRUE(pendingMessage);
+
+    // Priority messages are handled in posting order, so the PAUSED notification is handled before the play decision
+    EXPECT_CALL(m_messageQueueMock, callInEventLoopWithPriority(_))
+        .WillRepeatedly(Invoke(
+            [&](const auto &f)
+            {
+                if (pendingMessage)
+                {
+                    auto message{std::move(pendingMessage)};
+                    message->handle();
+                }
+                f();
+                return true;
+            }));
+    EXPECT_CALL(*m_delegateMock, handleStateChanged(firebolt::rialto::PlaybackState::PAUSED)).Times(2);
+    allSourcesWantToPlay();
+
+    gst_element_set_state(GST_ELEMENT_CAST(m_audioSink), GST_STATE_NULL);
+    gst_element_set_state(GST_ELEMENT_CAST(m_videoSink), GST_STATE_NULL);
+    gst_object_unref(m_audioSink);
+    gst_object_unref(m_videoSink);
+}
+
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldNotWaitForQueuedDataMessagesToDecidePlay)
+{
+    attachAudioVideo();
+    allSourcesWantToPause();
+    serverTransitionedToPaused();
+
+    EXPECT_CALL(m_messageQueueMock, callInEventLoop(_)).Times(0);
+    allSourcesWantToPlay();
+
+    gst_element_set_state(GST_ELEMENT_CAST(m_audioSink), GST_STATE_NULL);
+    gst_element_set_state(GST_ELEMENT_CAST(m_videoSink), GST_STATE_NULL);
+    gst_object_unref(m_audioSink);
+    gst_object_unref(m_videoSink);
+}
+
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldNotStopWhenClientBackendIsDestroyed)
+{
+    expectCallInEventLoop();
+    m_sut->destroyClientBackend();
+    m_sut->stop();
+}
+
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldNotWaitForPauseCommand)
+{
+    attachAudioVideo();
+    std::function<void()> pauseCommand;
+    EXPECT_CALL(m_messageQueueMock, scheduleInEventLoopWithPriority(_))
+        .WillOnce(Invoke(
+            [&](const auto &f)
+            {
+                pauseCommand = f;
+                return true;
+            }));
+    EXPECT_CALL(*m_delegateMock, postAsyncStart()).Times(2);
+    EXPECT_EQ(m_sut->pause(m_audioSourceId), StateChangeResult::SUCCESS_ASYNC);
+    EXPECT_EQ(m_sut->pause(m_videoSourceId), StateChangeResult::SUCCESS_ASYNC);
+    EXPECT_EQ(m_sut->getClientState(), ClientState::AWAITING_PAUSED);
+
+    ASSERT_TRUE(pauseCommand);
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, pause()).WillOnce(Return(true));
+    pauseCommand();
+    serverTransitionedToPaused();
+
+    gst_element_set_state(GST_ELEMENT_CAST(m_audioSink), GST_STATE_NULL);
+    gst_element_set_state(GST_ELEMENT_CAST(m_videoSink), GST_STATE_NULL);
+    gst_object_unref(m_audioSink);
+    gst_object_unref(m_videoSink);
+}
+
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldReportFailureWhenPauseCommandFails)
+{
+    attachAudioVideo();
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, pause()).WillOnce(Return(false));
+    EXPECT_CALL(*m_delegateMock, postAsyncStart()).Times(2);
+    EXPECT_CALL(*m_delegateMock, handleError(_, 0)).Times(2);
+    m_sut->pause(m_audioSourceId);
+    m_sut->pause(m_videoSourceId);
+
+    gst_element_set_state(GST_ELEMENT_CAST(m_audioSink), GST_STATE_NULL);
+    gst_element_set_state(GST_ELEMENT_CAST(m_videoSink), GST_STATE_NULL);
+    gst_object_unref(m_audioSink);
+    gst_object_unref(m_videoSink);
+}
+
 TEST_F(GstreamerMseMediaPlayerClientTests, ShouldFailToNotifyThatSourceFinishedFlushWhenSourceIdIsNotFound)
 {
     expectCallInEventLoop();
@@ -1561,6 +1793,63 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldNotGetSyncIfNoClientBackend)
     EXPECT_FALSE(m_sut->getSync(sync));
 }
 
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldGetCachedSyncAfterSet)
+{
+    expectCallInEventLoop();
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, setSync(kSync)).WillOnce(Return(true));
+    EXPECT_TRUE(m_sut->setSync(kSync));
+
+    bool sync{!kSync};
+    EXPECT_TRUE(m_sut->getSync(sync));
+    EXPECT_EQ(sync, kSync);
+}
+
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldBypassCachedSync)
+{
+    expectCallInEventLoop();
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, setSync(kSync)).WillOnce(Return(true));
+    EXPECT_TRUE(m_sut->setSync(kSync));
+
+    // Changed by the server on its own
+    bool sync{kSync};
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, getSync(_)).WillOnce(DoAll(SetArgReferee<0>(!kSync), Return(true)));
+    EXPECT_TRUE(m_sut->getSync(sync, true));
+    EXPECT_EQ(sync, !kSync);
+
+    EXPECT_TRUE(m_sut->getSync(sync));
+    EXPECT_EQ(sync, !kSync);
+}
+
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldGetCachedStatsAndRefreshThemInBackground)
+{
+    constexpr int32_t kSourceId{1};
+    constexpr uint64_t kRenderedFrames{10};
+    constexpr uint64_t kDroppedFrames{2};
+    uint64_t renderedFrames{0};
+    uint64_t droppedFrames{0};
+
+    expectCallInEventLoop();
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, getStats(kSourceId, _, _))
+        .WillOnce(DoAll(SetArgReferee<1>(kRenderedFrames), SetArgReferee<2>(kDroppedFrames), Return(true)))
+        .WillRepeatedly(DoAll(SetArgReferee<1>(kRenderedFrames + 1), SetArgReferee<2>(kDroppedFrames), Return(true)));
+    EXPECT_TRUE(m_sut->getStats(kSourceId, renderedFrames, droppedFrames));
+    EXPECT_EQ(renderedFrames, kRenderedFrames);
+    EXPECT_EQ(droppedFrames, kDroppedFrames);
+
+    EXPECT_CALL(m_messageQueueMock, scheduleInEventLoop(_))
+        .Times(2)
+        .WillRepeatedly(Invoke(
+            [](const auto &f)
+            {
+                f();
+                return true;
+            }));
+    EXPECT_TRUE(m_sut->getStats(kSourceId, renderedFrames, droppedFrames));
+    EXPECT_EQ(renderedFrames, kRenderedFrames);
+    EXPECT_TRUE(m_sut->getStats(kSourceId, renderedFrames, droppedFrames));
+    EXPECT_EQ(renderedFrames, kRenderedFrames + 1);
+}
+
 TEST_F(GstreamerMseMediaPlayerClientTests, ShouldSetSyncOff)
 {
     expectCallInEventLoop();
@@ -1695,6 +1984,146 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldFailToAttachSourceWhenOperation
     gst_object_unref(sink);
 }
 
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldAttachSourceOutsideOfEventLoop)
+{
+    bool isInEventLoop{false};
+    std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> mediaSource{
+        std::make_unique<StrictMock<MediaSourceMock>>()};
+    StrictMock<MediaSourceMock> &mediaSourceMock{static_cast<StrictMock<MediaSourceMock> &>(*mediaSource)};
+    EXPECT_CALL(mediaSourceMock, getType()).WillRepeatedly(Return(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_CALL(m_messageQueueMock, callInEventLoop(_))
+        .WillOnce(Invoke(
+            [&](const auto &f)
+            {
+                isInEventLoop = true;
+                f();
+                isInEventLoop = false;
+                return true;
+            }));
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, attachSource(PtrMatcher(mediaSource.get())))
+        .WillOnce(Invoke(
+            [&](auto &)
+            {
+                EXPECT_FALSE(isInEventLoop);
+                return true;
+            }));
+    EXPECT_CALL(*m_delegateMock, setSourceId(_));
+    RialtoMSEBaseSink *sink = createAudioSink();
+    bufferPullerWillBeCreated();
+    EXPECT_TRUE(m_sut->attachSource(mediaSource, sink, m_delegateMock));
+
+    gst_element_set_state(GST_ELEMENT_CAST(sink), GST_STATE_NULL);
+    gst_object_unref(sink);
+}
+
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldAttachSourcesConcurrently)
+{
+    constexpr int32_t kAudioSourceId{100};
+    constexpr int32_t kVideoSourceId{101};
+    std::mutex eventLoopMutex;
+    std::mutex backendMutex;
+    std::condition_variable backendCv;
+    int backendCallsEntered{0};
+    std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> audioSource{
+        std::make_unique<StrictMock<MediaSourceMock>>()};
+    std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> videoSource{
+        std::make_unique<StrictMock<MediaSourceMock>>()};
+    audioSource->setId(kAudioSourceId);
+    videoSource->setId(kVideoSourceId);
+    EXPECT_CALL(static_cast<StrictMock<MediaSourceMock> &>(*audioSource), getType())
+        .WillRepeatedly(Return(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_CALL(static_cast<StrictMock<MediaSourceMock> &>(*videoSource), getType())
+        .WillRepeatedly(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(m_messageQueueMock, callInEventLoop(_))
+        .Times(2)
+        .WillRepeatedly(Invoke(
+            [&](const auto &f)
+            {
+                std::unique_lock lock{eventLoopMutex};
+                f();
+                return true;
+            }));
+    // Each attachment waits for the other one to enter the backend, so the test passes only if they overlap
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, attachSource(_))
+        .Times(2)
+        .WillRepeatedly(Invoke(
+            [&](auto &)
+            {
+                std::unique_lock lock{backendMutex};
+                ++backendCallsEntered;
+                backendCv.notify_all();
+                return backendCv.wait_for(lock, std::chrono::seconds{1}, [&]() { return backendCallsEntered == 2; });
+            }));
+    EXPECT_CALL(*m_delegateMock, setSourceId(kAudioSourceId));
+    EXPECT_CALL(*m_delegateMock, setSourceId(kVideoSourceId));
+    RialtoMSEBaseSink *audioSink = createAudioSink();
+    RialtoMSEBaseSink *videoSink = createVideoSink();
+    bufferPullerWillBeCreated();
+    bufferPullerWillBeCreated();
+
+    bool isAudioAttached{false};
+    std::thread audioThread{[&]() { isAudioAttached = m_sut->attachSource(audioSource, audioSink, m_delegateMock); }};
+    const bool kIsVideoAttached{m_sut->attachSource(videoSource, videoSink, m_delegateMock)};
+    audioThread.join();
+    EXPECT_TRUE(isAudioAttached);
+    EXPECT_TRUE(kIsVideoAttached);
+
+    gst_element_set_state(GST_ELEMENT_CAST(audioSink), GST_STATE_NULL);
+    gst_element_set_state(GST_ELEMENT_CAST(videoSink), GST_STATE_NULL);
+    gst_object_unref(audioSink);
+    gst_object_unref(videoSink);
+}
+
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldDeferNeedDataUntilSourceIsRegistered)
+{
+    constexpr int32_t kSourceId{200};
+    std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> mediaSource{
+        std::make_unique<StrictMock<MediaSourceMock>>()};
+    mediaSource->setId(kSourceId);
+    StrictMock<MediaSourceMock> &mediaSourceMock{static_cast<StrictMock<MediaSourceMock> &>(*mediaSource)};
+    EXPECT_CALL(mediaSourceMock, getType()).WillRepeatedly(Return(firebolt::rialto::MediaSourceType::AUDIO));
+    expectCallInEventLoop();
+    // Need data is handled before the registration. It must not be answered with an error, which would be a second
+    // posted message.
+    EXPECT_CALL(m_messageQueueMock, postMessage(_))
+        .WillOnce(Invoke(
+            [](const auto &msg)
+            {
+                msg->handle();
+                return true;
+            }));
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, attachSource(PtrMatcher(mediaSource.get())))
+        .WillOnce(Invoke(
+            [&](auto &)
+            {
+                m_sut->notifyNeedMediaData(kSourceId, kFrameCount, kNeedDataRequestId, kShmInfo);
+                return true;
+            }));
+    EXPECT_CALL(*m_delegateMock, setSourceId(kSourceId));
+    RialtoMSEBaseSink *sink = createAudioSink();
+    auto &bufferPullerMsgQueueMock{bufferPullerWillBeCreated()};
+    EXPECT_CALL(bufferPullerMsgQueueMock, postMessage(_)).WillOnce(Return(true));
+    EXPECT_TRUE(m_sut->attachSource(mediaSource, sink, m_delegateMock));
+
+    gst_element_set_state(GST_ELEMENT_CAST(sink), GST_STATE_NULL);
+    gst_object_unref(sink);
+}
+
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldFailToAttachSourceWhenClientBackendIsDestroyed)
+{
+    std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> mediaSource{
+        std::make_unique<StrictMock<MediaSourceMock>>()};
+    StrictMock<MediaSourceMock> &mediaSourceMock{static_cast<StrictMock<MediaSourceMock> &>(*mediaSource)};
+    EXPECT_CALL(mediaSourceMock, getType()).WillRepeatedly(Return(firebolt::rialto::MediaSourceType::AUDIO));
+    RialtoMSEBaseSink *sink = createAudioSink();
+
+    m_sut->destroyClientBackend();
+    EXPECT_FALSE(m_sut->attachSource(mediaSource, sink, m_delegateMock));
+
+    gst_element_set_state(GST_ELEMENT_CAST(sink), GST_STATE_NULL);
+    gst_object_unref(sink);
+}
+
 TEST_F(GstreamerMseMediaPlayerClientTests, ShouldAttachAudioSource)
 {
     RialtoMSEBaseSink *sink = createAudioSink();
@@ -1779,6 +2208,26 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldSendAllSourcesAttached)
     gst_object_unref(audioSink);
 }
 
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldReportFailureWhenPauseCommandFailsAfterAllSourcesAttached)
+{
+    constexpr int kAudioStreams{1}, kVideoStreams{0}, kSubtitleStreams{0};
+    RialtoMSEBaseSink *audioSink = createAudioSink();
+    bufferPullerWillBeCreated();
+    const int32_t kAudioSourceId = attachSource(audioSink, firebolt::rialto::MediaSourceType::AUDIO);
+    EXPECT_CALL(*m_delegateMock, postAsyncStart());
+    m_sut->pause(kAudioSourceId);
+
+    m_sut->handleStreamCollection(kAudioStreams, kVideoStreams, kSubtitleStreams);
+
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, allSourcesAttached()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mediaPlayerClientBackendMock, pause()).WillOnce(Return(false));
+    EXPECT_CALL(*m_delegateMock, handleError(_, 0));
+    m_sut->sendAllSourcesAttachedIfPossible();
+
+    gst_element_set_state(GST_ELEMENT_CAST(audioSink), GST_STATE_NULL);
+    gst_object_unref(audioSink);
+}
+
 TEST_F(GstreamerMseMediaPlayerClientTests, ShouldSetTextTrackIdentifier)
 {
     expectCallInEventLoop();
@@ -1842,6 +2291,16 @@ TEST_F(GstreamerMseMediaPlayerClientTests, ShouldGetDuration)
     EXPECT_EQ(duration, kDuration);
 }
 
+TEST_F(GstreamerMseMediaPlayerClientTests, ShouldGetNotifiedDurationWithoutIpc)
+{
+    expectPostMessage();
+    m_sut->notifyDuration(kDuration);
+
+    int64_t duration{-1};
+    EXPECT_TRUE(m_sut->getDuration(duration));
+    EXPECT_EQ(duration, kDuration);
+}
+
 TEST_F(GstreamerMseMediaPlayerClientTests, ShouldFailToGetDurationIfNoClientBackend)
 {
     // Need to create a new message queue as it has been moved
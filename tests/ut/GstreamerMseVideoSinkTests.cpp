@@ -763,3 +763,184 @@ TEST_F(GstreamerMseVideoSinkTests, ShouldSendQosEvent)
     gst_caps_unref(caps);
     gst_object_unref(pipeline);
 }
+
+TEST_F(GstreamerMseVideoSinkTests, ShouldSendQosEventWithJitterAndProportion)
+{
+    constexpr gint64 kPosition{1000000000};
+    constexpr gint64 kNextPosition{2000000000};
+    constexpr double kVolume{1.0};
+    constexpr double kExpectedProportion{2.0};
+    constexpr gint64 kExpectedJitter{500000000};
+    constexpr gint kExpectedQuality{500000};
+
+    RialtoMSEBaseSink *videoSink = createVideoSink();
+    GstElement *pipeline = createPipelineWithSink(videoSink);
+
+    setPausedState(pipeline, videoSink);
+    const int32_t kSourceId{videoSourceWillBeAttached(createDefaultMediaSource())};
+    allSourcesWillBeAttached();
+
+    GstCaps *caps{createDefaultCaps()};
+    setCaps(videoSink, caps);
+
+    sendPlaybackStateNotification(videoSink, firebolt::rialto::PlaybackState::PAUSED);
+
+    auto mediaPlayerClient{m_mediaPipelineClient.lock()};
+    ASSERT_TRUE(mediaPlayerClient);
+    sendPlaybackInfoNotification(videoSink, firebolt::rialto::PlaybackInfo{kPosition, kVolume});
+    mediaPlayerClient->notifyQos(kSourceId, firebolt::rialto::QosInfo{10, 0});
+    EXPECT_TRUE(waitForMessage(pipeline, GST_MESSAGE_QOS));
+
+    sendPlaybackInfoNotification(videoSink, firebolt::rialto::PlaybackInfo{kNextPosition, kVolume});
+    mediaPlayerClient->notifyQos(kSourceId, firebolt::rialto::QosInfo{20, 5});
+    GstMessage *message{getMessage(pipeline, GST_MESSAGE_QOS)};
+    ASSERT_TRUE(message);
+
+    GstClockTime runningTime{GST_CLOCK_TIME_NONE};
+    gst_message_parse_qos(message, nullptr, &runningTime, nullptr, nullptr, nullptr);
+    EXPECT_EQ(runningTime, kNextPosition);
+
+    gint64 jitter{0};
+    gdouble proportion{0.0};
+    gint quality{0};
+    gst_message_parse_qos_values(message, &jitter, &proportion, &quality);
+    EXPECT_EQ(jitter, kExpectedJitter);
+    EXPECT_DOUBLE_EQ(proportion, kExpectedProportion);
+    EXPECT_EQ(quality, kExpectedQuality);
+    gst_message_unref(message);
+
+    setNullState(pipeline, kSourceId);
+
+    gst_caps_unref(caps);
+    gst_object_unref(pipeline);
+}
+
+TEST_F(GstreamerMseVideoSinkTests, ShouldSetAndGetTrickPlayKeyframeRateProperty)
+{
+    constexpr gdouble kTrickPlayKeyframeRate{4.0};
+    RialtoMSEBaseSink *videoSink = createVideoSink();
+
+    gdouble trickPlayKeyframeRate{0.0};
+    g_object_get(videoSink, "trick-play-keyframe-rate", &trickPlayKeyframeRate, nullptr);
+    EXPECT_DOUBLE_EQ(trickPlayKeyframeRate, 2.0);
+
+    g_object_set(videoSink, "trick-play-keyframe-rate", kTrickPlayKeyframeRate, nullptr);
+    g_object_get(videoSink, "trick-play-keyframe-rate", &trickPlayKeyframeRate, nullptr);
+    EXPECT_DOUBLE_EQ(trickPlayKeyframeRate, kTrickPlayKeyframeRate);
+
+    gst_element_set_state(GST_ELEMENT_CAST(videoSink), GST_STATE_NULL);
+    gst_object_unref(videoSink);
+}
+
+TEST_F(GstreamerMseVideoSinkTests, ShouldDropDeltaFramesDuringTrickPlay)
+{
+    constexpr gdouble kRate{4.0};
+    RialtoMSEBaseSink *videoSink = createVideoSink();
+    g_object_set(videoSink, "enable-last-sample", TRUE, nullptr);
+
+    GstSegment *segment{gst_segment_new()};
+    gst_segment_init(segment, GST_FORMAT_TIME);
+    segment->rate = kRate;
+    EXPECT_TRUE(rialto_mse_base_sink_event(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink),
+                                           gst_event_new_segment(segment)));
+
+    GstBuffer *keyframe{gst_buffer_new()};
+    GstBuffer *keyframeRef{gst_buffer_ref(keyframe)};
+    EXPECT_EQ(GST_FLOW_OK, rialto_mse_base_sink_chain(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink), keyframe));
+
+    GstBuffer *deltaFrame{gst_buffer_new()};
+    GST_BUFFER_FLAG_SET(deltaFrame, GST_BUFFER_FLAG_DELTA_UNIT);
+    EXPECT_EQ(GST_FLOW_OK,
+              rialto_mse_base_sink_chain(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink), deltaFrame));
+
+    // Delta frame should not be queued, so keyframe is still the last sample
+    GstSample *lastSample{nullptr};
+    g_object_get(videoSink, "last-sample", &lastSample, nullptr);
+    ASSERT_NE(lastSample, nullptr);
+    EXPECT_EQ(gst_sample_get_buffer(lastSample), keyframeRef);
+    gst_sample_unref(lastSample);
+    gst_buffer_unref(keyframeRef);
+
+    gst_segment_free(segment);
+    gst_element_set_state(GST_ELEMENT_CAST(videoSink), GST_STATE_NULL);
+    gst_object_unref(videoSink);
+}
+
+TEST_F(GstreamerMseVideoSinkTests, ShouldDropLeadingDeltaFramesAfterFlush)
+{
+    RialtoMSEBaseSink *videoSink = createVideoSink();
+    g_object_set(videoSink, "enable-last-sample", TRUE, nullptr);
+
+    EXPECT_TRUE(rialto_mse_base_sink_event(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink),
+                                           gst_event_new_flush_start()));
+    EXPECT_TRUE(rialto_mse_base_sink_event(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink),
+                                           gst_event_new_flush_stop(TRUE)));
+
+    GstBuffer *deltaFrame{gst_buffer_new()};
+    GST_BUFFER_FLAG_SET(deltaFrame, GST_BUFFER_FLAG_DELTA_UNIT);
+    EXPECT_EQ(GST_FLOW_OK,
+              rialto_mse_base_sink_chain(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink), deltaFrame));
+
+    GstSample *lastSample{nullptr};
+    g_object_get(videoSink, "last-sample", &lastSample, nullptr);
+    EXPECT_EQ(lastSample, nullptr);
+
+    GstBuffer *keyframe{gst_buffer_new()};
+    GstBuffer *keyframeRef{gst_buffer_ref(keyframe)};
+    EXPECT_EQ(GST_FLOW_OK, rialto_mse_base_sink_chain(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink), keyframe));
+
+    // Delta frames following the keyframe should be queued
+    GstBuffer *nextDeltaFrame{gst_buffer_new()};
+    GstBuffer *nextDeltaFrameRef{gst_buffer_ref(nextDeltaFrame)};
+    GST_BUFFER_FLAG_SET(nextDeltaFrame, GST_BUFFER_FLAG_DELTA_UNIT);
+    EXPECT_EQ(GST_FLOW_OK,
+              rialto_mse_base_sink_chain(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink), nextDeltaFrame));
+
+    g_object_get(videoSink, "last-sample", &lastSample, nullptr);
+    ASSERT_NE(lastSample, nullptr);
+    EXPECT_EQ(gst_sample_get_buffer(lastSample), nextDeltaFrameRef);
+    gst_sample_unref(lastSample);
+    gst_buffer_unref(keyframeRef);
+    gst_buffer_unref(nextDeltaFrameRef);
+
+    gst_element_set_state(GST_ELEMENT_CAST(videoSink), GST_STATE_NULL);
+    gst_object_unref(videoSink);
+}
+
+TEST_F(GstreamerMseVideoSinkTests, ShouldStopWaitingForKeyframeAfterMaxLeadingDeltaFrames)
+{
+    constexpr int kMaxLeadingDeltaFrames{300};
+    RialtoMSEBaseSink *videoSink = createVideoSink();
+    g_object_set(videoSink, "enable-last-sample", TRUE, nullptr);
+
+    EXPECT_TRUE(rialto_mse_base_sink_event(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink),
+                                           gst_event_new_flush_start()));
+    EXPECT_TRUE(rialto_mse_base_sink_event(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink),
+                                           gst_event_new_flush_stop(TRUE)));
+
+    for (int i = 0; i < kMaxLeadingDeltaFrames; ++i)
+    {
+        GstBuffer *deltaFrame{gst_buffer_new()};
+        GST_BUFFER_FLAG_SET(deltaFrame, GST_BUFFER_FLAG_DELTA_UNIT);
+        EXPECT_EQ(GST_FLOW_OK,
+                  rialto_mse_base_sink_chain(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink), deltaFrame));
+    }
+
+    GstSample *lastSample{nullptr};
+    g_object_get(videoSink, "last-sample", &lastSample, nullptr);
+    EXPECT_EQ(lastSample, nullptr);
+
+    GstBuffer *deltaFrame{gst_buffer_new()};
+    GstBuffer *deltaFrameRef{gst_buffer_ref(deltaFrame)};
+    GST_BUFFER_FLAG_SET(deltaFrame, GST_BUFFER_FLAG_DELTA_UNIT);
+    EXPECT_EQ(GST_FLOW_OK, rialto_mse_base_sink_chain(videoSink->priv->m_sinkPad, GST_OBJECT_CAST(videoSink), deltaFrame));
+
+    g_object_get(videoSink, "last-sample", &lastSample, nullptr);
+    ASSERT_NE(lastSample, nullptr);
+    EXPECT_EQ(gst_sample_get_buffer(lastSample), deltaFrameRef);
+    gst_sample_unref(lastSample);
+    gst_buffer_unref(deltaFrameRef);
+
+    gst_element_set_state(GST_ELEMENT_CAST(videoSink), GST_STATE_NULL);
+    gst_object_unref(videoSink);
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "LatencyHistogram.h"
+#include <gst/gst.h>
+#include <gtest/gtest.h>
+
+TEST(LatencyHistogramTests, ShouldPutDurationsInBuckets)
+{
+    LatencyHistogram histogram;
+    histogram.add(std::chrono::microseconds{100});
+    histogram.add(std::chrono::microseconds{101});
+    histogram.add(std::chrono::seconds{1});
+
+    EXPECT_EQ(histogram.getCount(), 3u);
+    EXPECT_EQ(histogram.getSumUs(), 1000201u);
+    EXPECT_EQ(histogram.getMaxUs(), 1000000u);
+    EXPECT_EQ(histogram.getMeanUs(), 333400u);
+    EXPECT_EQ(histogram.getBuckets()[0], 1u);
+    EXPECT_EQ(histogram.getBuckets()[1], 1u);
+    EXPECT_EQ(histogram.getBuckets().back(), 1u);
+}
+
+TEST(LatencyHistogramTests, ShouldReturnZeroMeanWhenEmpty)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.getMeanUs(), 0u);
+}
+
+TEST(LatencyHistogramTests, ShouldAddToStructure)
+{
+    LatencyHistogram histogram;
+    histogram.add(std::chrono::microseconds{300});
+
+    GstStructure *structure{gst_structure_new_empty("stats")};
+    histogram.addToStructure(structure, "latency");
+
+    GstStructure *latency{nullptr};
+    ASSERT_TRUE(gst_structure_get(structure, "latency", GST_TYPE_STRUCTURE, &latency, nullptr));
+    guint64 maxUs{0};
+    EXPECT_TRUE(gst_structure_get_uint64(latency, "max-us", &maxUs));
+    EXPECT_EQ(maxUs, 300u);
+    const GValue *kBounds{gst_structure_get_value(latency, "bucket-bounds-us")};
+    ASSERT_NE(kBounds, nullptr);
+    EXPECT_EQ(gst_value_array_get_size(kBounds), LatencyHistogram::kBucketBoundsUs.size());
+
+    gst_structure_free(latency);
+    gst_structure_free(structure);
+}
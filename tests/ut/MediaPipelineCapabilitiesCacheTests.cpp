@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "MediaPipelineCapabilitiesCache.h"
+#include "MediaPipelineCapabilitiesMock.h"
+#include "MessageQueueMock.h"
+#include <cstdio>
+#include <gtest/gtest.h>
+
+using firebolt::rialto::IMediaPipelineCapabilitiesFactory;
+using firebolt::rialto::MediaPipelineCapabilitiesFactoryMock;
+using firebolt::rialto::MediaPipelineCapabilitiesMock;
+using firebolt::rialto::MediaSourceType;
+using testing::_;
+using testing::ByMove;
+using testing::Invoke;
+using testing::Return;
+using testing::StrictMock;
+
+namespace
+{
+const std::string kKey{"/tmp/rialto-0;1.0"};
+const std::vector<std::string> kMimeTypes{"audio/mp4", "audio/x-opus"};
+const std::vector<std::string> kPropertyNames{"low-latency", "sync"};
+const std::vector<std::string> kSupportedProperties{"sync"};
+} // namespace
+
+class MediaPipelineCapabilitiesCacheTests : public testing::Test
+{
+public:
+    MediaPipelineCapabilitiesCacheTests() { std::remove(m_path.c_str()); }
+    ~MediaPipelineCapabilitiesCacheTests() override { std::remove(m_path.c_str()); }
+
+    std::unique_ptr<MediaPipelineCapabilitiesCache> createCache(const std::string &key = kKey)
+    {
+        return std::make_unique<MediaPipelineCapabilitiesCache>(m_messageQueueFactoryMock, m_path, key);
+    }
+
+    void expectServerQuery(const std::vector<std::string> &mimeTypes,
+                           MediaSourceType sourceType = MediaSourceType::AUDIO)
+    {
+        auto capabilitiesMock{std::make_unique<StrictMock<MediaPipelineCapabilitiesMock>>()};
+        EXPECT_CALL(*capabilitiesMock, getSupportedMimeTypes(sourceType)).WillOnce(Return(mimeTypes));
+        EXPECT_CALL(*m_capabilitiesFactoryMock, createMediaPipelineCapabilities())
+            .WillOnce(Return(ByMove(std::move(capabilitiesMock))));
+    }
+
+    void expectRevalidation()
+    {
+        auto messageQueueMock{std::make_unique<StrictMock<MessageQueueMock>>()};
+        EXPECT_CALL(*messageQueueMock, start());
+        EXPECT_CALL(*messageQueueMock, scheduleInEventLoop(_))
+            .WillOnce(Invoke(
+                [](const std::function<void()> &func)
+                {
+                    func();
+                    return true;
+                }));
+        EXPECT_CALL(*messageQueueMock, stop());
+        EXPECT_CALL(*m_messageQueueFactoryMock, createMessageQueue())
+            .WillOnce(Return(ByMove(std::move(messageQueueMock))));
+    }
+
+    const std::string m_path{testing::TempDir() + "rialto-capabilities-cache-test"};
+    std::shared_ptr<StrictMock<MediaPipelineCapabilitiesFactoryMock>> m_capabilitiesFactoryMock{
+        std::dynamic_pointer_cast<StrictMock<MediaPipelineCapabilitiesFactoryMock>>(
+            IMediaPipelineCapabilitiesFactory::createFactory())};
+    std::shared_ptr<StrictMock<MessageQueueFactoryMock>> m_messageQueueFactoryMock{
+        std::make_shared<StrictMock<MessageQueueFactoryMock>>()};
+};
+
+TEST_F(MediaPipelineCapabilitiesCacheTests, ShouldServeMimeTypesFromCacheFileAndRevalidate)
+{
+    expectServerQuery(kMimeTypes);
+    EXPECT_EQ(createCache()->getSupportedMimeTypes(MediaSourceType::AUDIO), kMimeTypes);
+
+    const std::vector<std::string> kUpdatedMimeTypes{"audio/mp4"};
+    expectRevalidation();
+    expectServerQuery(kUpdatedMimeTypes);
+    EXPECT_EQ(createCache()->getSupportedMimeTypes(MediaSourceType::AUDIO), kMimeTypes);
+
+    expectRevalidation();
+    expectServerQuery(kUpdatedMimeTypes);
+    EXPECT_EQ(createCache()->getSupportedMimeTypes(MediaSourceType::AUDIO), kUpdatedMimeTypes);
+}
+
+TEST_F(MediaPipelineCapabilitiesCacheTests, ShouldServePropertiesFromCacheOnlyForSameQuery)
+{
+    auto capabilitiesMock{std::make_unique<StrictMock<MediaPipelineCapabilitiesMock>>()};
+    EXPECT_CALL(*capabilitiesMock, getSupportedProperties(MediaSourceType::AUDIO, kPropertyNames))
+        .WillOnce(Return(kSupportedProperties));
+    EXPECT_CALL(*m_capabilitiesFactoryMock, createMediaPipelineCapabilities())
+        .WillOnce(Return(ByMove(std::move(capabilitiesMock))));
+    EXPECT_EQ(createCache()->getSupportedProperties(MediaSourceType::AUDIO, kPropertyNames), kSupportedProperties);
+
+    const std::vector<std::string> kOtherPropertyNames{"sync"};
+    capabilitiesMock = std::make_unique<StrictMock<MediaPipelineCapabilitiesMock>>();
+    EXPECT_CALL(*capabilitiesMock, getSupportedProperties(MediaSourceType::AUDIO, kOtherPropertyNames))
+        .WillOnce(Return(kSupportedProperties));
+    EXPECT_CALL(*m_capabilitiesFactoryMock, createMediaPipelineCapabilities())
+        .WillOnce(Return(ByMove(std::move(capabilitiesMock))));
+    EXPECT_EQ(createCache()->getSupportedProperties(MediaSourceType::AUDIO, kOtherPropertyNames), kSupportedProperties);
+}
+
+TEST_F(MediaPipelineCapabilitiesCacheTests, ShouldDiscardCacheOfOtherServer)
+{
+    expectServerQuery(kMimeTypes);
+    EXPECT_EQ(createCache()->getSupportedMimeTypes(MediaSourceType::AUDIO), kMimeTypes);
+
+    expectServerQuery(kMimeTypes);
+    EXPECT_EQ(createCache("/tmp/rialto-1;1.0")->getSupportedMimeTypes(MediaSourceType::AUDIO), kMimeTypes);
+}
+
+TEST_F(MediaPipelineCapabilitiesCacheTests, ShouldNotCacheEmptyMimeTypes)
+{
+    expectServerQuery({});
+    EXPECT_TRUE(createCache()->getSupportedMimeTypes(MediaSourceType::AUDIO).empty());
+
+    expectServerQuery(kMimeTypes);
+    EXPECT_EQ(createCache()->getSupportedMimeTypes(MediaSourceType::AUDIO), kMimeTypes);
+}
+
+TEST_F(MediaPipelineCapabilitiesCacheTests, ShouldInvalidateWholeCacheWhenRevalidationFindsChange)
+{
+    const std::vector<std::string> kVideoMimeTypes{"video/h264"};
+    std::unique_ptr<MediaPipelineCapabilitiesCache> cache{createCache()};
+    expectServerQuery(kMimeTypes);
+    EXPECT_EQ(cache->getSupportedMimeTypes(MediaSourceType::AUDIO), kMimeTypes);
+    expectServerQuery(kVideoMimeTypes, MediaSourceType::VIDEO);
+    EXPECT_EQ(cache->getSupportedMimeTypes(MediaSourceType::VIDEO), kVideoMimeTypes);
+
+    const std::vector<std::string> kUpdatedMimeTypes{"audio/mp4"};
+    cache = createCache();
+    expectRevalidation();
+    expectServerQuery(kUpdatedMimeTypes);
+    EXPECT_EQ(cache->getSupportedMimeTypes(MediaSourceType::AUDIO), kMimeTypes);
+
+    // Video answer was cached by the same outdated server, so it is queried again instead of being served from cache
+    expectServerQuery(kVideoMimeTypes, MediaSourceType::VIDEO);
+    EXPECT_EQ(cache->getSupportedMimeTypes(MediaSourceType::VIDEO), kVideoMimeTypes);
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "MediaPipelineMock.h"
+#include "MediaPlayerClientPool.h"
+#include "MessageQueueMock.h"
+#include <gtest/gtest.h>
+
+using firebolt::rialto::IMediaPipelineClient;
+using firebolt::rialto::IMediaPipelineFactory;
+using firebolt::rialto::MediaPipelineFactoryMock;
+using firebolt::rialto::MediaPipelineMock;
+using testing::_;
+using testing::ByMove;
+using testing::Invoke;
+using testing::Return;
+using testing::StrictMock;
+
+namespace
+{
+constexpr uint32_t kMaxVideoWidth{1920};
+constexpr uint32_t kMaxVideoHeight{1080};
+constexpr size_t kPoolSize{1};
+} // namespace
+
+class MediaPlayerClientPoolTests : public testing::Test
+{
+public:
+    std::shared_ptr<StrictMock<MediaPipelineFactoryMock>> m_mediaPipelineFactoryMock{
+        std::dynamic_pointer_cast<StrictMock<MediaPipelineFactoryMock>>(IMediaPipelineFactory::createFactory())};
+    std::unique_ptr<StrictMock<MediaPipelineMock>> m_mediaPipelineMock{std::make_unique<StrictMock<MediaPipelineMock>>()};
+    StrictMock<MediaPipelineMock> *m_mediaPipelineMockPtr{m_mediaPipelineMock.get()};
+    std::shared_ptr<StrictMock<MessageQueueFactoryMock>> m_messageQueueFactoryMock{
+        std::make_shared<StrictMock<MessageQueueFactoryMock>>()};
+    std::unique_ptr<StrictMock<MessageQueueMock>> m_messageQueueMock{std::make_unique<StrictMock<MessageQueueMock>>()};
+    StrictMock<MessageQueueMock> *m_messageQueueMockPtr{m_messageQueueMock.get()};
+    std::weak_ptr<IMediaPipelineClient> m_mediaPipelineClient;
+
+    std::unique_ptr<MediaPlayerClientPool> createPool()
+    {
+        EXPECT_CALL(*m_messageQueueMockPtr, start());
+        EXPECT_CALL(*m_messageQueueFactoryMock, createMessageQueue())
+            .WillOnce(Return(ByMove(std::move(m_messageQueueMock))));
+        return std::make_unique<MediaPlayerClientPool>(m_messageQueueFactoryMock, kPoolSize);
+    }
+
+    void expectCreateClient()
+    {
+        EXPECT_CALL(*m_mediaPipelineMockPtr, load(_, _, _, _)).WillOnce(Return(true));
+        EXPECT_CALL(*m_mediaPipelineFactoryMock, createMediaPipeline(_, _))
+            .WillOnce(Invoke(
+                [this](std::weak_ptr<IMediaPipelineClient> client, const firebolt::rialto::VideoRequirements &)
+                {
+                    m_mediaPipelineClient = client;
+                    return std::move(m_mediaPipelineMock);
+                }));
+    }
+
+    void expectRefill()
+    {
+        EXPECT_CALL(*m_messageQueueMockPtr, scheduleInEventLoop(_))
+            .WillOnce(Invoke(
+                [](const std::function<void()> &func)
+                {
+                    func();
+                    return true;
+                }));
+    }
+};
+
+TEST_F(MediaPlayerClientPoolTests, ShouldNotPrewarmClientsWhenPoolIsDisabled)
+{
+    MediaPlayerClientPool sut{m_messageQueueFactoryMock, 0};
+    sut.refill(kMaxVideoWidth, kMaxVideoHeight, false);
+    EXPECT_FALSE(sut.claim(kMaxVideoWidth, kMaxVideoHeight, false));
+}
+
+TEST_F(MediaPlayerClientPoolTests, ShouldClaimPrewarmedClient)
+{
+    std::unique_ptr<MediaPlayerClientPool> sut{createPool()};
+
+    expectRefill();
+    EXPECT_CALL(*m_mediaPipelineMockPtr, load(_, _, _, _)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mediaPipelineFactoryMock, createMediaPipeline(_, _))
+        .WillOnce(Return(ByMove(std::move(m_mediaPipelineMock))));
+    sut->refill(kMaxVideoWidth, kMaxVideoHeight, false);
+
+    EXPECT_FALSE(sut->claim(kMaxVideoWidth / 2, kMaxVideoHeight / 2, false));
+    EXPECT_FALSE(sut->claim(kMaxVideoWidth, kMaxVideoHeight, true));
+    EXPECT_TRUE(sut->claim(kMaxVideoWidth, kMaxVideoHeight, false));
+    EXPECT_FALSE(sut->claim(kMaxVideoWidth, kMaxVideoHeight, false));
+
+    EXPECT_CALL(*m_messageQueueMockPtr, stop());
+}
+
+TEST_F(MediaPlayerClientPoolTests, ShouldReleasePrewarmedClientsWhenVideoRequirementsChange)
+{
+    std::unique_ptr<MediaPlayerClientPool> sut{createPool()};
+
+    expectRefill();
+    EXPECT_CALL(*m_mediaPipelineMockPtr, load(_, _, _, _)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mediaPipelineFactoryMock, createMediaPipeline(_, _))
+        .WillOnce(Return(ByMove(std::move(m_mediaPipelineMock))));
+    sut->refill(kMaxVideoWidth, kMaxVideoHeight, false);
+
+    expectRefill();
+    EXPECT_CALL(*m_mediaPipelineFactoryMock, createMediaPipeline(_, _)).WillOnce(Return(nullptr));
+    sut->refill(kMaxVideoWidth / 2, kMaxVideoHeight / 2, false);
+    EXPECT_FALSE(sut->claim(kMaxVideoWidth, kMaxVideoHeight, false));
+
+    EXPECT_CALL(*m_messageQueueMockPtr, stop());
+}
+
+TEST_F(MediaPlayerClientPoolTests, ShouldDiscardUnhealthyPrewarmedClient)
+{
+    std::unique_ptr<MediaPlayerClientPool> sut{createPool()};
+
+    expectRefill();
+    expectCreateClient();
+    sut->refill(kMaxVideoWidth, kMaxVideoHeight, false);
+
+    std::shared_ptr<IMediaPipelineClient> client{m_mediaPipelineClient.lock()};
+    ASSERT_TRUE(client);
+    client->notifyPlaybackState(firebolt::rialto::PlaybackState::FAILURE);
+
+    expectRefill();
+    EXPECT_FALSE(sut->claim(kMaxVideoWidth, kMaxVideoHeight, false));
+
+    EXPECT_CALL(*m_messageQueueMockPtr, stop());
+}
+
+TEST_F(MediaPlayerClientPoolTests, ShouldPrimeEnabledPool)
+{
+    MediaPlayerClientPool sut{m_messageQueueFactoryMock, 0};
+    EXPECT_CALL(*m_messageQueueMockPtr, start());
+    EXPECT_CALL(*m_messageQueueFactoryMock, createMessageQueue())
+        .WillOnce(Return(ByMove(std::move(m_messageQueueMock))));
+    expectRefill();
+    expectCreateClient();
+    sut.setSize(kPoolSize);
+    EXPECT_EQ(sut.getSize(), kPoolSize);
+
+    EXPECT_TRUE(sut.claim(0, 0, false));
+
+    EXPECT_CALL(*m_messageQueueMockPtr, stop());
+}
+
+TEST_F(MediaPlayerClientPoolTests, ShouldReleasePrewarmedClientsOnShutdown)
+{
+    std::unique_ptr<MediaPlayerClientPool> sut{createPool()};
+
+    expectRefill();
+    expectCreateClient();
+    sut->refill(kMaxVideoWidth, kMaxVideoHeight, false);
+
+    EXPECT_CALL(*m_messageQueueMockPtr, stop());
+    sut->shutdown();
+    EXPECT_EQ(sut->getSize(), 0u);
+    EXPECT_FALSE(sut->claim(kMaxVideoWidth, kMaxVideoHeight, false));
+    EXPECT_TRUE(m_mediaPipelineClient.expired());
+
+    sut->refill(kMaxVideoWidth, kMaxVideoHeight, false);
+}
@@ -18,14 +18,19 @@
 
 #include "MediaPipelineMock.h"
 #include "MediaPlayerManager.h"
+#include "MediaSourceMock.h"
+#include "PullModePlaybackDelegateMock.h"
 #include <gst/gst.h>
 #include <gtest/gtest.h>
+#include <thread>
 
 using firebolt::rialto::IMediaPipelineFactory;
 using firebolt::rialto::MediaPipelineFactoryMock;
 using firebolt::rialto::MediaPipelineMock;
+using firebolt::rialto::MediaSourceMock;
 using testing::_;
 using testing::ByMove;
+using testing::NiceMock;
 using testing::Return;
 using testing::StrictMock;
 
@@ -33,17 +38,46 @@ namespace
 {
 constexpr uint32_t kMaxVideoWidth{1920};
 constexpr uint32_t kMaxVideoHeight{1080};
+constexpr int32_t kAudioSourceId{1};
+constexpr int32_t kVideoSourceId{2};
 } // namespace
 
 class MediaPlayerManagerTests : public testing::Test
 {
 public:
     MediaPlayerManagerTests() {}
+    ~MediaPlayerManagerTests() override
+    {
+        unsetenv("RIALTO_SINKS_SESSION_HANDOVER_MS");
+        MediaPlayerManager::destroyParkedClient();
+    }
+
+    void attachSource(const std::shared_ptr<GStreamerMSEMediaPlayerClient> &client, int32_t sourceId,
+                      firebolt::rialto::MediaSourceType type)
+    {
+        std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSource> mediaSource{
+            std::make_unique<NiceMock<MediaSourceMock>>()};
+        mediaSource->setId(sourceId);
+        ON_CALL(static_cast<NiceMock<MediaSourceMock> &>(*mediaSource), getType()).WillByDefault(Return(type));
+        EXPECT_TRUE(client->attachSource(mediaSource, nullptr, m_delegateMock));
+    }
+
+    void attachAudioVideo(const std::shared_ptr<GStreamerMSEMediaPlayerClient> &client)
+    {
+        EXPECT_CALL(*m_mediaPipelineMockPtr, attachSource(_)).Times(2).WillRepeatedly(Return(true));
+        EXPECT_CALL(*m_mediaPipelineMockPtr, allSourcesAttached()).WillOnce(Return(true));
+        client->handleStreamCollection(1, 1, 0);
+        attachSource(client, kAudioSourceId, firebolt::rialto::MediaSourceType::AUDIO);
+        attachSource(client, kVideoSourceId, firebolt::rialto::MediaSourceType::VIDEO);
+    }
+
     GstObject m_object{};
     std::shared_ptr<StrictMock<MediaPipelineFactoryMock>> m_mediaPipelineFactoryMock{
         std::dynamic_pointer_cast<StrictMock<MediaPipelineFactoryMock>>(IMediaPipelineFactory::createFactory())};
     std::unique_ptr<StrictMock<MediaPipelineMock>> m_mediaPipelineMock{std::make_unique<StrictMock<MediaPipelineMock>>()};
     StrictMock<MediaPipelineMock> *m_mediaPipelineMockPtr{m_mediaPipelineMock.get()};
+    std::shared_ptr<NiceMock<PullModePlaybackDelegateMock>> m_delegateMock{
+        std::make_shared<NiceMock<PullModePlaybackDelegateMock>>()};
     MediaPlayerManager m_sut;
 };
 
@@ -156,3 +190,79 @@ TEST_F(MediaPlayerManagerTests, ShouldAcquireControl)
     EXPECT_CALL(*m_mediaPipelineMockPtr, stop()).WillOnce(Return(true));
     m_sut.releaseMediaPlayerClient();
 }
+
+TEST_F(MediaPlayerManagerTests, ShouldHandOverParkedMediaPlayerClientToNewGstObject)
+{
+    setenv("RIALTO_SINKS_SESSION_HANDOVER_MS", "10000", 1);
+    EXPECT_CALL(*m_mediaPipelineMockPtr, load(_, _, _, _)).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mediaPipelineFactoryMock, createMediaPipeline(_, _))
+        .WillOnce(Return(ByMove(std::move(m_mediaPipelineMock))));
+    EXPECT_TRUE(m_sut.attachMediaPlayerClient(&m_object, kMaxVideoWidth, kMaxVideoHeight));
+    std::shared_ptr<GStreamerMSEMediaPlayerClient> firstClient{m_sut.getMediaPlayerClient()};
+
+    EXPECT_CALL(*m_mediaPipelineMockPtr, stop()).WillOnce(Return(true));
+    m_sut.releaseMediaPlayerClient();
+    unsetenv("RIALTO_SINKS_SESSION_HANDOVER_MS");
+
+    GstObject anotherObject{};
+    EXPECT_TRUE(m_sut.attachMediaPlayerClient(&anotherObject, kMaxVideoWidth, kMaxVideoHeight));
+    EXPECT_EQ(m_sut.getMediaPlayerClient(), firstClient);
+    EXPECT_TRUE(m_sut.hasControl());
+
+    EXPECT_CALL(*m_mediaPipelineMockPtr, stop()).WillOnce(Return(true));
+    m_sut.releaseMediaPlayerClient();
+}
+
+TEST_F(MediaPlayerManagerTests, ShouldAttachAudioAndVideoToAdoptedMediaPlayerClient)
+{
+    setenv("RIALTO_SINKS_SESSION_HANDOVER_MS", "10000", 1);
+    EXPECT_CALL(*m_mediaPipelineMockPtr, load(_, _, _, _)).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mediaPipelineFactoryMock, createMediaPipeline(_, _))
+        .WillOnce(Return(ByMove(std::move(m_mediaPipelineMock))));
+    EXPECT_TRUE(m_sut.attachMediaPlayerClient(&m_object, kMaxVideoWidth, kMaxVideoHeight));
+    std::shared_ptr<GStreamerMSEMediaPlayerClient> client{m_sut.getMediaPlayerClient()};
+    attachAudioVideo(client);
+
+    // Sources of the previous playback are removed from the server before the client is parked
+    EXPECT_CALL(*m_mediaPipelineMockPtr, stop()).WillOnce(Return(true));
+    EXPECT_CALL(*m_mediaPipelineMockPtr, removeSource(kAudioSourceId)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mediaPipelineMockPtr, removeSource(kVideoSourceId)).WillOnce(Return(true));
+    m_sut.releaseMediaPlayerClient();
+
+    GstObject anotherObject{};
+    EXPECT_TRUE(m_sut.attachMediaPlayerClient(&anotherObject, kMaxVideoWidth, kMaxVideoHeight));
+    ASSERT_EQ(m_sut.getMediaPlayerClient(), client);
+    attachAudioVideo(client);
+
+    unsetenv("RIALTO_SINKS_SESSION_HANDOVER_MS");
+    EXPECT_CALL(*m_mediaPipelineMockPtr, stop()).WillOnce(Return(true));
+    m_sut.releaseMediaPlayerClient();
+}
+
+TEST_F(MediaPlayerManagerTests, ShouldDestroyParkedMediaPlayerClientWhenHandoverPeriodExpires)
+{
+    setenv("RIALTO_SINKS_SESSION_HANDOVER_MS", "10", 1);
+    EXPECT_CALL(*m_mediaPipelineMockPtr, load(_, _, _, _)).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mediaPipelineFactoryMock, createMediaPipeline(_, _))
+        .WillOnce(Return(ByMove(std::move(m_mediaPipelineMock))));
+    EXPECT_TRUE(m_sut.attachMediaPlayerClient(&m_object, kMaxVideoWidth, kMaxVideoHeight));
+    std::shared_ptr<GStreamerMSEMediaPlayerClient> firstClient{m_sut.getMediaPlayerClient()};
+
+    EXPECT_CALL(*m_mediaPipelineMockPtr, stop()).WillOnce(Return(true));
+    m_sut.releaseMediaPlayerClient();
+    unsetenv("RIALTO_SINKS_SESSION_HANDOVER_MS");
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    std::unique_ptr<StrictMock<MediaPipelineMock>> secondMediaPipelineMock{
+        std::make_unique<StrictMock<MediaPipelineMock>>()};
+    StrictMock<MediaPipelineMock> *secondMediaPipelineMockPtr{secondMediaPipelineMock.get()};
+    EXPECT_CALL(*secondMediaPipelineMockPtr, load(_, _, _, _)).WillOnce(Return(true));
+    EXPECT_CALL(*m_mediaPipelineFactoryMock, createMediaPipeline(_, _))
+        .WillOnce(Return(ByMove(std::move(secondMediaPipelineMock))));
+    GstObject anotherObject{};
+    EXPECT_TRUE(m_sut.attachMediaPlayerClient(&anotherObject, kMaxVideoWidth, kMaxVideoHeight));
+    EXPECT_NE(m_sut.getMediaPlayerClient(), firstClient);
+
+    EXPECT_CALL(*secondMediaPipelineMockPtr, stop()).WillOnce(Return(true));
+    m_sut.releaseMediaPlayerClient();
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "MessageQueueStats.h"
+#include <gtest/gtest.h>
+#include <stdlib.h>
+
+namespace
+{
+constexpr std::chrono::microseconds kWaitTime{700};
+constexpr std::chrono::microseconds kShortHandlerTime{20};
+constexpr std::chrono::microseconds kLongHandlerTime{3000};
+const std::string kQueueName{"backend"};
+
+struct ShortMessage
+{
+};
+struct LongMessage
+{
+};
+} // namespace
+
+class MessageQueueStatsTests : public testing::Test
+{
+protected:
+    MessageQueueStats m_sut{kQueueName};
+};
+
+TEST_F(MessageQueueStatsTests, ShouldTrackDepthHighWaterMark)
+{
+    m_sut.onPosted(1);
+    m_sut.onPosted(2);
+    m_sut.onDequeued(1, kWaitTime);
+    m_sut.onPosted(2);
+
+    const auto kSnapshot{m_sut.getSnapshot()};
+    EXPECT_EQ(kSnapshot.queueName, kQueueName);
+    EXPECT_EQ(kSnapshot.depth, 2u);
+    EXPECT_EQ(kSnapshot.maxDepth, 2u);
+    EXPECT_EQ(kSnapshot.postedCount, 3u);
+    EXPECT_EQ(kSnapshot.wait.getCount(), 1u);
+    EXPECT_EQ(kSnapshot.wait.getMaxUs(), static_cast<uint64_t>(kWaitTime.count()));
+}
+
+TEST_F(MessageQueueStatsTests, ShouldSortHandlersByTotalTime)
+{
+    m_sut.onHandled(typeid(ShortMessage), kShortHandlerTime);
+    m_sut.onHandled(typeid(ShortMessage), kShortHandlerTime);
+    m_sut.onHandled(typeid(LongMessage), kLongHandlerTime);
+
+    const auto kSnapshot{m_sut.getSnapshot()};
+    ASSERT_EQ(kSnapshot.handlers.size(), 2u);
+    EXPECT_NE(kSnapshot.handlers[0].name.find("LongMessage"), std::string::npos);
+    EXPECT_EQ(kSnapshot.handlers[0].duration.getCount(), 1u);
+    EXPECT_NE(kSnapshot.handlers[1].name.find("ShortMessage"), std::string::npos);
+    EXPECT_EQ(kSnapshot.handlers[1].duration.getCount(), 2u);
+}
+
+TEST_F(MessageQueueStatsTests, ShouldDumpQueueAndHandlers)
+{
+    m_sut.onPosted(1);
+    m_sut.onHandled(typeid(LongMessage), kLongHandlerTime);
+
+    const auto kLines{MessageQueueStats::dump(m_sut.getSnapshot())};
+    ASSERT_EQ(kLines.size(), 2u);
+    EXPECT_NE(kLines[0].find("queue backend: depth 1 (max 1)"), std::string::npos);
+    EXPECT_NE(kLines[1].find("LongMessage: 1 calls"), std::string::npos);
+}
+
+TEST_F(MessageQueueStatsTests, ShouldNotCreateStatsWhenDisabled)
+{
+    unsetenv("RIALTO_SINKS_QUEUE_STATS");
+    EXPECT_EQ(MessageQueueStats::create(kQueueName), nullptr);
+}
+
+TEST_F(MessageQueueStatsTests, ShouldRegisterLiveQueues)
+{
+    setenv("RIALTO_SINKS_QUEUE_STATS", "1", 1);
+    auto stats{MessageQueueStats::create(kQueueName)};
+    unsetenv("RIALTO_SINKS_QUEUE_STATS");
+    ASSERT_NE(stats, nullptr);
+    stats->onPosted(5);
+
+    auto snapshots{MessageQueueStats::getAllSnapshots()};
+    ASSERT_EQ(snapshots.size(), 1u);
+    EXPECT_EQ(snapshots[0].queueName.rfind(kQueueName + "#", 0), 0u);
+    EXPECT_EQ(snapshots[0].maxDepth, 5u);
+
+    stats.reset();
+    EXPECT_TRUE(MessageQueueStats::getAllSnapshots().empty());
+}
@@ -22,6 +22,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <mutex>
+#include <stdlib.h>
+#include <vector>
 
 namespace
 {
@@ -206,3 +208,77 @@ TEST_F(MessageQueueTests, StopCalledInWorkerThreadWhenPreviousTaskIsRunning)
     t1.join();
     EXPECT_FALSE(t3TaskExecuted);
 }
+
+TEST_F(MessageQueueTests, ShouldHandlePriorityMessagesBeforeRegularOnes)
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool isBlocked{true};
+    std::vector<int> handledMessages;
+    m_sut.start();
+
+    EXPECT_TRUE(m_sut.scheduleInEventLoop(
+        [&]()
+        {
+            std::unique_lock<std::mutex> lock{mtx};
+            cv.wait(lock, [&]() { return !isBlocked; });
+        }));
+    EXPECT_TRUE(m_sut.scheduleInEventLoop([&]() { handledMessages.push_back(1); }));
+    EXPECT_TRUE(m_sut.scheduleInEventLoopWithPriority([&]() { handledMessages.push_back(2); }));
+    EXPECT_TRUE(m_sut.scheduleInEventLoopWithPriority([&]() { handledMessages.push_back(3); }));
+    {
+        std::unique_lock<std::mutex> lock{mtx};
+        isBlocked = false;
+        cv.notify_one();
+    }
+    EXPECT_TRUE(m_sut.callInEventLoop([&]() { handledMessages.push_back(4); }));
+
+    EXPECT_THAT(handledMessages, testing::ElementsAre(2, 3, 1, 4));
+    m_sut.stop();
+}
+
+TEST_F(MessageQueueTests, ShouldHandlePriorityMessageBeforeRegularOnes)
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool isBlocked{true};
+    bool isPriorityMessageHandled{false};
+    bool wasPriorityMessageHandledFirst{false};
+    m_sut.start();
+
+    EXPECT_TRUE(m_sut.scheduleInEventLoop(
+        [&]()
+        {
+            std::unique_lock<std::mutex> lock{mtx};
+            cv.wait(lock, [&]() { return !isBlocked; });
+        }));
+    EXPECT_TRUE(m_sut.scheduleInEventLoop([&]() { wasPriorityMessageHandledFirst = isPriorityMessageHandled; }));
+    EXPECT_TRUE(m_sut.postMessageWithPriority(std::make_shared<TestMessage>(mtx, cv, isPriorityMessageHandled)));
+    {
+        std::unique_lock<std::mutex> lock{mtx};
+        isBlocked = false;
+        cv.notify_all();
+    }
+    EXPECT_TRUE(m_sut.callInEventLoop([]() {}));
+
+    EXPECT_TRUE(wasPriorityMessageHandledFirst);
+    m_sut.stop();
+}
+
+TEST(MessageQueueStatsIntegrationTests, ShouldCollectStatsWhenEnabled)
+{
+    setenv("RIALTO_SINKS_QUEUE_STATS", "1", 1);
+    rialto::MessageQueue sut{"stats-test"};
+    unsetenv("RIALTO_SINKS_QUEUE_STATS");
+    sut.start();
+    EXPECT_TRUE(sut.callInEventLoop([]() {}));
+    EXPECT_TRUE(sut.callInEventLoop([]() {}));
+    // Joins the worker thread, so that all handler times are recorded. Stop message is posted as the third one.
+    sut.stop();
+
+    const auto kSnapshots{MessageQueueStats::getAllSnapshots()};
+    ASSERT_EQ(kSnapshots.size(), 1u);
+    EXPECT_EQ(kSnapshots[0].postedCount, 3u);
+    EXPECT_EQ(kSnapshots[0].wait.getCount(), 3u);
+    EXPECT_EQ(kSnapshots[0].handlers.size(), 3u);
+}
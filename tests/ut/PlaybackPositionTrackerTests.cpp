@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "PlaybackPositionTracker.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr int64_t kPosition{10000000000};
+constexpr int64_t kNow{5000000000};
+constexpr int64_t kElapsed{100000000};
+constexpr int64_t kMaxExtrapolation{1000000000};
+constexpr double kRate{2.0};
+} // namespace
+
+class PlaybackPositionTrackerTests : public testing::Test
+{
+protected:
+    PlaybackPositionTracker m_sut;
+};
+
+TEST_F(PlaybackPositionTrackerTests, ShouldReturnInvalidPositionBeforeFirstUpdate)
+{
+    EXPECT_EQ(m_sut.getPosition(), -1);
+    m_sut.setPlaying(true, kNow);
+    EXPECT_EQ(m_sut.getPosition(kNow + kElapsed), -1);
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldNotExtrapolateWhenNotPlaying)
+{
+    m_sut.update(kPosition, kNow);
+    EXPECT_EQ(m_sut.getPosition(kNow + kElapsed), kPosition);
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldExtrapolateWhenPlaying)
+{
+    m_sut.setPlaying(true, kNow);
+    m_sut.update(kPosition, kNow);
+    EXPECT_EQ(m_sut.getPosition(kNow + kElapsed), kPosition + kElapsed);
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldExtrapolateWithRate)
+{
+    m_sut.setPlaying(true, kNow);
+    m_sut.update(kPosition, kNow);
+    m_sut.setRate(kRate, kNow);
+    EXPECT_EQ(m_sut.getPosition(kNow + kElapsed), kPosition + static_cast<int64_t>(kElapsed * kRate));
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldLimitExtrapolation)
+{
+    m_sut.setPlaying(true, kNow);
+    m_sut.update(kPosition, kNow);
+    EXPECT_EQ(m_sut.getPosition(kNow + 10 * kMaxExtrapolation), kPosition + kMaxExtrapolation);
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldFreezePositionWhenPlaybackStops)
+{
+    m_sut.setPlaying(true, kNow);
+    m_sut.update(kPosition, kNow);
+    m_sut.setPlaying(false, kNow + kElapsed);
+    EXPECT_EQ(m_sut.getPosition(kNow + 5 * kElapsed), kPosition + kElapsed);
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldReset)
+{
+    m_sut.setPlaying(true, kNow);
+    m_sut.update(kPosition, kNow);
+    m_sut.reset(0);
+    EXPECT_EQ(m_sut.getPosition(kNow + kElapsed), 0);
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldNotGoBackwardsWhenUpdateIsBehindExtrapolation)
+{
+    m_sut.setPlaying(true, kNow);
+    m_sut.update(kPosition, kNow);
+    m_sut.update(kPosition + kElapsed / 2, kNow + kElapsed);
+    EXPECT_EQ(m_sut.getPosition(kNow + kElapsed), kPosition + kElapsed);
+    EXPECT_EQ(m_sut.getPosition(kNow + 2 * kElapsed), kPosition + kElapsed + kElapsed / 2);
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldNotGoBackwardsWhenPausedBehindExtrapolation)
+{
+    m_sut.setPlaying(true, kNow);
+    m_sut.update(kPosition, kNow);
+    m_sut.setPlaying(false, kNow + kElapsed);
+    m_sut.update(kPosition, kNow + kElapsed);
+    EXPECT_EQ(m_sut.getPosition(kNow + kElapsed), kPosition + kElapsed);
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldAllowLowerPositionInNewSegment)
+{
+    m_sut.setPlaying(true, kNow);
+    m_sut.update(kPosition, kNow);
+    m_sut.startSegment(kNow + kElapsed);
+    EXPECT_EQ(m_sut.getPosition(kNow + 2 * kElapsed), kPosition + kElapsed);
+    m_sut.update(0, kNow + 2 * kElapsed);
+    EXPECT_EQ(m_sut.getPosition(kNow + 3 * kElapsed), 0);
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldExtrapolateBackwardsWithNegativeRate)
+{
+    m_sut.setPlaying(true, kNow);
+    m_sut.setRate(-kRate, kNow);
+    m_sut.update(kPosition, kNow);
+    EXPECT_EQ(m_sut.getPosition(kNow + kElapsed), kPosition - static_cast<int64_t>(kElapsed * kRate));
+    m_sut.update(kPosition - static_cast<int64_t>(kElapsed * kRate), kNow + kElapsed);
+    EXPECT_EQ(m_sut.getPosition(kNow + 2 * kElapsed), kPosition - static_cast<int64_t>(2 * kElapsed * kRate));
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldNotGoForwardsWhenUpdateIsBehindExtrapolationWithNegativeRate)
+{
+    m_sut.setPlaying(true, kNow);
+    m_sut.setRate(-kRate, kNow);
+    m_sut.update(kPosition, kNow);
+    m_sut.update(kPosition - kElapsed, kNow + kElapsed);
+    EXPECT_EQ(m_sut.getPosition(kNow + kElapsed), kPosition - static_cast<int64_t>(kElapsed * kRate));
+    EXPECT_EQ(m_sut.getPosition(kNow + 2 * kElapsed), kPosition - kElapsed - static_cast<int64_t>(kElapsed * kRate));
+}
+
+TEST_F(PlaybackPositionTrackerTests, ShouldFollowPositionAfterRateChangesDirection)
+{
+    m_sut.setPlaying(true, kNow);
+    m_sut.update(kPosition, kNow);
+    m_sut.update(kPosition + kElapsed, kNow + kElapsed);
+    m_sut.setRate(-kRate, kNow + kElapsed);
+    EXPECT_EQ(m_sut.getPosition(kNow + 2 * kElapsed), kPosition + kElapsed - static_cast<int64_t>(kElapsed * kRate));
+    m_sut.update(kPosition - kElapsed, kNow + 2 * kElapsed);
+    EXPECT_EQ(m_sut.getPosition(kNow + 2 * kElapsed), kPosition - kElapsed);
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "RialtoGStreamerTracer.h"
+#include "RialtoGstTest.h"
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+using testing::Contains;
+using testing::HasSubstr;
+using testing::IsEmpty;
+
+namespace
+{
+constexpr int32_t kSourceId{1};
+constexpr uint32_t kNeedDataRequestId{2};
+} // namespace
+
+class RialtoGStreamerTracerTests : public RialtoGstTest
+{
+public:
+    RialtoGStreamerTracerTests() : m_wasDebugActive{gst_debug_is_active()}
+    {
+        gst_debug_set_active(TRUE);
+        gst_debug_set_threshold_for_name("GST_TRACER", GST_LEVEL_TRACE);
+        gst_debug_add_log_function(&RialtoGStreamerTracerTests::logFunction, &m_tracerLogs, nullptr);
+    }
+
+    ~RialtoGStreamerTracerTests() override
+    {
+        gst_debug_remove_log_function(&RialtoGStreamerTracerTests::logFunction);
+        gst_debug_unset_threshold_for_name("GST_TRACER");
+        gst_debug_set_active(m_wasDebugActive);
+    }
+
+    static void logFunction(GstDebugCategory *category, GstDebugLevel level, const gchar *file, const gchar *function,
+                            gint line, GObject *object, GstDebugMessage *message, gpointer userData)
+    {
+        if (std::string{gst_debug_category_get_name(category)} == "GST_TRACER")
+        {
+            static_cast<std::vector<std::string> *>(userData)->emplace_back(gst_debug_message_get(message));
+        }
+    }
+
+protected:
+    const gboolean m_wasDebugActive;
+    std::vector<std::string> m_tracerLogs;
+};
+
+TEST_F(RialtoGStreamerTracerTests, ShouldRegisterTracer)
+{
+    GstPluginFeature *feature{gst_registry_find_feature(gst_registry_get(), "rialto", GST_TYPE_TRACER_FACTORY)};
+    ASSERT_NE(feature, nullptr);
+    gst_object_unref(feature);
+}
+
+TEST_F(RialtoGStreamerTracerTests, ShouldBeDisabledWithoutTracer)
+{
+    EXPECT_FALSE(RialtoTracing::isEnabled());
+    GstBuffer *buffer{gst_buffer_new()};
+    EXPECT_EQ(RialtoTracing::chainEnter(nullptr, buffer), GST_CLOCK_TIME_NONE);
+    gst_buffer_unref(buffer);
+}
+
+TEST_F(RialtoGStreamerTracerTests, ShouldTraceWhileTracerExists)
+{
+    GstObject *tracer{GST_OBJECT(g_object_new(RIALTO_TYPE_TRACER, nullptr))};
+    EXPECT_TRUE(RialtoTracing::isEnabled());
+
+    GstElement *sink{gst_bin_new("sink")};
+    GstBuffer *buffer{gst_buffer_new()};
+    const GstClockTime kEntryTime{RialtoTracing::chainEnter(GST_OBJECT(sink), buffer)};
+    EXPECT_TRUE(GST_CLOCK_TIME_IS_VALID(kEntryTime));
+    RialtoTracing::sampleQueued(sink, buffer, 1);
+    RialtoTracing::sampleDequeued(sink, 0);
+    RialtoTracing::chainExit(GST_OBJECT(sink), kEntryTime, GST_FLOW_OK);
+    RialtoTracing::segmentAdded(kSourceId, kNeedDataRequestId, firebolt::rialto::AddSegmentStatus::OK, 0);
+    RialtoTracing::haveData(kSourceId, kNeedDataRequestId, firebolt::rialto::MediaSourceStatus::OK);
+    RialtoTracing::serverStateChanged(firebolt::rialto::PlaybackState::PLAYING);
+    RialtoTracing::flushStarted(sink);
+    RialtoTracing::flushRequested(sink, true);
+    RialtoTracing::flushCompleted(sink);
+    RialtoTracing::webAudioWritten(1, 0, true);
+    gst_buffer_unref(buffer);
+    gst_object_unref(sink);
+
+    gst_object_unref(tracer);
+    EXPECT_FALSE(RialtoTracing::isEnabled());
+
+    for (const std::string kRecord :
+         {"rialto-chain-enter,", "rialto-chain-exit,", "action=(string)queued", "action=(string)dequeued",
+          "rialto-add-segment,", "rialto-have-data,", "rialto-server-state,", "phase=(string)start",
+          "phase=(string)request", "phase=(string)complete", "rialto-web-audio-write,", "element=(string)sink"})
+    {
+        EXPECT_THAT(m_tracerLogs, Contains(HasSubstr(kRecord)));
+    }
+}
+
+TEST_F(RialtoGStreamerTracerTests, ShouldNotLogRecordsWithoutTracer)
+{
+    RialtoTracing::serverStateChanged(firebolt::rialto::PlaybackState::PLAYING);
+    RialtoTracing::webAudioWritten(1, 0, true);
+    EXPECT_THAT(m_tracerLogs, IsEmpty());
+}
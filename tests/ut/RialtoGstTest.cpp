@@ -17,6 +17,7 @@
  */
 
 #include "RialtoGstTest.h"
+#include "ControlBackend.h"
 #include "Matchers.h"
 #include "MediaPipelineCapabilitiesMock.h"
 #include "PlaybinStub.h"
@@ -171,11 +172,21 @@ GstCaps *RialtoGstTest::createVideoCaps() const
     return gst_caps_new_empty_simple("video/x-h264");
 }
 
-RialtoMSEBaseSink *RialtoGstTest::createAudioSink() const
+void RialtoGstTest::expectControlRegistration() const
 {
+    // Sinks share one control registration, so only the first living sink registers
+    if (firebolt::rialto::client::SharedControl::isAcquired())
+    {
+        return;
+    }
     EXPECT_CALL(*m_controlFactoryMock, createControl()).WillOnce(Return(m_controlMock));
     EXPECT_CALL(*m_controlMock, registerClient(_, _))
         .WillOnce(DoAll(SetArgReferee<1>(ApplicationState::RUNNING), Return(true)));
+}
+
+RialtoMSEBaseSink *RialtoGstTest::createAudioSink() const
+{
+    expectControlRegistration();
     GstElement *audioSink = gst_element_factory_make("rialtomseaudiosink", "rialtomseaudiosink");
     EXPECT_EQ(GST_STATE_CHANGE_SUCCESS, gst_element_set_state(audioSink, GST_STATE_READY));
     return RIALTO_MSE_BASE_SINK(audioSink);
@@ -189,9 +200,7 @@ RialtoMSEBaseSink *RialtoGstTest::createAudioSinkWithoutDelegate() const
 
 RialtoMSEBaseSink *RialtoGstTest::createVideoSink() const
 {
-    EXPECT_CALL(*m_controlFactoryMock, createControl()).WillOnce(Return(m_controlMock));
-    EXPECT_CALL(*m_controlMock, registerClient(_, _))
-        .WillOnce(DoAll(SetArgReferee<1>(ApplicationState::RUNNING), Return(true)));
+    expectControlRegistration();
     GstElement *videoSink = gst_element_factory_make("rialtomsevideosink", "rialtomsevideosink");
     EXPECT_EQ(GST_STATE_CHANGE_SUCCESS, gst_element_set_state(videoSink, GST_STATE_READY));
     return RIALTO_MSE_BASE_SINK(videoSink);
@@ -199,9 +208,7 @@ RialtoMSEBaseSink *RialtoGstTest::createVideoSink() const
 
 RialtoMSEBaseSink *RialtoGstTest::createSubtitleSink() const
 {
-    EXPECT_CALL(*m_controlFactoryMock, createControl()).WillOnce(Return(m_controlMock));
-    EXPECT_CALL(*m_controlMock, registerClient(_, _))
-        .WillOnce(DoAll(SetArgReferee<1>(ApplicationState::RUNNING), Return(true)));
+    expectControlRegistration();
     GstElement *videoSink = gst_element_factory_make("rialtomsesubtitlesink", "rialtomsesubtitlesink");
     EXPECT_EQ(GST_STATE_CHANGE_SUCCESS, gst_element_set_state(videoSink, GST_STATE_READY));
     return RIALTO_MSE_BASE_SINK(videoSink);
@@ -209,9 +216,7 @@ RialtoMSEBaseSink *RialtoGstTest::createSubtitleSink() const
 
 RialtoWebAudioSink *RialtoGstTest::createWebAudioSink() const
 {
-    EXPECT_CALL(*m_controlFactoryMock, createControl()).WillOnce(Return(m_controlMock));
-    EXPECT_CALL(*m_controlMock, registerClient(_, _))
-        .WillOnce(DoAll(SetArgReferee<1>(ApplicationState::RUNNING), Return(true)));
+    expectControlRegistration();
     GstElement *webAudioSink = gst_element_factory_make("rialtowebaudiosink", "rialtowebaudiosink");
     EXPECT_EQ(GST_STATE_CHANGE_SUCCESS, gst_element_set_state(webAudioSink, GST_STATE_READY));
     return RIALTO_WEB_AUDIO_SINK(webAudioSink);
@@ -225,9 +230,7 @@ RialtoWebAudioSink *RialtoGstTest::createWebAudioSinkWithoutDelegate() const
 
 RialtoMSEBaseSink *RialtoGstTest::createAudioSinkInWebAudioMode() const
 {
-    EXPECT_CALL(*m_controlFactoryMock, createControl()).WillOnce(Return(m_controlMock));
-    EXPECT_CALL(*m_controlMock, registerClient(_, _))
-        .WillOnce(DoAll(SetArgReferee<1>(ApplicationState::RUNNING), Return(true)));
+    expectControlRegistration();
     GstElement *audioSink = gst_element_factory_make("rialtomseaudiosink", "rialtomseaudiosink");
     g_object_set(audioSink, "web-audio", TRUE, nullptr);
     EXPECT_EQ(GST_STATE_CHANGE_SUCCESS, gst_element_set_state(audioSink, GST_STATE_READY));
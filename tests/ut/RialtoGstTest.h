@@ -89,6 +89,7 @@ public:
 
 private:
     void expectSinksInitialisation() const;
+    void expectControlRegistration() const;
 
 protected:
     std::shared_ptr<testing::StrictMock<firebolt::rialto::ControlFactoryMock>> m_controlFactoryMock{
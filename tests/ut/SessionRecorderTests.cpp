@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "SessionReader.h"
+#include "SessionRecorder.h"
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using firebolt::rialto::IMediaPipeline;
+using session_recording::RecordType;
+
+namespace
+{
+constexpr int32_t kSourceId{3};
+constexpr uint32_t kNeedDataRequestId{12};
+constexpr size_t kFrameCount{24};
+constexpr int64_t kTimeStamp{1000000000};
+constexpr int64_t kDuration{20000000};
+constexpr int32_t kSampleRate{48000};
+constexpr int32_t kChannels{2};
+constexpr int64_t kPosition{5000000000};
+constexpr double kRate{1.5};
+const std::string kMimeType{"audio/mp4"};
+const std::vector<uint8_t> kCodecSpecificConfig{1, 2, 3};
+const std::vector<uint8_t> kPayload{9, 8, 7, 6, 5};
+} // namespace
+
+class SessionRecorderTests : public testing::Test
+{
+public:
+    SessionRecorderTests() : m_path{testing::TempDir() + "session-recorder-" + std::to_string(getpid()) + ".rgsr"} {}
+    ~SessionRecorderTests() override { std::remove(m_path.c_str()); }
+
+protected:
+    std::unique_ptr<IMediaPipeline::MediaSegment> createSegment() const
+    {
+        auto segment{std::make_unique<IMediaPipeline::MediaSegmentAudio>(kSourceId, kTimeStamp, kDuration, kSampleRate,
+                                                                          kChannels)};
+        segment->setData(kPayload.size(), kPayload.data());
+        return segment;
+    }
+
+    std::vector<RecordType> readTypes(SessionReader &reader) const
+    {
+        std::vector<RecordType> types;
+        while (auto record = reader.next())
+        {
+            types.push_back(record->header->type);
+        }
+        return types;
+    }
+
+    std::string m_path;
+};
+
+TEST_F(SessionRecorderTests, ShouldWriteFileHeader)
+{
+    {
+        SessionRecorder recorder{m_path, true};
+        ASSERT_TRUE(recorder.isOpen());
+    }
+    SessionReader reader{m_path};
+    ASSERT_TRUE(reader.isValid());
+    EXPECT_EQ(reader.getHeader().magic, session_recording::kMagic);
+    EXPECT_EQ(reader.getHeader().version, session_recording::kVersion);
+    EXPECT_EQ(reader.getHeader().flags, session_recording::FileFlags::HAS_PAYLOAD);
+    EXPECT_FALSE(reader.next());
+}
+
+TEST_F(SessionRecorderTests, ShouldFailToOpenFileInMissingDirectory)
+{
+    SessionRecorder recorder{testing::TempDir() + "missing-directory/session.rgsr", false};
+    EXPECT_FALSE(recorder.isOpen());
+}
+
+TEST_F(SessionRecorderTests, ShouldRejectFileWhichIsNotRecording)
+{
+    std::FILE *file{std::fopen(m_path.c_str(), "wb")};
+    ASSERT_NE(file, nullptr);
+    const std::string kContent{"not a session recording"};
+    std::fwrite(kContent.data(), kContent.size(), 1, file);
+    std::fclose(file);
+
+    SessionReader reader{m_path};
+    EXPECT_FALSE(reader.isValid());
+    EXPECT_FALSE(reader.next());
+}
+
+TEST_F(SessionRecorderTests, ShouldRecordCommandsAndNotificationsInOrder)
+{
+    {
+        SessionRecorder recorder{m_path, false};
+        recorder.recordAllSourcesAttached();
+        recorder.recordNeedData(kSourceId, kFrameCount, kNeedDataRequestId);
+        recorder.recordSegment(kNeedDataRequestId, *createSegment(), firebolt::rialto::AddSegmentStatus::OK);
+        recorder.recordHaveData(kSourceId, kNeedDataRequestId, firebolt::rialto::MediaSourceStatus::OK);
+        recorder.recordPlay();
+        recorder.recordPlaybackState(firebolt::rialto::PlaybackState::PLAYING);
+        recorder.recordFlush(kSourceId, true);
+        recorder.recordSourceFlushed(kSourceId);
+        recorder.recordSetSourcePosition(kSourceId, kPosition, false, kRate, 0);
+        recorder.recordSetPlaybackRate(kRate);
+        recorder.recordBufferUnderflow(kSourceId);
+        recorder.recordPause();
+        recorder.recordStop();
+        recorder.recordRemoveSource(kSourceId);
+    }
+    SessionReader reader{m_path};
+    ASSERT_TRUE(reader.isValid());
+    const std::vector<RecordType> kExpectedTypes{RecordType::ALL_SOURCES_ATTACHED, RecordType::NEED_DATA,
+                                                 RecordType::SEGMENT,              RecordType::HAVE_DATA,
+                                                 RecordType::PLAY,                 RecordType::PLAYBACK_STATE,
+                                                 RecordType::FLUSH,                RecordType::SOURCE_FLUSHED,
+                                                 RecordType::SET_SOURCE_POSITION,  RecordType::SET_PLAYBACK_RATE,
+                                                 RecordType::BUFFER_UNDERFLOW,     RecordType::PAUSE,
+                                                 RecordType::STOP,                 RecordType::REMOVE_SOURCE};
+    EXPECT_EQ(readTypes(reader), kExpectedTypes);
+
+    reader.rewind();
+    int64_t previousTimestamp{0};
+    while (auto record = reader.next())
+    {
+        EXPECT_GE(record->header->timestampNs, previousTimestamp);
+        previousTimestamp = record->header->timestampNs;
+        if (record->header->type == RecordType::NEED_DATA)
+        {
+            const auto *kNeedData{record->as<session_recording::DataRequestRecord>()};
+            ASSERT_NE(kNeedData, nullptr);
+            EXPECT_EQ(kNeedData->sourceId, kSourceId);
+            EXPECT_EQ(kNeedData->needDataRequestId, kNeedDataRequestId);
+            EXPECT_EQ(kNeedData->value, kFrameCount);
+        }
+        else if (record->header->type == RecordType::SET_SOURCE_POSITION)
+        {
+            const auto *kSetPosition{record->as<session_recording::SetSourcePositionRecord>()};
+            ASSERT_NE(kSetPosition, nullptr);
+            EXPECT_EQ(kSetPosition->position, kPosition);
+            EXPECT_EQ(kSetPosition->appliedRate, kRate);
+        }
+    }
+}
+
+TEST_F(SessionRecorderTests, ShouldRecordAttachSource)
+{
+    {
+        const firebolt::rialto::AudioConfig kAudioConfig{static_cast<uint32_t>(kChannels),
+                                                         static_cast<uint32_t>(kSampleRate), kCodecSpecificConfig};
+        IMediaPipeline::MediaSourceAudio source{kMimeType, true, kAudioConfig};
+        source.setId(kSourceId);
+        SessionRecorder recorder{m_path, false};
+        recorder.recordAttachSource(source);
+    }
+    SessionReader reader{m_path};
+    auto record{reader.next()};
+    ASSERT_TRUE(record);
+    ASSERT_EQ(record->header->type, RecordType::ATTACH_SOURCE);
+    const auto kAttachSource{SessionReader::parseAttachSource(*record)};
+    ASSERT_TRUE(kAttachSource);
+    EXPECT_EQ(kAttachSource->record.sourceId, kSourceId);
+    EXPECT_EQ(kAttachSource->record.mediaType, static_cast<uint16_t>(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_TRUE(kAttachSource->record.hasDrm);
+    EXPECT_EQ(kAttachSource->record.numberOfChannels, static_cast<uint32_t>(kChannels));
+    EXPECT_EQ(kAttachSource->record.sampleRate, static_cast<uint32_t>(kSampleRate));
+    EXPECT_EQ(kAttachSource->record.dolbyVisionProfile, -1);
+    EXPECT_EQ(kAttachSource->mimeType, kMimeType);
+    EXPECT_EQ(kAttachSource->codecSpecificConfig, kCodecSpecificConfig);
+    EXPECT_TRUE(kAttachSource->codecData.empty());
+    EXPECT_TRUE(kAttachSource->textTrackIdentifier.empty());
+}
+
+TEST_F(SessionRecorderTests, ShouldRecordSegmentWithPayload)
+{
+    {
+        SessionRecorder recorder{m_path, true};
+        recorder.recordSegment(kNeedDataRequestId, *createSegment(), firebolt::rialto::AddSegmentStatus::OK);
+    }
+    SessionReader reader{m_path};
+    auto record{reader.next()};
+    ASSERT_TRUE(record);
+    const auto *kSegment{record->as<session_recording::SegmentRecord>()};
+    ASSERT_NE(kSegment, nullptr);
+    EXPECT_EQ(kSegment->needDataRequestId, kNeedDataRequestId);
+    EXPECT_EQ(kSegment->sourceId, kSourceId);
+    EXPECT_EQ(kSegment->timeStamp, kTimeStamp);
+    EXPECT_EQ(kSegment->duration, kDuration);
+    EXPECT_EQ(kSegment->dataLength, kPayload.size());
+    EXPECT_EQ(kSegment->sampleRateOrWidth, kSampleRate);
+    EXPECT_EQ(kSegment->numberOfChannelsOrHeight, kChannels);
+    const uint8_t *kData{SessionReader::getSegmentPayload(*record)};
+    ASSERT_NE(kData, nullptr);
+    EXPECT_EQ(std::vector<uint8_t>(kData, kData + kSegment->dataLength), kPayload);
+}
+
+TEST_F(SessionRecorderTests, ShouldRecordSegmentWithoutPayload)
+{
+    {
+        SessionRecorder recorder{m_path, false};
+        recorder.recordSegment(kNeedDataRequestId, *createSegment(), firebolt::rialto::AddSegmentStatus::OK);
+    }
+    SessionReader reader{m_path};
+    auto record{reader.next()};
+    ASSERT_TRUE(record);
+    const auto *kSegment{record->as<session_recording::SegmentRecord>()};
+    ASSERT_NE(kSegment, nullptr);
+    EXPECT_EQ(kSegment->dataLength, kPayload.size());
+    EXPECT_EQ(SessionReader::getSegmentPayload(*record), nullptr);
+}
+
+TEST_F(SessionRecorderTests, ShouldStopAtTruncatedRecord)
+{
+    {
+        SessionRecorder recorder{m_path, true};
+        recorder.recordPlay();
+        recorder.recordSegment(kNeedDataRequestId, *createSegment(), firebolt::rialto::AddSegmentStatus::OK);
+    }
+    std::FILE *file{std::fopen(m_path.c_str(), "rb")};
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, 0, SEEK_END);
+    const long kSize{std::ftell(file)};
+    std::fclose(file);
+    ASSERT_EQ(truncate(m_path.c_str(), kSize - 8), 0);
+
+    SessionReader reader{m_path};
+    ASSERT_TRUE(reader.isValid());
+    EXPECT_EQ(readTypes(reader), std::vector<RecordType>{RecordType::PLAY});
+}
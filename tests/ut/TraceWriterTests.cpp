@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "TraceWriter.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+constexpr size_t kEventsPerThread{4};
+const TraceWriter::Clock::time_point kStart{std::chrono::seconds{10}};
+const TraceWriter::Clock::time_point kEnd{kStart + std::chrono::microseconds{1500}};
+
+struct TestMessage
+{
+};
+
+size_t countOccurrences(const std::string &text, const std::string &pattern)
+{
+    size_t count{0};
+    for (size_t position = text.find(pattern); position != std::string::npos;
+         position = text.find(pattern, position + 1))
+    {
+        ++count;
+    }
+    return count;
+}
+} // namespace
+
+class TraceWriterTests : public testing::Test
+{
+protected:
+    std::string writeJson() const
+    {
+        std::ostringstream stream;
+        m_sut.writeJson(stream);
+        return stream.str();
+    }
+
+    const std::string m_filePath{testing::TempDir() + "rialto-trace-test.json"};
+    TraceWriter m_sut{m_filePath, kEventsPerThread};
+};
+
+TEST_F(TraceWriterTests, ShouldWriteEmptyTrace)
+{
+    EXPECT_EQ(writeJson(), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n]}\n");
+}
+
+TEST_F(TraceWriterTests, ShouldWriteSpan)
+{
+    m_sut.addSpan("ipc", "MediaPipeline::play", kStart, kEnd, "frames", 24);
+
+    const std::string kJson{writeJson()};
+    EXPECT_NE(kJson.find("\"name\":\"MediaPipeline::play\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(kJson.find("\"cat\":\"ipc\",\"ts\":10000000.000,\"dur\":1500.000,\"args\":{\"frames\":24}"),
+              std::string::npos);
+}
+
+TEST_F(TraceWriterTests, ShouldWriteInstant)
+{
+    m_sut.addInstant("state", "server playback state");
+
+    const std::string kJson{writeJson()};
+    EXPECT_NE(kJson.find("\"name\":\"server playback state\",\"ph\":\"i\""), std::string::npos);
+    EXPECT_NE(kJson.find("\"s\":\"t\""), std::string::npos);
+}
+
+TEST_F(TraceWriterTests, ShouldDemangleHandlerType)
+{
+    m_sut.addSpan("queue", typeid(TestMessage), kStart, kEnd);
+
+    EXPECT_NE(writeJson().find("TestMessage\",\"ph\":\"X\""), std::string::npos);
+}
+
+TEST_F(TraceWriterTests, ShouldNameThreads)
+{
+    m_sut.setThreadName("backend#1");
+    std::thread{[this]() { m_sut.setThreadName("puller-audio#2"); }}.join();
+
+    const std::string kJson{writeJson()};
+    EXPECT_EQ(countOccurrences(kJson, "\"ph\":\"M\""), 2u);
+    EXPECT_NE(kJson.find("\"args\":{\"name\":\"backend#1\"}"), std::string::npos);
+    EXPECT_NE(kJson.find("\"args\":{\"name\":\"puller-audio#2\"}"), std::string::npos);
+}
+
+TEST_F(TraceWriterTests, ShouldOverwriteOldestEventsAboveThreadCapacity)
+{
+    for (size_t i = 0; i < kEventsPerThread + 2; ++i)
+    {
+        m_sut.addInstant("state", "instant", "index", static_cast<int64_t>(i));
+    }
+
+    const std::string kJson{writeJson()};
+    EXPECT_EQ(countOccurrences(kJson, "\"ph\":\"i\""), kEventsPerThread);
+    EXPECT_EQ(kJson.find("{\"index\":0}"), std::string::npos);
+    EXPECT_EQ(kJson.find("{\"index\":1}"), std::string::npos);
+    EXPECT_LT(kJson.find("{\"index\":2}"), kJson.find("{\"index\":5}"));
+}
+
+TEST_F(TraceWriterTests, ShouldKeepEventsOfExitedThread)
+{
+    std::thread{[this]()
+                {
+                    for (size_t i = 0; i < kEventsPerThread + 1; ++i)
+                    {
+                        m_sut.addInstant("state", "instant", "index", static_cast<int64_t>(i));
+                    }
+                }}
+        .join();
+
+    const std::string kJson{writeJson()};
+    EXPECT_EQ(countOccurrences(kJson, "\"ph\":\"i\""), kEventsPerThread);
+    EXPECT_EQ(kJson.find("{\"index\":0}"), std::string::npos);
+    EXPECT_LT(kJson.find("{\"index\":1}"), kJson.find("{\"index\":4}"));
+}
+
+TEST_F(TraceWriterTests, ShouldWriteTraceWhileThreadIsAddingEvents)
+{
+    constexpr int64_t kEventCount{10000};
+    std::thread producer{[this]()
+                         {
+                             for (int64_t i = 0; i < kEventCount; ++i)
+                             {
+                                 m_sut.addInstant("state", "instant", "index", i);
+                             }
+                         }};
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_LE(countOccurrences(writeJson(), "\"ph\":\"i\""), kEventsPerThread);
+    }
+    producer.join();
+
+    const std::string kJson{writeJson()};
+    EXPECT_EQ(countOccurrences(kJson, "\"ph\":\"i\""), kEventsPerThread);
+    EXPECT_NE(kJson.find("{\"index\":" + std::to_string(kEventCount - 1) + "}"), std::string::npos);
+}
+
+TEST_F(TraceWriterTests, ShouldDiscardOldestExitedThreadsAboveRetiredCapacity)
+{
+    for (size_t i = 0; i < TraceWriter::kRetiredThreadBuffers + 2; ++i)
+    {
+        std::thread{[this, i]()
+                    {
+                        m_sut.setThreadName("thread#" + std::to_string(i));
+                        for (size_t j = 0; j < kEventsPerThread; ++j)
+                        {
+                            m_sut.addInstant("state", "instant");
+                        }
+                    }}
+            .join();
+    }
+
+    // Exited threads are discarded when a new thread starts tracing, the last one is still kept
+    const std::string kJson{writeJson()};
+    EXPECT_EQ(kJson.find("\"thread#0\""), std::string::npos);
+    for (size_t i = 1; i < TraceWriter::kRetiredThreadBuffers + 2; ++i)
+    {
+        EXPECT_NE(kJson.find("\"thread#" + std::to_string(i) + "\""), std::string::npos);
+    }
+}
+
+TEST_F(TraceWriterTests, ShouldFlushToFile)
+{
+    m_sut.addSpan("ipc", "MediaPipeline::play", kStart, kEnd);
+
+    ASSERT_TRUE(m_sut.flush());
+    std::ifstream file{m_filePath};
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), writeJson());
+    std::remove(m_filePath.c_str());
+}
+
+TEST_F(TraceWriterTests, ShouldRecordSpanOnlyWhenEnabled)
+{
+    // RIALTO_SINKS_TRACE_FILE is not set in tests
+    EXPECT_EQ(TraceWriter::instance(), nullptr);
+    TraceSpan span{"ipc", "MediaPipeline::play"};
+}
@@ -0,0 +1,514 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "SessionReplayer.h"
+
+#include <cstdio>
+#include <limits>
+#include <utility>
+
+using firebolt::rialto::IMediaPipeline;
+using session_recording::RecordType;
+
+namespace
+{
+// Live server may ask for less data than the recorded one did, so a command doesn't wait for its data forever
+constexpr std::chrono::seconds kDataTimeout{2};
+constexpr uint32_t kMaxWidth{3840};
+constexpr uint32_t kMaxHeight{2160};
+
+const char *toString(RecordType type)
+{
+    switch (type)
+    {
+    case RecordType::ATTACH_SOURCE:
+        return "attachSource";
+    case RecordType::ALL_SOURCES_ATTACHED:
+        return "allSourcesAttached";
+    case RecordType::REMOVE_SOURCE:
+        return "removeSource";
+    case RecordType::FLUSH:
+        return "flush";
+    case RecordType::SET_SOURCE_POSITION:
+        return "setSourcePosition";
+    case RecordType::PLAY:
+        return "play";
+    case RecordType::PAUSE:
+        return "pause";
+    case RecordType::STOP:
+        return "stop";
+    case RecordType::SET_PLAYBACK_RATE:
+        return "setPlaybackRate";
+    default:
+        return "unknown";
+    }
+}
+} // namespace
+
+SessionReplayer::SessionReplayer(SessionReader &reader, bool isMaxSpeed) : m_isMaxSpeed{isMaxSpeed}
+{
+    // Segments are grouped by the need-data request they answer, until have-data closes the request
+    std::map<uint32_t, std::vector<SessionReader::Record>> openAnswers;
+    bool isFirstRecord{true};
+    int64_t lastTimestampNs{0};
+    reader.rewind();
+    while (auto record = reader.next())
+    {
+        if (isFirstRecord)
+        {
+            m_firstTimestampNs = record->header->timestampNs;
+            isFirstRecord = false;
+        }
+        lastTimestampNs = record->header->timestampNs;
+        switch (record->header->type)
+        {
+        case RecordType::SEGMENT:
+        {
+            // Segments rejected with no space are sent again with a later request
+            const auto *kSegment{record->as<session_recording::SegmentRecord>()};
+            if (kSegment &&
+                kSegment->addSegmentStatus == static_cast<uint32_t>(firebolt::rialto::AddSegmentStatus::OK))
+            {
+                openAnswers[kSegment->needDataRequestId].push_back(*record);
+            }
+            break;
+        }
+        case RecordType::HAVE_DATA:
+        {
+            const auto *kHaveData{record->as<session_recording::DataRequestRecord>()};
+            if (kHaveData)
+            {
+                DataAnswer answer{record->header->timestampNs, std::move(openAnswers[kHaveData->needDataRequestId]),
+                                  static_cast<firebolt::rialto::MediaSourceStatus>(kHaveData->value)};
+                openAnswers.erase(kHaveData->needDataRequestId);
+                m_sources[kHaveData->sourceId].answers.push_back(std::move(answer));
+            }
+            break;
+        }
+        case RecordType::NEED_DATA:
+            ++m_recordedSummary.needDataCount;
+            break;
+        case RecordType::BUFFER_UNDERFLOW:
+            ++m_recordedSummary.bufferUnderflowCount;
+            break;
+        case RecordType::SOURCE_FLUSHED:
+            ++m_recordedSummary.sourceFlushedCount;
+            break;
+        case RecordType::PLAYBACK_STATE:
+            break;
+        default:
+            m_commands.push_back(*record);
+            break;
+        }
+    }
+    m_recordedSummary.duration = std::chrono::nanoseconds{lastTimestampNs - m_firstTimestampNs};
+}
+
+bool SessionReplayer::replay(firebolt::rialto::IMediaPipelineFactory &factory)
+{
+    firebolt::rialto::VideoRequirements videoRequirements;
+    videoRequirements.maxWidth = kMaxWidth;
+    videoRequirements.maxHeight = kMaxHeight;
+    m_pipeline = factory.createMediaPipeline(shared_from_this(), videoRequirements);
+    if (!m_pipeline)
+    {
+        std::fprintf(stderr, "Could not create media pipeline\n");
+        return false;
+    }
+    if (!m_pipeline->load(firebolt::rialto::MediaType::MSE, "", "mse://1", false))
+    {
+        std::fprintf(stderr, "Could not load media pipeline\n");
+        return false;
+    }
+
+    m_startTime = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock{m_mutex};
+    std::chrono::steady_clock::time_point dataDeadline{};
+    size_t nextCommand{0};
+    while (true)
+    {
+        const bool kAreCommandsSent{nextCommand == m_commands.size()};
+        const int64_t kCommandTimestampNs{kAreCommandsSent ? std::numeric_limits<int64_t>::max()
+                                                           : m_commands[nextCommand].header->timestampNs};
+        auto wakeUpTime{std::chrono::steady_clock::time_point::max()};
+        if (sendNextAnswer(lock, kCommandTimestampNs, wakeUpTime))
+        {
+            dataDeadline = {};
+            continue;
+        }
+
+        const auto kNow{std::chrono::steady_clock::now()};
+        if (kAreCommandsSent)
+        {
+            // Data recorded after the last command is sent as long as the server keeps asking for it
+            if (isDataSentUnlocked(kCommandTimestampNs))
+            {
+                break;
+            }
+            if (dataDeadline == std::chrono::steady_clock::time_point{})
+            {
+                dataDeadline = kNow + kDataTimeout;
+            }
+            else if (kNow >= dataDeadline)
+            {
+                std::fprintf(stderr, "Server stopped requesting data before the end of the recording\n");
+                break;
+            }
+            m_cv.wait_until(lock, std::min(wakeUpTime, dataDeadline));
+            continue;
+        }
+
+        const auto kCommandTime{toLocalTime(kCommandTimestampNs)};
+        if (!m_isMaxSpeed && kNow < kCommandTime)
+        {
+            m_cv.wait_until(lock, std::min(wakeUpTime, kCommandTime));
+            continue;
+        }
+        if (!isDataSentUnlocked(kCommandTimestampNs))
+        {
+            if (dataDeadline == std::chrono::steady_clock::time_point{})
+            {
+                dataDeadline = kNow + kDataTimeout;
+            }
+            if (kNow < dataDeadline)
+            {
+                m_cv.wait_until(lock, std::min(wakeUpTime, dataDeadline));
+                continue;
+            }
+            std::fprintf(stderr, "Server did not request all data recorded before %s, skipping it\n",
+                         toString(m_commands[nextCommand].header->type));
+            for (auto &[recordedId, source] : m_sources)
+            {
+                skipAnswersUnlocked(source, kCommandTimestampNs);
+            }
+        }
+        dataDeadline = {};
+
+        const SessionReader::Record kCommand{m_commands[nextCommand++]};
+        const bool kIsRemoveSource{kCommand.header->type == RecordType::REMOVE_SOURCE};
+        const auto *kSourceRecord{kCommand.as<session_recording::SourceRecord>()};
+        auto sourceIt{kSourceRecord ? m_sources.find(kSourceRecord->sourceId) : m_sources.end()};
+        if ((kIsRemoveSource || kCommand.header->type == RecordType::FLUSH) && sourceIt != m_sources.end())
+        {
+            // Outstanding requests are cancelled by the command. Done before sending it, as new requests may arrive
+            // before it returns.
+            sourceIt->second.pendingRequests.clear();
+        }
+        lock.unlock();
+        if (!issueCommand(kCommand))
+        {
+            std::fprintf(stderr, "%s failed\n", toString(kCommand.header->type));
+        }
+        lock.lock();
+        if (kIsRemoveSource && sourceIt != m_sources.end())
+        {
+            sourceIt->second.liveId = -1;
+        }
+    }
+    m_replayedSummary.duration = std::chrono::steady_clock::now() - m_startTime;
+    lock.unlock();
+
+    m_pipeline.reset();
+    return true;
+}
+
+SessionReplayer::Summary SessionReplayer::getRecordedSummary() const
+{
+    return m_recordedSummary;
+}
+
+SessionReplayer::Summary SessionReplayer::getReplayedSummary() const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return m_replayedSummary;
+}
+
+void SessionReplayer::notifyNeedMediaData(int32_t sourceId, size_t frameCount, uint32_t needDataRequestId,
+                                          const std::shared_ptr<firebolt::rialto::MediaPlayerShmInfo> &shmInfo)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    ++m_replayedSummary.needDataCount;
+    Source *source{findByLiveIdUnlocked(sourceId)};
+    if (source)
+    {
+        source->pendingRequests.push_back(needDataRequestId);
+        m_cv.notify_all();
+    }
+}
+
+void SessionReplayer::notifyCancelNeedMediaData(int32_t sourceId)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    Source *source{findByLiveIdUnlocked(sourceId)};
+    if (source)
+    {
+        source->pendingRequests.clear();
+    }
+}
+
+void SessionReplayer::notifyBufferUnderflow(int32_t sourceId)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    ++m_replayedSummary.bufferUnderflowCount;
+}
+
+void SessionReplayer::notifyPlaybackError(int32_t sourceId, firebolt::rialto::PlaybackError error)
+{
+    std::fprintf(stderr, "Playback error %u on source %d\n", static_cast<unsigned>(error), sourceId);
+}
+
+void SessionReplayer::notifySourceFlushed(int32_t sourceId)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    ++m_replayedSummary.sourceFlushedCount;
+}
+
+bool SessionReplayer::issueCommand(const SessionReader::Record &command)
+{
+    switch (command.header->type)
+    {
+    case RecordType::ATTACH_SOURCE:
+        return attachSource(command);
+    case RecordType::ALL_SOURCES_ATTACHED:
+        return m_pipeline->allSourcesAttached();
+    case RecordType::REMOVE_SOURCE:
+    {
+        const auto *kRecord{command.as<session_recording::SourceRecord>()};
+        return kRecord && m_pipeline->removeSource(toLiveId(kRecord->sourceId));
+    }
+    case RecordType::FLUSH:
+    {
+        const auto *kRecord{command.as<session_recording::SourceRecord>()};
+        bool async{true};
+        return kRecord && m_pipeline->flush(toLiveId(kRecord->sourceId), kRecord->value, async);
+    }
+    case RecordType::SET_SOURCE_POSITION:
+    {
+        const auto *kRecord{command.as<session_recording::SetSourcePositionRecord>()};
+        return kRecord && m_pipeline->setSourcePosition(toLiveId(kRecord->sourceId), kRecord->position,
+                                                        kRecord->resetTime, kRecord->appliedRate,
+                                                        kRecord->stopPosition);
+    }
+    case RecordType::PLAY:
+    {
+        bool async{true};
+        return m_pipeline->play(async);
+    }
+    case RecordType::PAUSE:
+        return m_pipeline->pause();
+    case RecordType::STOP:
+        return m_pipeline->stop();
+    case RecordType::SET_PLAYBACK_RATE:
+    {
+        const auto *kRecord{command.as<session_recording::PlaybackRateRecord>()};
+        return kRecord && m_pipeline->setPlaybackRate(kRecord->rate);
+    }
+    default:
+        return false;
+    }
+}
+
+bool SessionReplayer::attachSource(const SessionReader::Record &command)
+{
+    const auto kAttachSource{SessionReader::parseAttachSource(command)};
+    if (!kAttachSource)
+    {
+        return false;
+    }
+    const session_recording::AttachSourceRecord &kRecord{kAttachSource->record};
+    std::shared_ptr<firebolt::rialto::CodecData> codecData;
+    if (!kAttachSource->codecData.empty())
+    {
+        codecData = std::make_shared<firebolt::rialto::CodecData>();
+        codecData->data = kAttachSource->codecData;
+        codecData->type = static_cast<firebolt::rialto::CodecDataType>(kRecord.codecDataType);
+    }
+    const auto kAlignment{static_cast<firebolt::rialto::SegmentAlignment>(kRecord.segmentAlignment)};
+    const auto kFormat{static_cast<firebolt::rialto::StreamFormat>(kRecord.streamFormat)};
+    // Keys are not part of the recording, so encrypted sessions are replayed as clear ones
+    constexpr bool kHasDrm{false};
+    const auto kType{static_cast<firebolt::rialto::MediaSourceType>(kRecord.mediaType)};
+
+    std::unique_ptr<IMediaPipeline::MediaSource> source;
+    if (kType == firebolt::rialto::MediaSourceType::AUDIO)
+    {
+        const firebolt::rialto::AudioConfig kAudioConfig{kRecord.numberOfChannels, kRecord.sampleRate,
+                                                         kAttachSource->codecSpecificConfig};
+        source = std::make_unique<IMediaPipeline::MediaSourceAudio>(kAttachSource->mimeType, kHasDrm, kAudioConfig,
+                                                                    kAlignment, kFormat, codecData);
+    }
+    else if (kType == firebolt::rialto::MediaSourceType::VIDEO && kRecord.dolbyVisionProfile >= 0)
+    {
+        source = std::make_unique<IMediaPipeline::MediaSourceVideoDolbyVision>(kAttachSource->mimeType,
+                                                                               kRecord.dolbyVisionProfile, kHasDrm,
+                                                                               kRecord.width, kRecord.height,
+                                                                               kAlignment, kFormat, codecData);
+    }
+    else if (kType == firebolt::rialto::MediaSourceType::VIDEO)
+    {
+        source = std::make_unique<IMediaPipeline::MediaSourceVideo>(kAttachSource->mimeType, kHasDrm, kRecord.width,
+                                                                    kRecord.height, kAlignment, kFormat, codecData);
+    }
+    else if (kType == firebolt::rialto::MediaSourceType::SUBTITLE)
+    {
+        source = std::make_unique<IMediaPipeline::MediaSourceSubtitle>(kAttachSource->mimeType,
+                                                                       kAttachSource->textTrackIdentifier);
+    }
+    else
+    {
+        return false;
+    }
+
+    if (!m_pipeline->attachSource(source))
+    {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock{m_mutex};
+    Source &replayedSource{m_sources[kRecord.sourceId]};
+    replayedSource.liveId = source->getId();
+    replayedSource.type = kType;
+    return true;
+}
+
+bool SessionReplayer::sendNextAnswer(std::unique_lock<std::mutex> &lock, int64_t nextCommandTimestampNs,
+                                     std::chrono::steady_clock::time_point &wakeUpTime)
+{
+    for (auto &[recordedId, source] : m_sources)
+    {
+        if (source.pendingRequests.empty() || source.nextAnswer >= source.answers.size())
+        {
+            continue;
+        }
+        const DataAnswer &kAnswer{source.answers[source.nextAnswer]};
+        if (kAnswer.timestampNs >= nextCommandTimestampNs)
+        {
+            continue;
+        }
+        const auto kAnswerTime{toLocalTime(kAnswer.timestampNs)};
+        if (!m_isMaxSpeed && std::chrono::steady_clock::now() < kAnswerTime)
+        {
+            wakeUpTime = std::min(wakeUpTime, kAnswerTime);
+            continue;
+        }
+        const uint32_t kNeedDataRequestId{source.pendingRequests.front()};
+        source.pendingRequests.pop_front();
+        ++source.nextAnswer;
+        const int32_t kLiveId{source.liveId};
+        const firebolt::rialto::MediaSourceType kType{source.type};
+        // Answers are never removed while replaying, so the reference stays valid without the lock
+        lock.unlock();
+        if (!sendAnswer(kLiveId, kType, kNeedDataRequestId, kAnswer))
+        {
+            std::fprintf(stderr, "haveData failed for source %d\n", kLiveId);
+        }
+        lock.lock();
+        return true;
+    }
+    return false;
+}
+
+bool SessionReplayer::sendAnswer(int32_t liveSourceId, firebolt::rialto::MediaSourceType type,
+                                 uint32_t needDataRequestId, const DataAnswer &answer)
+{
+    std::vector<uint8_t> syntheticPayload;
+    for (const SessionReader::Record &record : answer.segments)
+    {
+        const auto *kRecord{record.as<session_recording::SegmentRecord>()};
+        std::unique_ptr<IMediaPipeline::MediaSegment> segment;
+        if (type == firebolt::rialto::MediaSourceType::AUDIO)
+        {
+            segment = std::make_unique<IMediaPipeline::MediaSegmentAudio>(liveSourceId, kRecord->timeStamp,
+                                                                          kRecord->duration, kRecord->sampleRateOrWidth,
+                                                                          kRecord->numberOfChannelsOrHeight, 0, 0);
+        }
+        else if (type == firebolt::rialto::MediaSourceType::VIDEO)
+        {
+            const firebolt::rialto::Fraction kFrameRate{firebolt::rialto::kUndefinedSize,
+                                                        firebolt::rialto::kUndefinedSize};
+            segment = std::make_unique<IMediaPipeline::MediaSegmentVideo>(liveSourceId, kRecord->timeStamp,
+                                                                          kRecord->duration, kRecord->sampleRateOrWidth,
+                                                                          kRecord->numberOfChannelsOrHeight,
+                                                                          kFrameRate);
+        }
+        else
+        {
+            segment = std::make_unique<IMediaPipeline::MediaSegment>(liveSourceId, type, kRecord->timeStamp,
+                                                                     kRecord->duration);
+        }
+        // Recordings made without payload are replayed with data of the original size
+        const uint8_t *payload{SessionReader::getSegmentPayload(record)};
+        if (!payload)
+        {
+            syntheticPayload.resize(kRecord->dataLength);
+            payload = syntheticPayload.data();
+        }
+        segment->setData(kRecord->dataLength, payload);
+        if (m_pipeline->addSegment(needDataRequestId, segment) != firebolt::rialto::AddSegmentStatus::OK)
+        {
+            std::fprintf(stderr, "No space for segment of source %d, dropping rest of the data\n", liveSourceId);
+            break;
+        }
+    }
+    return m_pipeline->haveData(answer.status, needDataRequestId);
+}
+
+bool SessionReplayer::isDataSentUnlocked(int64_t timestampNs) const
+{
+    for (const auto &[recordedId, source] : m_sources)
+    {
+        // Sources which are not attached (any more) don't get data
+        if (source.liveId >= 0 && source.nextAnswer < source.answers.size() &&
+            source.answers[source.nextAnswer].timestampNs < timestampNs)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SessionReplayer::skipAnswersUnlocked(Source &source, int64_t timestampNs)
+{
+    while (source.nextAnswer < source.answers.size() && source.answers[source.nextAnswer].timestampNs < timestampNs)
+    {
+        ++source.nextAnswer;
+    }
+}
+
+SessionReplayer::Source *SessionReplayer::findByLiveIdUnlocked(int32_t liveId)
+{
+    for (auto &[recordedId, source] : m_sources)
+    {
+        if (source.liveId == liveId)
+        {
+            return &source;
+        }
+    }
+    return nullptr;
+}
+
+int32_t SessionReplayer::toLiveId(int32_t recordedSourceId) const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    auto sourceIt{m_sources.find(recordedSourceId)};
+    return sourceIt != m_sources.end() ? sourceIt->second.liveId : -1;
+}
+
+std::chrono::steady_clock::time_point SessionReplayer::toLocalTime(int64_t timestampNs) const
+{
+    return m_startTime + std::chrono::nanoseconds{timestampNs - m_firstTimestampNs};
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SESSION_REPLAYER_H_
+#define SESSION_REPLAYER_H_
+
+#include "IMediaPipeline.h"
+#include "SessionReader.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Re-drives a session recorded by SessionRecorder against a media pipeline.
+// Commands are sent in recorded order, at their recorded time or as fast as possible. Media data is sent in answer
+// to the need-data requests of the pipeline, each request getting the next recorded have-data of its source, so the
+// server keeps control of the data flow as it had while recording. A command waits until the data recorded before it
+// has been sent, and data recorded after a command is held back until the command has been sent.
+class SessionReplayer : public firebolt::rialto::IMediaPipelineClient,
+                        public std::enable_shared_from_this<SessionReplayer>
+{
+public:
+    struct Summary
+    {
+        size_t needDataCount;
+        size_t bufferUnderflowCount;
+        size_t sourceFlushedCount;
+        std::chrono::nanoseconds duration;
+    };
+
+    // Records are read in place, so the reader has to outlive the replayer
+    SessionReplayer(SessionReader &reader, bool isMaxSpeed);
+    ~SessionReplayer() override = default;
+
+    bool replay(firebolt::rialto::IMediaPipelineFactory &factory);
+    Summary getRecordedSummary() const;
+    Summary getReplayedSummary() const;
+
+    void notifyDuration(int64_t duration) override {}
+    void notifyPosition(int64_t position) override {}
+    void notifyNativeSize(uint32_t width, uint32_t height, double aspect) override {}
+    void notifyNetworkState(firebolt::rialto::NetworkState state) override {}
+    void notifyPlaybackState(firebolt::rialto::PlaybackState state) override {}
+    void notifyVideoData(bool hasData) override {}
+    void notifyAudioData(bool hasData) override {}
+    void notifyNeedMediaData(int32_t sourceId, size_t frameCount, uint32_t needDataRequestId,
+                             const std::shared_ptr<firebolt::rialto::MediaPlayerShmInfo> &shmInfo) override;
+    void notifyCancelNeedMediaData(int32_t sourceId) override;
+    void notifyQos(int32_t sourceId, const firebolt::rialto::QosInfo &qosInfo) override {}
+    void notifyBufferUnderflow(int32_t sourceId) override;
+    void notifyFirstFrameReceived(int32_t sourceId) override {}
+    void notifyPlaybackError(int32_t sourceId, firebolt::rialto::PlaybackError error) override;
+    void notifySourceFlushed(int32_t sourceId) override;
+    void notifyPlaybackInfo(const firebolt::rialto::PlaybackInfo &playbackInfo) override {}
+
+private:
+    // Segments sent in answer to a single need-data, closed by have-data
+    struct DataAnswer
+    {
+        int64_t timestampNs;
+        std::vector<SessionReader::Record> segments;
+        firebolt::rialto::MediaSourceStatus status;
+    };
+
+    struct Source
+    {
+        int32_t liveId{-1};
+        firebolt::rialto::MediaSourceType type{firebolt::rialto::MediaSourceType::UNKNOWN};
+        std::vector<DataAnswer> answers;
+        size_t nextAnswer{0};
+        std::deque<uint32_t> pendingRequests;
+    };
+
+    bool issueCommand(const SessionReader::Record &command);
+    bool attachSource(const SessionReader::Record &command);
+    bool sendAnswer(int32_t liveSourceId, firebolt::rialto::MediaSourceType type, uint32_t needDataRequestId,
+                    const DataAnswer &answer);
+    // Replays data due before the next command. Returns false when there is nothing to send at the moment.
+    bool sendNextAnswer(std::unique_lock<std::mutex> &lock, int64_t nextCommandTimestampNs,
+                        std::chrono::steady_clock::time_point &wakeUpTime);
+    // Data recorded before the timestamp has been sent for all sources
+    bool isDataSentUnlocked(int64_t timestampNs) const;
+    void skipAnswersUnlocked(Source &source, int64_t timestampNs);
+    Source *findByLiveIdUnlocked(int32_t liveId);
+    int32_t toLiveId(int32_t recordedSourceId) const;
+    std::chrono::steady_clock::time_point toLocalTime(int64_t timestampNs) const;
+
+    const bool m_isMaxSpeed;
+    std::vector<SessionReader::Record> m_commands;
+    std::map<int32_t, Source> m_sources;
+    Summary m_recordedSummary{};
+    Summary m_replayedSummary{};
+    int64_t m_firstTimestampNs{0};
+    std::chrono::steady_clock::time_point m_startTime;
+    std::unique_ptr<firebolt::rialto::IMediaPipeline> m_pipeline;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+#endif // SESSION_REPLAYER_H_
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "StandInMediaPipeline.h"
+
+namespace
+{
+constexpr size_t kFrameCount{24};
+} // namespace
+
+StandInMediaPipeline::StandInMediaPipeline(std::weak_ptr<firebolt::rialto::IMediaPipelineClient> client)
+    : m_client{client}, m_thread{&StandInMediaPipeline::run, this}
+{
+}
+
+StandInMediaPipeline::~StandInMediaPipeline()
+{
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_isRunning = false;
+        m_cv.notify_all();
+    }
+    m_thread.join();
+}
+
+bool StandInMediaPipeline::load(firebolt::rialto::MediaType type, const std::string &mimeType, const std::string &url,
+                                bool isLive)
+{
+    return type == firebolt::rialto::MediaType::MSE;
+}
+
+bool StandInMediaPipeline::attachSource(const std::unique_ptr<MediaSource> &source)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    source->setId(m_nextSourceId++);
+    m_requests[source->getId()] = 0;
+    return true;
+}
+
+bool StandInMediaPipeline::removeSource(int32_t id)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return m_requests.erase(id) > 0;
+}
+
+bool StandInMediaPipeline::allSourcesAttached()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_isStreaming = true;
+    for (const auto &[sourceId, requestId] : m_requests)
+    {
+        requestDataUnlocked(sourceId);
+    }
+    return true;
+}
+
+bool StandInMediaPipeline::play(bool &async)
+{
+    async = true;
+    notifyPlaybackState(firebolt::rialto::PlaybackState::PLAYING);
+    return true;
+}
+
+bool StandInMediaPipeline::pause()
+{
+    notifyPlaybackState(firebolt::rialto::PlaybackState::PAUSED);
+    return true;
+}
+
+bool StandInMediaPipeline::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_isStreaming = false;
+    }
+    notifyPlaybackState(firebolt::rialto::PlaybackState::STOPPED);
+    return true;
+}
+
+bool StandInMediaPipeline::haveData(firebolt::rialto::MediaSourceStatus status, uint32_t needDataRequestId)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    for (auto &[sourceId, requestId] : m_requests)
+    {
+        if (requestId == needDataRequestId)
+        {
+            requestId = 0;
+            // Like the server, stop asking for data of a source which has reached its end
+            if (status != firebolt::rialto::MediaSourceStatus::EOS)
+            {
+                requestDataUnlocked(sourceId);
+            }
+            return true;
+        }
+    }
+    // Request cancelled by flush
+    return true;
+}
+
+firebolt::rialto::AddSegmentStatus StandInMediaPipeline::addSegment(uint32_t needDataRequestId,
+                                                                    const std::unique_ptr<MediaSegment> &mediaSegment)
+{
+    return firebolt::rialto::AddSegmentStatus::OK;
+}
+
+bool StandInMediaPipeline::flush(int32_t sourceId, bool resetTime, bool &async)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    auto requestIt{m_requests.find(sourceId)};
+    if (requestIt == m_requests.end())
+    {
+        return false;
+    }
+    async = true;
+    requestIt->second = 0;
+    postUnlocked(
+        [this, sourceId]()
+        {
+            if (auto client = m_client.lock())
+            {
+                client->notifySourceFlushed(sourceId);
+            }
+        });
+    requestDataUnlocked(sourceId);
+    return true;
+}
+
+void StandInMediaPipeline::requestDataUnlocked(int32_t sourceId)
+{
+    uint32_t &requestId{m_requests[sourceId]};
+    if (!m_isStreaming || requestId != 0)
+    {
+        return;
+    }
+    requestId = m_nextRequestId++;
+    postUnlocked(
+        [this, sourceId, kRequestId = requestId]()
+        {
+            if (auto client = m_client.lock())
+            {
+                client->notifyNeedMediaData(sourceId, kFrameCount, kRequestId, nullptr);
+            }
+        });
+}
+
+void StandInMediaPipeline::notifyPlaybackState(firebolt::rialto::PlaybackState state)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    postUnlocked(
+        [this, state]()
+        {
+            if (auto client = m_client.lock())
+            {
+                client->notifyPlaybackState(state);
+            }
+        });
+}
+
+void StandInMediaPipeline::postUnlocked(std::function<void()> &&task)
+{
+    m_tasks.push_back(std::move(task));
+    m_cv.notify_all();
+}
+
+void StandInMediaPipeline::run()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (true)
+    {
+        m_cv.wait(lock, [this]() { return !m_isRunning || !m_tasks.empty(); });
+        if (!m_isRunning)
+        {
+            return;
+        }
+        std::function<void()> task{std::move(m_tasks.front())};
+        m_tasks.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef STAND_IN_MEDIA_PIPELINE_H_
+#define STAND_IN_MEDIA_PIPELINE_H_
+
+#include "IMediaPipeline.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Media pipeline which plays the role of the server without rendering anything: it keeps one need-data outstanding
+// per source, accepts all data and acknowledges state changes and flushes. Lets a recording be replayed on a host
+// without Rialto server, to see how the client side of a session behaves.
+class StandInMediaPipeline : public firebolt::rialto::IMediaPipeline
+{
+public:
+    explicit StandInMediaPipeline(std::weak_ptr<firebolt::rialto::IMediaPipelineClient> client);
+    ~StandInMediaPipeline() override;
+
+    std::weak_ptr<firebolt::rialto::IMediaPipelineClient> getClient() override { return m_client; }
+    bool load(firebolt::rialto::MediaType type, const std::string &mimeType, const std::string &url,
+              bool isLive) override;
+    bool attachSource(const std::unique_ptr<MediaSource> &source) override;
+    bool removeSource(int32_t id) override;
+    bool allSourcesAttached() override;
+    bool play(bool &async) override;
+    bool pause() override;
+    bool stop() override;
+    bool setPlaybackRate(double rate) override { return true; }
+    bool setPosition(int64_t position) override { return true; }
+    bool getPosition(int64_t &position) override { return false; }
+    bool setImmediateOutput(int32_t sourceId, bool immediateOutput) override { return true; }
+    bool getImmediateOutput(int32_t sourceId, bool &immediateOutput) override { return false; }
+    bool getStats(int32_t sourceId, uint64_t &renderedFrames, uint64_t &droppedFrames) override { return false; }
+    bool setVideoWindow(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override { return true; }
+    bool haveData(firebolt::rialto::MediaSourceStatus status, uint32_t needDataRequestId) override;
+    firebolt::rialto::AddSegmentStatus addSegment(uint32_t needDataRequestId,
+                                                  const std::unique_ptr<MediaSegment> &mediaSegment) override;
+    bool renderFrame() override { return true; }
+    bool setVolume(double targetVolume, uint32_t volumeDuration, firebolt::rialto::EaseType type) override
+    {
+        return true;
+    }
+    bool getVolume(double &currentVolume) override { return false; }
+    bool setMute(int32_t sourceId, bool mute) override { return true; }
+    bool getMute(int32_t sourceId, bool &mute) override { return false; }
+    bool setTextTrackIdentifier(const std::string &textTrackIdentifier) override { return true; }
+    bool getTextTrackIdentifier(std::string &textTrackIdentifier) override { return false; }
+    bool setLowLatency(bool lowLatency) override { return true; }
+    bool setSync(bool sync) override { return true; }
+    bool getSync(bool &sync) override { return false; }
+    bool setSyncOff(bool syncOff) override { return true; }
+    bool setStreamSyncMode(int32_t sourceId, int32_t streamSyncMode) override { return true; }
+    bool getStreamSyncMode(int32_t &streamSyncMode) override { return false; }
+    bool flush(int32_t sourceId, bool resetTime, bool &async) override;
+    bool setSourcePosition(int32_t sourceId, int64_t position, bool resetTime, double appliedRate,
+                           uint64_t stopPosition) override
+    {
+        return true;
+    }
+    bool processAudioGap(int64_t position, uint32_t duration, int64_t discontinuityGap, bool audioAac) override
+    {
+        return true;
+    }
+    bool setBufferingLimit(uint32_t limitBufferingMs) override { return true; }
+    bool getBufferingLimit(uint32_t &limitBufferingMs) override { return false; }
+    bool setUseBuffering(bool useBuffering) override { return true; }
+    bool getUseBuffering(bool &useBuffering) override { return false; }
+    bool switchSource(const std::unique_ptr<MediaSource> &source) override { return true; }
+    bool setSubtitleOffset(int32_t sourceId, int64_t position) override { return true; }
+    bool getDuration(int64_t &duration) override { return false; }
+
+private:
+    void requestDataUnlocked(int32_t sourceId);
+    void notifyPlaybackState(firebolt::rialto::PlaybackState state);
+    void postUnlocked(std::function<void()> &&task);
+    void run();
+
+    std::weak_ptr<firebolt::rialto::IMediaPipelineClient> m_client;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    // Outstanding need-data request of each attached source, 0 when there is none
+    std::map<int32_t, uint32_t> m_requests;
+    int32_t m_nextSourceId{1};
+    uint32_t m_nextRequestId{1};
+    bool m_isStreaming{false};
+    bool m_isRunning{true};
+    std::deque<std::function<void()>> m_tasks;
+    std::thread m_thread;
+};
+
+class StandInMediaPipelineFactory : public firebolt::rialto::IMediaPipelineFactory
+{
+public:
+    std::unique_ptr<firebolt::rialto::IMediaPipeline>
+    createMediaPipeline(std::weak_ptr<firebolt::rialto::IMediaPipelineClient> client,
+                        const firebolt::rialto::VideoRequirements &videoRequirements) const override
+    {
+        return std::make_unique<StandInMediaPipeline>(client);
+    }
+};
+
+#endif // STAND_IN_MEDIA_PIPELINE_H_
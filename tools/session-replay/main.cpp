@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Sky UK
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "IControl.h"
+#include "SessionReader.h"
+#include "SessionReplayer.h"
+#include "StandInMediaPipeline.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace
+{
+constexpr std::chrono::seconds kRunningStateTimeout{5};
+
+// Rialto server accepts media pipelines only from applications in the running state
+class ControlClient : public firebolt::rialto::IControlClient
+{
+public:
+    void notifyApplicationState(firebolt::rialto::ApplicationState state) override
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_state = state;
+        m_cv.notify_all();
+    }
+
+    bool waitForRunningState(firebolt::rialto::ApplicationState initialState)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        if (m_state == firebolt::rialto::ApplicationState::UNKNOWN)
+        {
+            m_state = initialState;
+        }
+        return m_cv.wait_for(lock, kRunningStateTimeout,
+                             [this]() { return m_state == firebolt::rialto::ApplicationState::RUNNING; });
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    firebolt::rialto::ApplicationState m_state{firebolt::rialto::ApplicationState::UNKNOWN};
+};
+
+void printSummary(const char *name, const SessionReplayer::Summary &summary)
+{
+    std::printf("%s: %zu need-data, %zu buffer underflows, %zu sources flushed in %.3f s\n", name,
+                summary.needDataCount, summary.bufferUnderflowCount, summary.sourceFlushedCount,
+                std::chrono::duration<double>(summary.duration).count());
+}
+
+void printUsage(const char *program)
+{
+    std::fprintf(stderr,
+                 "Usage: %s [--max-speed] [--stand-in] <recording>\n"
+                 "  --max-speed  send commands as soon as their data has been sent, instead of at recorded times\n"
+                 "  --stand-in   replay against a stand-in pipeline instead of Rialto server\n",
+                 program);
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    bool isMaxSpeed{false};
+    bool isStandIn{false};
+    std::string path;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--max-speed") == 0)
+        {
+            isMaxSpeed = true;
+        }
+        else if (std::strcmp(argv[i], "--stand-in") == 0)
+        {
+            isStandIn = true;
+        }
+        else if (path.empty() && argv[i][0] != '-')
+        {
+            path = argv[i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (path.empty())
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    SessionReader reader{path};
+    if (!reader.isValid())
+    {
+        std::fprintf(stderr, "%s is not a session recording\n", path.c_str());
+        return 1;
+    }
+
+    std::shared_ptr<firebolt::rialto::IControl> control;
+    auto controlClient{std::make_shared<ControlClient>()};
+    std::shared_ptr<firebolt::rialto::IMediaPipelineFactory> factory;
+    if (isStandIn)
+    {
+        factory = std::make_shared<StandInMediaPipelineFactory>();
+    }
+    else
+    {
+        control = firebolt::rialto::IControlFactory::createFactory()->createControl();
+        firebolt::rialto::ApplicationState state{firebolt::rialto::ApplicationState::UNKNOWN};
+        if (!control || !control->registerClient(controlClient, state) || !controlClient->waitForRunningState(state))
+        {
+            std::fprintf(stderr, "Application is not running in Rialto\n");
+            return 1;
+        }
+        factory = firebolt::rialto::IMediaPipelineFactory::createFactory();
+    }
+
+    auto replayer{std::make_shared<SessionReplayer>(reader, isMaxSpeed)};
+    if (!factory || !replayer->replay(*factory))
+    {
+        return 1;
+    }
+    printSummary("recorded", replayer->getRecordedSummary());
+    printSummary("replayed", replayer->getReplayedSummary());
+    return 0;
+}